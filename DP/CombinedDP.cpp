@@ -0,0 +1,149 @@
+
+/*
+ * File CombinedDP.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file CombinedDP.cpp
+ * Implements class CombinedDP.
+ */
+
+#include "CombinedDP.hpp"
+
+namespace DP
+{
+
+CombinedDP::CombinedDP(DecisionProcedure* first, DecisionProcedure* second)
+{
+  CALL("CombinedDP::CombinedDP");
+
+  _inner.push(first);
+  _inner.push(second);
+}
+
+CombinedDP::~CombinedDP()
+{
+  CALL("CombinedDP::~CombinedDP");
+
+  while (_inner.isNonEmpty()) {
+    delete _inner.pop();
+  }
+}
+
+void CombinedDP::addLiterals(LiteralIterator lits, bool onlyEqualites)
+{
+  CALL("CombinedDP::addLiterals");
+
+  // the iterator can be traversed only once
+  static LiteralStack litStack;
+  litStack.reset();
+  litStack.loadFromIterator(lits);
+
+  Stack<DecisionProcedure*>::Iterator it(_inner);
+  while (it.hasNext()) {
+    it.next()->addLiterals(pvi( LiteralStack::ConstIterator(litStack) ), onlyEqualites);
+  }
+}
+
+/**
+ * Unsatisfiable if any inner decision procedure is. When only one core is
+ * requested, the procedures after the first unsatisfiable one are not asked.
+ */
+DecisionProcedure::Status CombinedDP::getStatus(bool getMultipleCores)
+{
+  CALL("CombinedDP::getStatus");
+
+  _unsat.reset();
+  Status res = SATISFIABLE;
+  Stack<DecisionProcedure*>::Iterator it(_inner);
+  while (it.hasNext()) {
+    DecisionProcedure* dp = it.next();
+    Status st = dp->getStatus(getMultipleCores);
+    if (st==UNSATISFIABLE) {
+      _unsat.push(dp);
+      if (!getMultipleCores) {
+        break;
+      }
+    }
+    else if (st==UNKNOWN) {
+      res = UNKNOWN;
+    }
+  }
+  return _unsat.isEmpty() ? res : UNSATISFIABLE;
+}
+
+unsigned CombinedDP::getUnsatCoreCount()
+{
+  CALL("CombinedDP::getUnsatCoreCount");
+
+  unsigned res = 0;
+  Stack<DecisionProcedure*>::Iterator it(_unsat);
+  while (it.hasNext()) {
+    res += it.next()->getUnsatCoreCount();
+  }
+  return res;
+}
+
+void CombinedDP::getUnsatCore(LiteralStack& res, unsigned coreIndex)
+{
+  CALL("CombinedDP::getUnsatCore");
+
+  Stack<DecisionProcedure*>::Iterator it(_unsat);
+  while (it.hasNext()) {
+    DecisionProcedure* dp = it.next();
+    unsigned cnt = dp->getUnsatCoreCount();
+    if (coreIndex<cnt) {
+      dp->getUnsatCore(res, coreIndex);
+      return;
+    }
+    coreIndex -= cnt;
+  }
+  ASSERTION_VIOLATION;
+}
+
+void CombinedDP::reset()
+{
+  CALL("CombinedDP::reset");
+
+  _unsat.reset();
+  Stack<DecisionProcedure*>::Iterator it(_inner);
+  while (it.hasNext()) {
+    it.next()->reset();
+  }
+}
+
+void CombinedDP::pushLevel()
+{
+  CALL("CombinedDP::pushLevel");
+
+  Stack<DecisionProcedure*>::Iterator it(_inner);
+  while (it.hasNext()) {
+    it.next()->pushLevel();
+  }
+}
+
+void CombinedDP::popLevels(unsigned cnt)
+{
+  CALL("CombinedDP::popLevels");
+
+  _unsat.reset();
+  Stack<DecisionProcedure*>::Iterator it(_inner);
+  while (it.hasNext()) {
+    it.next()->popLevels(cnt);
+  }
+}
+
+}
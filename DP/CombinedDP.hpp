@@ -0,0 +1,79 @@
+
+/*
+ * File CombinedDP.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file CombinedDP.hpp
+ * Defines class CombinedDP.
+ */
+
+#ifndef __CombinedDP__
+#define __CombinedDP__
+
+#include "Forwards.hpp"
+
+#include "Lib/Stack.hpp"
+
+#include "DecisionProcedure.hpp"
+
+namespace DP {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Decision procedure passing the literals to several inner ones and
+ * reporting the conflicts any of them finds. The inner procedures do not
+ * exchange equalities, so conflicts that need more than one theory at once
+ * are not found.
+ */
+class CombinedDP : public DecisionProcedure {
+public:
+  CLASS_NAME(CombinedDP);
+  USE_ALLOCATOR(CombinedDP);
+
+  /**
+   * Create object using the @c first and @c second decision procedures.
+   * Object takes ownership of both.
+   */
+  CombinedDP(DecisionProcedure* first, DecisionProcedure* second);
+  ~CombinedDP();
+
+  virtual void addLiterals(LiteralIterator lits, bool onlyEqualites) override;
+  virtual Status getStatus(bool getMultipleCores) override;
+
+  /** Return the model of the first inner decision procedure */
+  void getModel(LiteralStack& model) override {
+    _inner[0]->getModel(model);
+  }
+
+  virtual unsigned getUnsatCoreCount() override;
+  virtual void getUnsatCore(LiteralStack& res, unsigned coreIndex) override;
+
+  virtual void reset() override;
+  virtual void pushLevel() override;
+  virtual void popLevels(unsigned cnt) override;
+
+private:
+  Stack<DecisionProcedure*> _inner;
+  /** Inner decision procedures that reported a conflict in the last getStatus call */
+  Stack<DecisionProcedure*> _unsat;
+};
+
+}
+
+#endif // __CombinedDP__
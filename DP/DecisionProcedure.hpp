@@ -69,6 +69,16 @@ public:
   virtual void getUnsatCore(LiteralStack& res, unsigned coreIndex=0) = 0;
   /** reset decision procedure object into state equivalent to its initial state */
   virtual void reset() = 0;
+
+  /**
+   * Open a new backtracking level. Literals added after this call
+   * are retracted by the matching call to popLevels, so that a caller
+   * can follow a changing assignment without reset() and re-adding
+   * all the literals.
+   */
+  virtual void pushLevel() = 0;
+  /** retract everything added since the last @c cnt calls to pushLevel */
+  virtual void popLevels(unsigned cnt) = 0;
 };
 
 }
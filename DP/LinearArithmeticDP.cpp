@@ -0,0 +1,850 @@
+
+/*
+ * File LinearArithmeticDP.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file LinearArithmeticDP.cpp
+ * Implements class LinearArithmeticDP.
+ */
+
+#include <algorithm>
+
+#include "Lib/DHSet.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/Int.hpp"
+
+#include "Kernel/Signature.hpp"
+#include "Kernel/SortHelper.hpp"
+#include "Kernel/Sorts.hpp"
+
+#include "LinearArithmeticDP.hpp"
+
+namespace DP
+{
+
+LinearArithmeticDP::LinearArithmeticDP()
+ : _conflictLevel(0)
+{
+}
+
+LinearArithmeticDP::~LinearArithmeticDP()
+{
+  CALL("LinearArithmeticDP::~LinearArithmeticDP");
+
+  while (_rows.isNonEmpty()) {
+    delete _rows.pop();
+  }
+}
+
+void LinearArithmeticDP::reset()
+{
+  CALL("LinearArithmeticDP::reset");
+
+  while (_rows.isNonEmpty()) {
+    delete _rows.pop();
+  }
+  _vars.reset();
+  _termVars.reset();
+  _queryTerms.reset();
+  _slackVars.reset();
+  _disequalities.reset();
+  _trail.reset();
+  _levels.reset();
+  _unsatCore.reset();
+  _conflictLevel = 0;
+}
+
+void LinearArithmeticDP::pushLevel()
+{
+  CALL("LinearArithmeticDP::pushLevel");
+
+  LevelMark mark;
+  mark.trail = _trail.size();
+  mark.disequalities = _disequalities.size();
+  mark.queryTerms = _queryTerms.size();
+  _levels.push(mark);
+}
+
+/**
+ * Restore the bounds replaced since the levels were opened. The tableau
+ * and the assignment stay, as the assignment of the non-basic variables
+ * still respects the weaker bounds.
+ */
+void LinearArithmeticDP::popLevels(unsigned cnt)
+{
+  CALL("LinearArithmeticDP::popLevels");
+  ASS_LE(cnt,_levels.size());
+
+  if (!cnt) {
+    return;
+  }
+  _levels.truncate(_levels.size()-cnt+1);
+  LevelMark mark = _levels.pop();
+
+  while (_trail.size()>mark.trail) {
+    BoundChange ch = _trail.pop();
+    if (ch.upper) {
+      _vars[ch.var].upper = ch.old;
+    }
+    else {
+      _vars[ch.var].lower = ch.old;
+    }
+  }
+  _disequalities.truncate(mark.disequalities);
+  while (_queryTerms.size()>mark.queryTerms) {
+    _vars[_queryTerms.pop().second].inQuery = false;
+  }
+
+  if (_levels.size()<_conflictLevel) {
+    _unsatCore.reset();
+  }
+}
+
+void LinearArithmeticDP::addLiterals(LiteralIterator lits, bool onlyEqualites)
+{
+  CALL("LinearArithmeticDP::addLiterals");
+
+  while (lits.hasNext()) {
+    Literal* lit = lits.next();
+    if (!lit->ground() || (onlyEqualites && !lit->isEquality())) {
+      continue;
+    }
+    addLiteral(lit);
+  }
+}
+
+/**
+ * If @b lit is an arithmetic comparison, store it as lhs rel rhs where
+ * @b rel is one of LT, LE, EQ, NE and return true.
+ */
+bool LinearArithmeticDP::readConstraint(Literal* lit, unsigned& sort, TermList& lhs, TermList& rhs, Relation& rel)
+{
+  CALL("LinearArithmeticDP::readConstraint");
+
+  if (lit->isEquality()) {
+    sort = SortHelper::getEqualityArgumentSort(lit);
+    if (sort!=Sorts::SRT_INTEGER && sort!=Sorts::SRT_RATIONAL && sort!=Sorts::SRT_REAL) {
+      return false;
+    }
+    lhs = *lit->nthArgument(0);
+    rhs = *lit->nthArgument(1);
+    rel = lit->isPositive() ? EQ : NE;
+    return true;
+  }
+  if (!theory->isInterpretedPredicate(lit)) {
+    return false;
+  }
+
+  bool strict;
+  bool swap;
+  switch (theory->interpretPredicate(lit)) {
+  case Theory::INT_LESS:
+  case Theory::RAT_LESS:
+  case Theory::REAL_LESS:
+    strict = true;
+    swap = false;
+    break;
+  case Theory::INT_LESS_EQUAL:
+  case Theory::RAT_LESS_EQUAL:
+  case Theory::REAL_LESS_EQUAL:
+    strict = false;
+    swap = false;
+    break;
+  case Theory::INT_GREATER:
+  case Theory::RAT_GREATER:
+  case Theory::REAL_GREATER:
+    strict = true;
+    swap = true;
+    break;
+  case Theory::INT_GREATER_EQUAL:
+  case Theory::RAT_GREATER_EQUAL:
+  case Theory::REAL_GREATER_EQUAL:
+    strict = false;
+    swap = true;
+    break;
+  default:
+    return false;
+  }
+  // the negation of a<b is b<=a and the other way round
+  if (lit->isNegative()) {
+    strict = !strict;
+    swap = !swap;
+  }
+  sort = SortHelper::getArgSort(lit, 0);
+  lhs = *lit->nthArgument(swap ? 1 : 0);
+  rhs = *lit->nthArgument(swap ? 0 : 1);
+  rel = strict ? LT : LE;
+  return true;
+}
+
+/**
+ * Return true if @b lit is a comparison this decision procedure reads,
+ * rather than ignores.
+ */
+bool LinearArithmeticDP::isLinearConstraint(Literal* lit)
+{
+  CALL("LinearArithmeticDP::isLinearConstraint");
+
+  unsigned sort;
+  TermList lhs, rhs;
+  Relation rel;
+  return readConstraint(lit, sort, lhs, rhs, rel);
+}
+
+bool LinearArithmeticDP::readNumeral(TermList t, unsigned sort, Rational& res)
+{
+  CALL("LinearArithmeticDP::readNumeral");
+
+  switch (sort) {
+  case Sorts::SRT_INTEGER: {
+    IntegerConstantType num;
+    if (!theory->tryInterpretConstant(t, num)) {
+      return false;
+    }
+    res = Rational(num);
+    return true;
+  }
+  case Sorts::SRT_RATIONAL:
+    return theory->tryInterpretConstant(t, res);
+  case Sorts::SRT_REAL: {
+    RealConstantType num;
+    if (!theory->tryInterpretConstant(t, num)) {
+      return false;
+    }
+    res = num;
+    return true;
+  }
+  default:
+    ASSERTION_VIOLATION;
+    return false;
+  }
+}
+
+/**
+ * Add @b factor times the linear form of @b t to @b coeffs and @b constant.
+ * Sums, differences and products and quotients by numerals are read,
+ * any other term becomes a variable.
+ */
+void LinearArithmeticDP::linearize(TermList t, unsigned sort, const Rational& factor,
+    DHMap<unsigned,Rational>& coeffs, Rational& constant)
+{
+  CALL("LinearArithmeticDP::linearize");
+
+  Rational num;
+  if (readNumeral(t, sort, num)) {
+    constant = constant + factor*num;
+    return;
+  }
+  if (theory->isInterpretedFunction(t)) {
+    TermList* args = t.term()->args();
+    switch (theory->interpretFunction(t)) {
+    case Theory::INT_UNARY_MINUS:
+    case Theory::RAT_UNARY_MINUS:
+    case Theory::REAL_UNARY_MINUS:
+      linearize(args[0], sort, -factor, coeffs, constant);
+      return;
+    case Theory::INT_PLUS:
+    case Theory::RAT_PLUS:
+    case Theory::REAL_PLUS:
+      linearize(args[0], sort, factor, coeffs, constant);
+      linearize(*args->next(), sort, factor, coeffs, constant);
+      return;
+    case Theory::INT_MINUS:
+    case Theory::RAT_MINUS:
+    case Theory::REAL_MINUS:
+      linearize(args[0], sort, factor, coeffs, constant);
+      linearize(*args->next(), sort, -factor, coeffs, constant);
+      return;
+    case Theory::INT_MULTIPLY:
+    case Theory::RAT_MULTIPLY:
+    case Theory::REAL_MULTIPLY:
+      if (readNumeral(args[0], sort, num)) {
+        linearize(*args->next(), sort, factor*num, coeffs, constant);
+        return;
+      }
+      if (readNumeral(*args->next(), sort, num)) {
+        linearize(args[0], sort, factor*num, coeffs, constant);
+        return;
+      }
+      break;
+    case Theory::RAT_QUOTIENT:
+    case Theory::REAL_QUOTIENT:
+      if (readNumeral(*args->next(), sort, num) && !num.isZero()) {
+        linearize(args[0], sort, factor/num, coeffs, constant);
+        return;
+      }
+      break;
+    default:
+      break;
+    }
+  }
+
+  Rational* pcoeff;
+  if (coeffs.getValuePtr(getTermVar(t, sort), pcoeff, Rational(0))) {
+    *pcoeff = factor;
+  }
+  else {
+    *pcoeff = *pcoeff + factor;
+  }
+}
+
+unsigned LinearArithmeticDP::getTermVar(TermList t, unsigned sort)
+{
+  CALL("LinearArithmeticDP::getTermVar");
+
+  unsigned* pvar;
+  if (_termVars.getValuePtr(t, pvar)) {
+    *pvar = _vars.size();
+    _vars.push(VarInfo(sort==Sorts::SRT_INTEGER));
+  }
+  if (!_vars[*pvar].inQuery) {
+    _vars[*pvar].inQuery = true;
+    _queryTerms.push(make_pair(t, *pvar));
+  }
+  return *pvar;
+}
+
+/**
+ * Return the slack variable equal to the sum of coefficients times
+ * variables in @b form, adding a row for it if there is none yet.
+ */
+unsigned LinearArithmeticDP::getSlackVar(const LinearForm& form, bool isInt)
+{
+  CALL("LinearArithmeticDP::getSlackVar");
+
+  vstring key;
+  for (unsigned i = 0; i<form.size(); i++) {
+    key += Int::toString(form[i].first)+"*"+form[i].second.toString()+" ";
+  }
+  unsigned* pvar;
+  if (!_slackVars.getValuePtr(key, pvar)) {
+    return *pvar;
+  }
+  unsigned slack = _vars.size();
+  *pvar = slack;
+  _vars.push(VarInfo(isInt));
+
+  // the row has to be expressed in terms of the current non-basic variables
+  Row* row = new Row();
+  row->basic = slack;
+  DeltaRational value;
+  for (unsigned i = 0; i<form.size(); i++) {
+    unsigned var = form[i].first;
+    const Rational& c = form[i].second;
+    value = value + _vars[var].value*c;
+
+    DHMap<unsigned,Rational> single;
+    DHMap<unsigned,Rational>* summand = &single;
+    if (isBasic(var)) {
+      summand = &_rows[_vars[var].row]->coeffs;
+    }
+    else {
+      single.insert(var, Rational(1));
+    }
+    DHMap<unsigned,Rational>::Iterator sit(*summand);
+    while (sit.hasNext()) {
+      unsigned v;
+      Rational sc;
+      sit.next(v, sc);
+      Rational* pc;
+      if (row->coeffs.getValuePtr(v, pc, Rational(0))) {
+        *pc = c*sc;
+      }
+      else {
+        *pc = *pc + c*sc;
+        if (pc->isZero()) {
+          row->coeffs.remove(v);
+        }
+      }
+    }
+  }
+  _vars[slack].value = value;
+  _vars[slack].row = _rows.size();
+  _rows.push(row);
+  return slack;
+}
+
+void LinearArithmeticDP::setConflict(Literal* l1, Literal* l2)
+{
+  CALL("LinearArithmeticDP::setConflict");
+  ASS(_unsatCore.isEmpty());
+
+  _unsatCore.push(l1);
+  if (l2 && l2!=l1) {
+    _unsatCore.push(l2);
+  }
+  _conflictLevel = _levels.size();
+}
+
+/**
+ * Turn @b lit into a bound on a single variable. The linear form is divided
+ * by its leading coefficient, or by the gcd of the coefficients in the integer
+ * case, so that the same slack variable is shared by all the constraints over
+ * proportional sums.
+ */
+void LinearArithmeticDP::addLiteral(Literal* lit)
+{
+  CALL("LinearArithmeticDP::addLiteral");
+
+  if (_unsatCore.isNonEmpty()) {
+    return;
+  }
+
+  unsigned sort;
+  TermList lhs, rhs;
+  Relation rel;
+  if (!readConstraint(lit, sort, lhs, rhs, rel)) {
+    return;
+  }
+  bool isInt = sort==Sorts::SRT_INTEGER;
+
+  DHMap<unsigned,Rational> coeffs;
+  Rational constant(0);
+  linearize(lhs, sort, Rational(1), coeffs, constant);
+  linearize(rhs, sort, Rational(-1), coeffs, constant);
+
+  LinearForm form;
+  DHMap<unsigned,Rational>::Iterator cit(coeffs);
+  while (cit.hasNext()) {
+    unsigned var;
+    Rational c;
+    cit.next(var, c);
+    if (!c.isZero()) {
+      form.push(make_pair(var, c));
+    }
+  }
+
+  if (form.isEmpty()) {
+    // the constraint reads constant rel 0
+    bool holds = true;
+    switch (rel) {
+    case LT: holds = constant.isNegative(); break;
+    case LE: holds = constant.isNegative() || constant.isZero(); break;
+    case EQ: holds = constant.isZero(); break;
+    case NE: holds = !constant.isZero(); break;
+    }
+    if (!holds) {
+      setConflict(lit);
+    }
+    return;
+  }
+
+  std::sort(form.begin(), form.end());
+  Rational divisor = form[0].second;
+  if (isInt) {
+    const IntegerConstantType& lead = form[0].second.numerator();
+    IntegerConstantType gcd = lead.isNegative() ? -lead : lead;
+    for (unsigned i = 1; i<form.size(); i++) {
+      gcd = IntegerConstantType::gcd(gcd, form[i].second.numerator());
+    }
+    divisor = divisor.isNegative() ? Rational(-gcd) : Rational(gcd);
+  }
+  for (unsigned i = 0; i<form.size(); i++) {
+    form[i].second = form[i].second/divisor;
+  }
+  unsigned var = form.size()==1 ? form[0].first : getSlackVar(form, isInt);
+
+  // var rel -constant/divisor, with the direction flipped for a negative divisor
+  Rational val = -constant/divisor;
+  bool upper = !divisor.isNegative();
+
+  if (rel==NE) {
+    _disequalities.push(Disequality(var, val, lit));
+    return;
+  }
+  if (rel==EQ) {
+    if (isInt && !val.isInt()) {
+      setConflict(lit);
+      return;
+    }
+    assertLower(var, DeltaRational(val, Rational(0)), lit);
+    if (_unsatCore.isEmpty()) {
+      assertUpper(var, DeltaRational(val, Rational(0)), lit);
+    }
+    return;
+  }
+
+  DeltaRational bound;
+  if (isInt) {
+    // x<v is x<=ceil(v)-1 and x>v is x>=floor(v)+1 over integers
+    if (upper) {
+      bound.real = rel==LT ? val.ceiling()-Rational(1) : val.floor();
+    }
+    else {
+      bound.real = rel==LT ? val.floor()+Rational(1) : val.ceiling();
+    }
+  }
+  else {
+    bound.real = val;
+    if (rel==LT) {
+      bound.delta = Rational(upper ? -1 : 1);
+    }
+  }
+  if (upper) {
+    assertUpper(var, bound, lit);
+  }
+  else {
+    assertLower(var, bound, lit);
+  }
+}
+
+void LinearArithmeticDP::assertLower(unsigned var, const DeltaRational& val, Literal* reason)
+{
+  CALL("LinearArithmeticDP::assertLower");
+
+  VarInfo& vi = _vars[var];
+  if (vi.lower.present() && val<=vi.lower.val) {
+    return;
+  }
+  if (vi.upper.present() && vi.upper.val<val) {
+    setConflict(reason, vi.upper.reason);
+    return;
+  }
+  _trail.push(BoundChange(var, false, vi.lower));
+  vi.lower = Bound(val, reason);
+  if (!isBasic(var) && vi.value<val) {
+    update(var, val);
+  }
+}
+
+void LinearArithmeticDP::assertUpper(unsigned var, const DeltaRational& val, Literal* reason)
+{
+  CALL("LinearArithmeticDP::assertUpper");
+
+  VarInfo& vi = _vars[var];
+  if (vi.upper.present() && vi.upper.val<=val) {
+    return;
+  }
+  if (vi.lower.present() && val<vi.lower.val) {
+    setConflict(reason, vi.lower.reason);
+    return;
+  }
+  _trail.push(BoundChange(var, true, vi.upper));
+  vi.upper = Bound(val, reason);
+  if (!isBasic(var) && val<vi.value) {
+    update(var, val);
+  }
+}
+
+/**
+ * Set the value of the non-basic variable @b var and recompute the basic
+ * variables depending on it.
+ */
+void LinearArithmeticDP::update(unsigned var, const DeltaRational& val)
+{
+  CALL("LinearArithmeticDP::update");
+  ASS(!isBasic(var));
+
+  DeltaRational diff = val-_vars[var].value;
+  for (unsigned i = 0; i<_rows.size(); i++) {
+    Rational c;
+    if (_rows[i]->coeffs.find(var, c)) {
+      VarInfo& bi = _vars[_rows[i]->basic];
+      bi.value = bi.value+diff*c;
+    }
+  }
+  _vars[var].value = val;
+}
+
+/**
+ * Set the value of the basic variable @b basic to @b val by changing
+ * @b nonBasic and then exchange the two.
+ */
+void LinearArithmeticDP::pivotAndUpdate(unsigned basic, unsigned nonBasic, const DeltaRational& val)
+{
+  CALL("LinearArithmeticDP::pivotAndUpdate");
+
+  Row* row = _rows[_vars[basic].row];
+  DeltaRational theta = (val-_vars[basic].value)*(Rational(1)/row->coeffs.get(nonBasic));
+  _vars[basic].value = val;
+  _vars[nonBasic].value = _vars[nonBasic].value+theta;
+  for (unsigned i = 0; i<_rows.size(); i++) {
+    Rational c;
+    if (_rows[i]!=row && _rows[i]->coeffs.find(nonBasic, c)) {
+      VarInfo& bi = _vars[_rows[i]->basic];
+      bi.value = bi.value+theta*c;
+    }
+  }
+  pivot(basic, nonBasic);
+}
+
+void LinearArithmeticDP::pivot(unsigned basic, unsigned nonBasic)
+{
+  CALL("LinearArithmeticDP::pivot");
+
+  unsigned rowIdx = _vars[basic].row;
+  Row* row = _rows[rowIdx];
+
+  // basic = a*nonBasic + sum c*x  becomes  nonBasic = basic/a - sum (c/a)*x
+  Rational a = row->coeffs.get(nonBasic);
+  row->coeffs.remove(nonBasic);
+  DHMap<unsigned,Rational>::DelIterator rit(row->coeffs);
+  while (rit.hasNext()) {
+    unsigned v;
+    Rational c;
+    rit.next(v, c);
+    rit.setValue(-c/a);
+  }
+  row->coeffs.insert(basic, Rational(1)/a);
+  row->basic = nonBasic;
+  _vars[nonBasic].row = rowIdx;
+  _vars[basic].row = -1;
+
+  for (unsigned i = 0; i<_rows.size(); i++) {
+    Row* other = _rows[i];
+    Rational e;
+    if (other==row || !other->coeffs.find(nonBasic, e)) {
+      continue;
+    }
+    other->coeffs.remove(nonBasic);
+    DHMap<unsigned,Rational>::Iterator sit(row->coeffs);
+    while (sit.hasNext()) {
+      unsigned v;
+      Rational c;
+      sit.next(v, c);
+      Rational* pc;
+      if (other->coeffs.getValuePtr(v, pc, Rational(0))) {
+        *pc = e*c;
+      }
+      else {
+        *pc = *pc + e*c;
+        if (pc->isZero()) {
+          other->coeffs.remove(v);
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Repair the basic variables violating their bounds, choosing the variables
+ * by Bland's rule so that the search terminates. Return false and set the
+ * unsat core if the bounds cannot be satisfied.
+ */
+bool LinearArithmeticDP::check()
+{
+  CALL("LinearArithmeticDP::check");
+
+  while (true) {
+    unsigned basic = UINT_MAX;
+    for (unsigned i = 0; i<_rows.size(); i++) {
+      unsigned b = _rows[i]->basic;
+      const VarInfo& bi = _vars[b];
+      if (b<basic && ((bi.lower.present() && bi.value<bi.lower.val) ||
+          (bi.upper.present() && bi.upper.val<bi.value))) {
+        basic = b;
+      }
+    }
+    if (basic==UINT_MAX) {
+      return true;
+    }
+
+    const VarInfo& bi = _vars[basic];
+    Row* row = _rows[bi.row];
+    // whether the basic variable has to grow
+    bool increase = bi.lower.present() && bi.value<bi.lower.val;
+
+    unsigned nonBasic = UINT_MAX;
+    DHMap<unsigned,Rational>::Iterator rit(row->coeffs);
+    while (rit.hasNext()) {
+      unsigned v;
+      Rational c;
+      rit.next(v, c);
+      const VarInfo& vi = _vars[v];
+      bool grow = increase != c.isNegative();
+      bool canMove = grow ? (!vi.upper.present() || vi.value<vi.upper.val)
+                          : (!vi.lower.present() || vi.lower.val<vi.value);
+      if (canMove && v<nonBasic) {
+        nonBasic = v;
+      }
+    }
+
+    if (nonBasic==UINT_MAX) {
+      // the row together with the bounds blocking its variables is the conflict
+      static DHSet<Literal*> seen;
+      seen.reset();
+      _unsatCore.reset();
+      Literal* own = increase ? bi.lower.reason : bi.upper.reason;
+      seen.insert(own);
+      _unsatCore.push(own);
+      DHMap<unsigned,Rational>::Iterator cit(row->coeffs);
+      while (cit.hasNext()) {
+        unsigned v;
+        Rational c;
+        cit.next(v, c);
+        bool grow = increase != c.isNegative();
+        Literal* reason = grow ? _vars[v].upper.reason : _vars[v].lower.reason;
+        ASS(reason);
+        if (seen.insert(reason)) {
+          _unsatCore.push(reason);
+        }
+      }
+      _conflictLevel = _levels.size();
+      return false;
+    }
+
+    pivotAndUpdate(basic, nonBasic, increase ? bi.lower.val : bi.upper.val);
+  }
+}
+
+/**
+ * Report a conflict if a variable with equal lower and upper bound is
+ * asserted to differ from that value.
+ */
+bool LinearArithmeticDP::checkDisequalities()
+{
+  CALL("LinearArithmeticDP::checkDisequalities");
+
+  DeltaRational zero;
+  for (unsigned i = 0; i<_disequalities.size(); i++) {
+    const Disequality& d = _disequalities[i];
+    const VarInfo& vi = _vars[d.var];
+    DeltaRational val(d.val, Rational(0));
+    if (vi.lower.present() && vi.upper.present() && vi.lower.val==val && vi.upper.val==val) {
+      setConflict(d.reason, vi.lower.reason);
+      if (vi.upper.reason!=d.reason && vi.upper.reason!=vi.lower.reason) {
+        _unsatCore.push(vi.upper.reason);
+      }
+      return false;
+    }
+  }
+  return true;
+}
+
+bool LinearArithmeticDP::hasBoundedIntegers() const
+{
+  CALL("LinearArithmeticDP::hasBoundedIntegers");
+
+  for (unsigned i = 0; i<_vars.size(); i++) {
+    const VarInfo& vi = _vars[i];
+    if (vi.isInt && (vi.lower.present() || vi.upper.present())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+DecisionProcedure::Status LinearArithmeticDP::getStatus(bool retrieveMultipleCores)
+{
+  CALL("LinearArithmeticDP::getStatus");
+
+  if (_unsatCore.isNonEmpty() || !check() || !checkDisequalities()) {
+    return UNSATISFIABLE;
+  }
+  if (_disequalities.isNonEmpty() || hasBoundedIntegers()) {
+    return UNKNOWN;
+  }
+  return SATISFIABLE;
+}
+
+/**
+ * Return a positive rational small enough that replacing the infinitesimal
+ * by it keeps all the values within their bounds.
+ */
+LinearArithmeticDP::Rational LinearArithmeticDP::computeDelta() const
+{
+  CALL("LinearArithmeticDP::computeDelta");
+
+  Rational res(1);
+  for (unsigned i = 0; i<_vars.size(); i++) {
+    const VarInfo& vi = _vars[i];
+    // lo<=hi has to hold for lo.real+lo.delta*res and hi.real+hi.delta*res
+    for (unsigned j = 0; j<2; j++) {
+      const Bound& b = j ? vi.upper : vi.lower;
+      if (!b.present()) {
+        continue;
+      }
+      const DeltaRational& lo = j ? vi.value : b.val;
+      const DeltaRational& hi = j ? b.val : vi.value;
+      if (lo.real<hi.real && hi.delta<lo.delta) {
+        Rational limit = (hi.real-lo.real)/(lo.delta-hi.delta);
+        if (limit<res) {
+          res = limit;
+        }
+      }
+    }
+  }
+  return res;
+}
+
+LinearArithmeticDP::Rational LinearArithmeticDP::modelValue(unsigned var, const Rational& delta) const
+{
+  const DeltaRational& val = _vars[var].value;
+  return val.real+val.delta*delta;
+}
+
+/**
+ * If the bounds are satisfiable by the current assignment, with integer
+ * values for the integer variables and all the disequalities holding,
+ * add the equality of each non-arithmetic term of the literals added at
+ * the open levels with its value to @b model. Otherwise leave @b model
+ * unchanged.
+ *
+ * Can be called only after getStatus returned other than UNSATISFIABLE.
+ */
+void LinearArithmeticDP::getModel(LiteralStack& model)
+{
+  CALL("LinearArithmeticDP::getModel");
+  ASS(_unsatCore.isEmpty());
+
+  Rational delta = computeDelta();
+  static Stack<Rational> values;
+  values.reset();
+  for (unsigned i = 0; i<_queryTerms.size(); i++) {
+    unsigned var = _queryTerms[i].second;
+    Rational val = modelValue(var, delta);
+    if (_vars[var].isInt && !val.isInt()) {
+      return;
+    }
+    values.push(val);
+  }
+  for (unsigned i = 0; i<_disequalities.size(); i++) {
+    if (modelValue(_disequalities[i].var, delta)==_disequalities[i].val) {
+      return;
+    }
+  }
+
+  for (unsigned i = 0; i<_queryTerms.size(); i++) {
+    TermList t = _queryTerms[i].first;
+    unsigned sort = SortHelper::getResultSort(t.term());
+    Term* num;
+    switch (sort) {
+    case Sorts::SRT_INTEGER:
+      num = theory->representConstant(values[i].numerator());
+      break;
+    case Sorts::SRT_RATIONAL:
+      num = theory->representConstant(values[i]);
+      break;
+    default:
+      ASS_EQ(sort, Sorts::SRT_REAL);
+      num = theory->representConstant(RealConstantType(values[i]));
+      break;
+    }
+    model.push(Literal::createEquality(true, t, TermList(num), sort));
+  }
+}
+
+void LinearArithmeticDP::getUnsatCore(LiteralStack& res, unsigned coreIndex)
+{
+  CALL("LinearArithmeticDP::getUnsatCore");
+  ASS_EQ(coreIndex,0);
+  ASS(_unsatCore.isNonEmpty());
+
+  res.loadFromIterator(LiteralStack::ConstIterator(_unsatCore));
+}
+
+}
@@ -0,0 +1,226 @@
+
+/*
+ * File LinearArithmeticDP.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file LinearArithmeticDP.hpp
+ * Defines class LinearArithmeticDP.
+ */
+
+#ifndef __LinearArithmeticDP__
+#define __LinearArithmeticDP__
+
+#include "Forwards.hpp"
+
+#include "Lib/DHMap.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Term.hpp"
+#include "Kernel/Theory.hpp"
+
+#include "DecisionProcedure.hpp"
+
+namespace DP {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Decision procedure for ground linear constraints over integers, rationals
+ * and reals, following Dutertre, de Moura (2006) A Fast Linear-Arithmetic
+ * Solver for DPLL(T).
+ *
+ * Every maximal non-arithmetic subterm (including non-linear products) is
+ * treated as a variable. A constraint over several variables gets a slack
+ * variable defined by a row of the tableau, so that all the asserted
+ * literals become bounds on single variables. Bounds are retracted by
+ * popLevels, the tableau itself is never shrunk.
+ *
+ * Integer constraints are checked in their rational relaxation, with the
+ * bounds rounded to integers, so SATISFIABLE is only reported when no
+ * integer variable is bounded.
+ */
+class LinearArithmeticDP : public DecisionProcedure
+{
+public:
+  CLASS_NAME(LinearArithmeticDP);
+  USE_ALLOCATOR(LinearArithmeticDP);
+
+  LinearArithmeticDP();
+  ~LinearArithmeticDP();
+
+  virtual void addLiterals(LiteralIterator lits, bool onlyEqualites) override;
+
+  virtual Status getStatus(bool retrieveMultipleCores) override;
+  virtual unsigned getUnsatCoreCount() override { return _unsatCore.isEmpty() ? 0 : 1; }
+  virtual void getUnsatCore(LiteralStack& res, unsigned coreIndex) override;
+
+  virtual void getModel(LiteralStack& model) override;
+
+  virtual void reset() override;
+  virtual void pushLevel() override;
+  virtual void popLevels(unsigned cnt) override;
+
+  static bool isLinearConstraint(Literal* lit);
+
+private:
+  typedef RationalConstantType Rational;
+
+  /**
+   * Number r + k*delta where delta is an infinitesimal, so that strict
+   * bounds can be represented as non-strict ones
+   */
+  struct DeltaRational
+  {
+    DeltaRational() : real(0), delta(0) {}
+    DeltaRational(const Rational& real, const Rational& delta) : real(real), delta(delta) {}
+
+    DeltaRational operator+(const DeltaRational& o) const { return DeltaRational(real+o.real, delta+o.delta); }
+    DeltaRational operator-(const DeltaRational& o) const { return DeltaRational(real-o.real, delta-o.delta); }
+    DeltaRational operator*(const Rational& c) const { return DeltaRational(real*c, delta*c); }
+
+    bool operator==(const DeltaRational& o) const { return real==o.real && delta==o.delta; }
+    bool operator<(const DeltaRational& o) const { return real<o.real || (real==o.real && delta<o.delta); }
+    bool operator<=(const DeltaRational& o) const { return !(o<*this); }
+
+    Rational real;
+    Rational delta;
+  };
+
+  struct Bound
+  {
+    Bound() : reason(0) {}
+    Bound(const DeltaRational& val, Literal* reason) : val(val), reason(reason) {}
+
+    bool present() const { return reason; }
+
+    DeltaRational val;
+    /** the literal the bound comes from; 0 if there is no bound */
+    Literal* reason;
+  };
+
+  struct VarInfo
+  {
+    VarInfo(bool isInt) : isInt(isInt), row(-1), inQuery(false) {}
+
+    bool isInt;
+    Bound lower;
+    Bound upper;
+    DeltaRational value;
+    /** index of the row defining the variable if it is basic, -1 otherwise */
+    int row;
+    /** true if the variable stands for a term of the literals added at the open levels */
+    bool inQuery;
+  };
+
+  /** A basic variable expressed as a combination of the non-basic ones */
+  struct Row
+  {
+    CLASS_NAME(LinearArithmeticDP::Row);
+    USE_ALLOCATOR(Row);
+
+    unsigned basic;
+    DHMap<unsigned,Rational> coeffs;
+  };
+
+  typedef Stack<pair<unsigned,Rational> > LinearForm;
+
+  enum Relation {
+    LT,
+    LE,
+    EQ,
+    NE
+  };
+
+  void addLiteral(Literal* lit);
+  static bool readConstraint(Literal* lit, unsigned& sort, TermList& lhs, TermList& rhs, Relation& rel);
+  bool readNumeral(TermList t, unsigned sort, Rational& res);
+  void linearize(TermList t, unsigned sort, const Rational& factor,
+      DHMap<unsigned,Rational>& coeffs, Rational& constant);
+  unsigned getTermVar(TermList t, unsigned sort);
+  unsigned getSlackVar(const LinearForm& form, bool isInt);
+
+  void assertLower(unsigned var, const DeltaRational& val, Literal* reason);
+  void assertUpper(unsigned var, const DeltaRational& val, Literal* reason);
+  void setConflict(Literal* l1, Literal* l2=0);
+
+  bool isBasic(unsigned var) const { return _vars[var].row!=-1; }
+  void update(unsigned var, const DeltaRational& val);
+  void pivotAndUpdate(unsigned basic, unsigned nonBasic, const DeltaRational& val);
+  void pivot(unsigned basic, unsigned nonBasic);
+  bool check();
+  bool checkDisequalities();
+  bool hasBoundedIntegers() const;
+  Rational computeDelta() const;
+  Rational modelValue(unsigned var, const Rational& delta) const;
+
+  Stack<VarInfo> _vars;
+  Stack<Row*> _rows;
+
+  /** Variables standing for the non-arithmetic terms */
+  DHMap<TermList,unsigned> _termVars;
+  /**
+   * The terms of the literals added at the open levels with their variables,
+   * which are the ones the model is about. The variables of the earlier
+   * literals stay in the tableau, but no longer have any bounds.
+   */
+  Stack<pair<TermList,unsigned> > _queryTerms;
+  /** Slack variables, keyed by the printed normalized linear form they stand for */
+  DHMap<vstring,unsigned> _slackVars;
+
+  struct Disequality
+  {
+    Disequality(unsigned var, const Rational& val, Literal* reason) : var(var), val(val), reason(reason) {}
+
+    unsigned var;
+    Rational val;
+    Literal* reason;
+  };
+  Stack<Disequality> _disequalities;
+
+  /** A bound replaced by a tighter one, to be restored by popLevels */
+  struct BoundChange
+  {
+    BoundChange(unsigned var, bool upper, const Bound& old) : var(var), upper(upper), old(old) {}
+
+    unsigned var;
+    bool upper;
+    Bound old;
+  };
+  Stack<BoundChange> _trail;
+
+  struct LevelMark
+  {
+    unsigned trail;
+    unsigned disequalities;
+    unsigned queryTerms;
+  };
+  Stack<LevelMark> _levels;
+
+  /** Non-empty iff a conflict was found */
+  LiteralStack _unsatCore;
+  /**
+   * Number of levels when the conflict was found. Literals are not
+   * asserted while there is a conflict, so popping below this level
+   * makes the state consistent again.
+   */
+  unsigned _conflictLevel;
+}; // class LinearArithmeticDP
+
+}
+
+#endif // __LinearArithmeticDP__
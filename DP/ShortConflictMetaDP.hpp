@@ -63,6 +63,17 @@ public:
     _unsatCores.reset();
   }
 
+  virtual void pushLevel() override {
+    CALL("ShortConflictMetaDP::pushLevel");
+    _inner->pushLevel();
+  }
+
+  virtual void popLevels(unsigned cnt) override {
+    CALL("ShortConflictMetaDP::popLevels");
+    _inner->popLevels(cnt);
+    _unsatCores.reset();
+  }
+
   virtual Status getStatus(bool getMultipleCores) override;
 
   void getModel(LiteralStack& model) override {
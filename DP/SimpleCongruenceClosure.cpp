@@ -173,6 +173,7 @@ void SimpleCongruenceClosure::reset()
   _cInfos.expand(1);
   _sigConsts.reset();
   _pairNames.reset();
+  _namedPairs.reset();
   _termNames.reset();
   _litNames.reset();
 
@@ -189,15 +190,14 @@ void SimpleCongruenceClosure::reset()
     _cInfos[i].resetEquivalences(*this, i);
   }
 
-  PairMap::DelIterator pmit(_pairNames);
+  // only the pairs as they were named remain in the lookup
+  _pairNames.reset();
+  PairMap::Iterator pmit(_namedPairs);
   while(pmit.hasNext()) {
     CPair namePair;
     unsigned nameConst;
     pmit.next(namePair, nameConst);
-
-    if(_cInfos[nameConst].namedPair!=namePair) {
-      pmit.del();
-    }
+    _pairNames.insert(namePair, nameConst);
   }
 
   //this leaves us just with the true!=false non-equality
@@ -213,6 +213,10 @@ void SimpleCongruenceClosure::reset()
   _distinctConstraints.reset();
   _negDistinctConstraints.reset();
 
+  _undoTrail.reset();
+  _levels.reset();
+  _attachedNames.reset();
+
   _hadPropagated = false;
 }
 
@@ -249,7 +253,7 @@ unsigned SimpleCongruenceClosure::getPairName(CPair p)
   CALL("SimpleCongruenceClosure::getPairName");
 
   unsigned* pRes;
-  if(!_pairNames.getValuePtr(p, pRes)) {
+  if(!_namedPairs.getValuePtr(p, pRes)) {
     return *pRes;
   }
   unsigned res = getFreshConst();
@@ -257,23 +261,66 @@ unsigned SimpleCongruenceClosure::getPairName(CPair p)
   *pRes = res;
 
   _cInfos[p.first].useList.push(res);
-  if(_cInfos[p.first].reprConst!=0) {
-    // Martin: if we are here, the above insertion was not needed now,
-    // but will become necessary after reset(); see resetEquivalences
-    unsigned fRepr = _cInfos[p.first].reprConst;
-    _cInfos[fRepr].useList.push(res);
-  }
   _cInfos[p.second].useList.push(res);
-  if(_cInfos[p.second].reprConst!=0) {
-    // Martin: if we are here, the above insertion was not needed now,
-    // but will become necessary after reset(); see resetEquivalences
-    unsigned sRepr = _cInfos[p.second].reprConst;
-    _cInfos[sRepr].useList.push(res);
+
+  // The pair as it was named is always in the lookup. If it is there with
+  // the name of a congruent pair, it gets res back when that is undone.
+  unsigned* pLookup;
+  if(_pairNames.getValuePtr(p, pLookup)) {
+    *pLookup = res;
   }
+  attachPairName(res);
 
   return res;
 }
 
+/**
+ * Classes can already be merged when a pair is named between levels. Link
+ * the name @c c to the representatives of the classes of its arguments and
+ * to the names of congruent pairs, as propagate would have done had the
+ * name existed when the classes were merged.
+ *
+ * The links are undone with the current level while the merges may belong
+ * to an enclosing one, so popLevels calls this again for the names whose
+ * links were undone.
+ */
+void SimpleCongruenceClosure::attachPairName(unsigned c)
+{
+  CALL("SimpleCongruenceClosure::attachPairName");
+
+  unsigned trailSize = _undoTrail.size();
+
+  CPair p = _cInfos[c].namedPair;
+  CPair derefP = deref(p);
+  if(derefP!=p) {
+    // Martin: if we are here, the insertions in getPairName were not needed now,
+    // but will become necessary after reset(); see resetEquivalences
+    if(derefP.first!=p.first) {
+      _cInfos[derefP.first].useList.push(c);
+      _undoTrail.push(UndoEntry(UndoEntry::USE_PUSH, derefP.first, c));
+    }
+    if(derefP.second!=p.second) {
+      _cInfos[derefP.second].useList.push(c);
+      _undoTrail.push(UndoEntry(UndoEntry::USE_PUSH, derefP.second, c));
+    }
+  }
+
+  unsigned* pLookup;
+  if(_pairNames.getValuePtr(derefP, pLookup)) {
+    ASS(derefP!=p);
+    *pLookup = c;
+    _undoTrail.push(UndoEntry(UndoEntry::PAIR_INSERT, derefP.first, derefP.second));
+  }
+  else if(*pLookup!=c) {
+    addPendingEquality(CEq(*pLookup, c));
+  }
+  else if(derefP==p) {
+    // nothing depends on the classes
+    return;
+  }
+  _attachedNames.push(make_pair(c, trailSize));
+}
+
 struct SimpleCongruenceClosure::FOConversionWorker
 {
   FOConversionWorker(SimpleCongruenceClosure& parent)
@@ -444,7 +491,7 @@ SimpleCongruenceClosure::CEq SimpleCongruenceClosure::convertFOEquality(Literal*
 void SimpleCongruenceClosure::addLiterals(LiteralIterator lits, bool onlyEqualites)
 {
   CALL("SimpleCongruenceClosure::addLiterals");
-  ASS(!_hadPropagated);
+  ASS(!_hadPropagated || _levels.isNonEmpty());
 
   while(lits.hasNext()) {
     Literal* l = lits.next();
@@ -560,6 +607,7 @@ void SimpleCongruenceClosure::propagate()
     // Get the class representatives
     unsigned aRep = curr.first;
     unsigned bRep = curr.second;
+    _undoTrail.push(UndoEntry(UndoEntry::MERGE, aRep, bRep, curr0.c1, curr0.c2));
 
     ConstInfo& aInfo = _cInfos[aRep];
     ConstInfo& bInfo = _cInfos[bRep];
@@ -597,6 +645,8 @@ void SimpleCongruenceClosure::propagate()
       else {
 	*pDerefPairName = usePairConst;
 	bInfo.useList.push(usePairConst);
+	_undoTrail.push(UndoEntry(UndoEntry::PAIR_INSERT, derefPair.first, derefPair.second));
+	_undoTrail.push(UndoEntry(UndoEntry::USE_PUSH, bRep, usePairConst));
       }
     }
   }
@@ -680,6 +730,9 @@ DecisionProcedure::Status SimpleCongruenceClosure::getStatus(bool retrieveMultip
 {
   CALL("SimpleCongruenceClosure::getStatus");
 
+  // cores of a previous call may refer to retracted literals
+  _unsatEqs.reset();
+
   // Propagate any pending equalities
   propagate();
 
@@ -730,6 +783,122 @@ DecisionProcedure::Status SimpleCongruenceClosure::getStatus(bool retrieveMultip
   return DecisionProcedure::SATISFIABLE;
 }
 
+/**
+ * Open a new backtracking level. Pending equalities are propagated first,
+ * so that the merges they cause belong to the enclosing level.
+ */
+void SimpleCongruenceClosure::pushLevel()
+{
+  CALL("SimpleCongruenceClosure::pushLevel");
+
+  propagate();
+
+  LevelMark mark;
+  mark.trail = _undoTrail.size();
+  mark.negEqualities = _negEqualities.size();
+  mark.distincts = _distinctConstraints.size();
+  mark.negDistincts = _negDistinctConstraints.size();
+  _levels.push(mark);
+}
+
+/**
+ * Revert the state to the one before the last @c cnt calls to pushLevel.
+ * The constants naming terms and pairs are kept.
+ */
+void SimpleCongruenceClosure::popLevels(unsigned cnt)
+{
+  CALL("SimpleCongruenceClosure::popLevels");
+  ASS_LE(cnt, _levels.size());
+
+  if(cnt==0) {
+    return;
+  }
+  LevelMark mark = _levels[_levels.size()-cnt];
+  _levels.truncate(_levels.size()-cnt);
+
+  // pending equalities were all added at the innermost level
+  _pendingEqualities.reset();
+
+  while(_undoTrail.size()>mark.trail) {
+    undo(_undoTrail.pop());
+  }
+  _negEqualities.truncate(mark.negEqualities);
+  _distinctConstraints.truncate(mark.distincts);
+  _negDistinctConstraints.truncate(mark.negDistincts);
+  _unsatEqs.reset();
+
+  // the names whose links to the classes were just undone
+  static Stack<unsigned> detached;
+  detached.reset();
+  while(_attachedNames.isNonEmpty() && _attachedNames.top().second>=mark.trail) {
+    detached.push(_attachedNames.pop().first);
+  }
+  while(detached.isNonEmpty()) {
+    attachPairName(detached.pop());
+  }
+}
+
+void SimpleCongruenceClosure::undo(const UndoEntry& e)
+{
+  CALL("SimpleCongruenceClosure::undo");
+
+  switch(e.kind) {
+  case UndoEntry::MERGE: {
+    unsigned aRep = e.c1;
+    unsigned bRep = e.c2;
+    ConstInfo& aInfo = _cInfos[aRep];
+    ConstInfo& bInfo = _cInfos[bRep];
+    ASS_EQ(aInfo.reprConst, bRep);
+    ASS_EQ(bInfo.reprConst, 0);
+
+    // the members of a's class were pushed at the top of b's class list
+    bInfo.classList.truncate(bInfo.classList.size()-aInfo.classList.size()-1);
+    aInfo.reprConst = 0;
+    Stack<unsigned>::Iterator aChildIt(aInfo.classList);
+    while(aChildIt.hasNext()) {
+      _cInfos[aChildIt.next()].reprConst = aRep;
+    }
+
+    // Later merges may have re-rooted the proof trees, so the edge
+    // between c3 and c4 can now point either way. Removing it splits
+    // the tree into two trees, each with a single root.
+    if(_cInfos[e.c3].proofPredecessor==e.c4) {
+      _cInfos[e.c3].proofPredecessor = 0;
+      _cInfos[e.c3].predecessorPremise = CEq(0,0);
+    }
+    else {
+      ASS_EQ(_cInfos[e.c4].proofPredecessor, e.c3);
+      _cInfos[e.c4].proofPredecessor = 0;
+      _cInfos[e.c4].predecessorPremise = CEq(0,0);
+    }
+    break;
+  }
+  case UndoEntry::USE_PUSH: {
+    // order in use lists does not matter, so drop the last occurrence
+    Stack<unsigned>& useList = _cInfos[e.c1].useList;
+    for(unsigned i=useList.size(); i>0; i--) {
+      if(useList[i-1]==e.c2) {
+        useList[i-1] = useList.top();
+        useList.pop();
+        break;
+      }
+    }
+    break;
+  }
+  case UndoEntry::PAIR_INSERT: {
+    CPair p(e.c1, e.c2);
+    unsigned name;
+    if(_namedPairs.find(p, name)) {
+      _pairNames.set(p, name);
+    }
+    else {
+      ALWAYS(_pairNames.remove(p));
+    }
+    break;
+  }
+  }
+}
+
 /**
  * Return the depth of constant @c c in the tree determined
  * by ConstInfo::proofPredecessor. 0 means @c c is the root.
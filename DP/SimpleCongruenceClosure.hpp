@@ -71,6 +71,8 @@ public:
   void getModel(LiteralStack& model) override;
   
   virtual void reset() override;
+  virtual void pushLevel() override;
+  virtual void popLevels(unsigned cnt) override;
 
   /**
    * New, more fine-grained way of insertion. The terms may contain variables which are treated as constants.
@@ -133,6 +135,7 @@ private:
   unsigned getFreshConst();
   unsigned getSignatureConst(unsigned symbol, SignatureKind kind);
   unsigned getPairName(CPair p);
+  void attachPairName(unsigned c);
 
 
   struct FOConversionWorker;
@@ -280,6 +283,8 @@ private:
   typedef DHMap<CPair,unsigned> PairMap;
   /** Names of constant pairs (modulo the congruence!)*/
   PairMap _pairNames;
+  /** Names of constant pairs as they were created (not modulo the congruence) */
+  PairMap _namedPairs;
 
   /** Constants corresponding to terms */
   DHMap<TermList,unsigned> _termNames;
@@ -308,6 +313,48 @@ private:
    * "It can be used only as a fact, not under any connective." */  
   DistinctStack _negDistinctConstraints;
 
+  /**
+   * A change made by propagation (or by naming a new pair while
+   * some classes are merged) that popLevels has to revert
+   */
+  struct UndoEntry
+  {
+    enum Kind {
+      /** class of c1 was merged into c2 and proof edge c3 -> c4 was added */
+      MERGE,
+      /** c2 was pushed on the useList of c1 */
+      USE_PUSH,
+      /** pair (c1,c2) was inserted into _pairNames */
+      PAIR_INSERT
+    };
+    UndoEntry(Kind kind, unsigned c1, unsigned c2, unsigned c3=0, unsigned c4=0)
+     : kind(kind), c1(c1), c2(c2), c3(c3), c4(c4) {}
+
+    Kind kind;
+    unsigned c1;
+    unsigned c2;
+    unsigned c3;
+    unsigned c4;
+  };
+  void undo(const UndoEntry& e);
+  /** Changes in the order they were made, reverted by popLevels */
+  Stack<UndoEntry> _undoTrail;
+
+  /** Sizes of the undo trail and of the constraint stacks when a level was opened */
+  struct LevelMark
+  {
+    unsigned trail;
+    unsigned negEqualities;
+    unsigned distincts;
+    unsigned negDistincts;
+  };
+  Stack<LevelMark> _levels;
+  /**
+   * Names linked to the classes of their arguments by attachPairName, with
+   * the size of the undo trail at that time
+   */
+  Stack<pair<unsigned,unsigned> > _attachedNames;
+
   /**
    * used to assert we don't add literals after propagation.
    * this would cause problems with term caches upon reset.
@@ -26,6 +26,7 @@
  */
 
 #include <math.h>
+#include <fstream>
 
 #include "Kernel/Ordering.hpp"
 #include "Kernel/Inference.hpp"
@@ -42,6 +43,7 @@
 #include "SAT/Preprocess.hpp"
 #include "SAT/TWLSolver.hpp"
 #include "SAT/MinisatInterfacingNewSimp.hpp"
+#include "SAT/TraceRecordingSolver.hpp"
 #include "SAT/BufferedSolver.hpp"
 
 #include "Lib/Environment.hpp"
@@ -82,7 +84,7 @@ namespace FMB
 
 FiniteModelBuilder::FiniteModelBuilder(Problem& prb, const Options& opt)
 : MainLoop(prb, opt), _sortedSignature(0), _groundClauses(0), _clauses(0),
-                      _isAppropriate(true)
+                      _satVariables(0), _sizeStatsWritten(0), _groundClausesTranslated(false), _isAppropriate(true)
 
 {
   CALL("FiniteModelBuilder::FiniteModelBuilder");
@@ -156,6 +158,11 @@ FiniteModelBuilder::~FiniteModelBuilder()
 
     delete _dsaEnumerator;
   }
+
+  SATClauseStack::Iterator it(_groundSATClauses);
+  while (it.hasNext()) {
+    it.next()->destroy();
+  }
 }
 
 // Do all setting up required for finite model search 
@@ -177,6 +184,15 @@ bool FiniteModelBuilder::reset(){
 
   // Start from 1 as SAT solver variables are 1-based
   unsigned offsets=1;
+
+  // Propositional symbols come first, their variables do not depend on the
+  // sort sizes and so the translation of the ground clauses can be reused
+  for(unsigned p=1; p<env.signature->predicates();p++){
+    if(del_p[p] || env.signature->predicateArity(p)>0) continue;
+    p_offsets[p]=offsets;
+    offsets++;
+  }
+
   for(unsigned f=0; f<env.signature->functions();f++){
     if(del_f[f]) continue; 
     f_offsets[f]=offsets;
@@ -200,7 +216,7 @@ bool FiniteModelBuilder::reset(){
   }
   // Start from p=1 as we ignore equality
   for(unsigned p=1; p<env.signature->predicates();p++){
-    if(del_p[p]) continue;
+    if(del_p[p] || env.signature->predicateArity(p)==0) continue;
     p_offsets[p]=offsets;
 #if VTRACE_FMB
     cout << "offset for " << p << " is " << offsets << " for " << env.signature->predicateName(p) << endl; 
@@ -263,7 +279,7 @@ bool FiniteModelBuilder::reset(){
 
   // Create a new SAT solver
   try{
-    _solver = new MinisatInterfacingNewSimp(_opt,true);
+    _solver = TraceRecordingSolver::wrapIfRequested(new MinisatInterfacingNewSimp(_opt), _opt);
   }catch(Minisat::OutOfMemoryException&){
     MinisatInterfacingNewSimp::reportMinisatOutOfMemory();
   }
@@ -295,6 +311,7 @@ bool FiniteModelBuilder::reset(){
 */
 
   // set the number of SAT variables, this could cause an exception
+  _satVariables = offsets-1;
   _solver->ensureVarCount(offsets-1);
 
   // needs to be redone for each size as we use this to pick the number of
@@ -925,6 +942,14 @@ void FiniteModelBuilder::addGroundClauses()
   // If we don't have any ground clauses don't do anything
   if(!_groundClauses) return;
 
+  // The translation is the same for every model size (see reset)
+  if(_groundClausesTranslated){
+    _clausesToBeAdded.loadFromIterator(SATClauseStack::ConstIterator(_groundSATClauses));
+    return;
+  }
+  _groundClausesTranslated = true;
+  ASS(_clausesToBeAdded.isEmpty());
+
   ClauseList::Iterator cit(_groundClauses);
 
   // Note ground clauses will consist of propositional symbols only due to flattening
@@ -944,6 +969,7 @@ void FiniteModelBuilder::addGroundClauses()
       SATClause* satCl = SATClause::fromStack(satClauseLits);
       addSATClause(satCl);
   }
+  _groundSATClauses.loadFromIterator(SATClauseStack::ConstIterator(_clausesToBeAdded));
 }
 
 // uses _distinctSortSizes to estimate how many instances would we generate
@@ -977,6 +1003,28 @@ void FiniteModelBuilder::addNewInstances()
 {
   CALL("FiniteModelBuilder::addNewInstances");
 
+  /**
+   * How a literal of the current clause is turned into a SAT literal
+   * for a given grounding. Apart from variable equalities, the SAT variable
+   * is base + sum of strides[k].second*(grounding[strides[k].first]-1)
+   * for k from firstStride to firstStride+strideCnt-1.
+   */
+  struct LiteralPlan {
+    bool twoVarEquality;
+    bool polarity;
+    unsigned var0, var1; // for variable equalities
+    unsigned base;
+    unsigned firstStride;
+    unsigned strideCnt;
+  };
+
+  Stack<LiteralPlan> plans;
+  Stack<pair<unsigned,unsigned> > strides;
+  DArray<unsigned> maxVarSize;
+  DArray<unsigned> grounding;
+  ArrayMap<unsigned> varDistinctSortsMaxes(_distinctSortSizes.size());
+  SATLiteralStack satClauseLits;
+
   ClauseList::Iterator cit(_clauses); 
 
   while(cit.hasNext()){
@@ -988,7 +1036,6 @@ void FiniteModelBuilder::addNewInstances()
 
     unsigned vars = c->varCnt();
     const DArray<unsigned>* varSorts = _clauseVariableSorts.get(c) ;
-    static DArray<unsigned> maxVarSize;
     maxVarSize.ensure(vars);
 
     if(!varSorts){
@@ -1001,8 +1048,6 @@ void FiniteModelBuilder::addNewInstances()
     }
     ASS(varSorts);
 
-    static ArrayMap<unsigned> varDistinctSortsMaxes(_distinctSortSizes.size());
-
     if (!_xmass) {
       varDistinctSortsMaxes.reset();
     }
@@ -1021,8 +1066,57 @@ void FiniteModelBuilder::addNewInstances()
         }
       }
     }
-    
-    static DArray<unsigned> grounding;
+
+    // work out once per clause how each literal is grounded,
+    // following the variable layout of getSATLiteral
+    plans.reset();
+    strides.reset();
+    for(unsigned lindex=0;lindex<c->length();lindex++){
+      Literal* lit = (*c)[lindex];
+      LiteralPlan plan;
+      plan.polarity = lit->polarity();
+      plan.twoVarEquality = lit->isTwoVarEquality();
+      if(plan.twoVarEquality){
+        plan.var0 = lit->nthArgument(0)->var();
+        plan.var1 = lit->nthArgument(1)->var();
+        plans.push(plan);
+        continue;
+      }
+      plan.firstStride = strides.size();
+      unsigned mult = 1;
+      if(lit->isEquality()){
+        ASS(lit->nthArgument(0)->isTerm());
+        ASS(lit->nthArgument(1)->isVar());
+        Term* t = lit->nthArgument(0)->term();
+        unsigned functor = t->functor();
+        unsigned arity = t->arity();
+        const DArray<unsigned>& signature = _sortedSignature->functionSignatures[functor];
+        ASS_EQ(signature.size(),arity+1);
+        plan.base = f_offsets[functor];
+        for(unsigned j=0;j<arity;j++){
+          ASS(t->nthArgument(j)->isVar());
+          strides.push(make_pair(t->nthArgument(j)->var(),mult));
+          mult *= _sortModelSizes[signature[j]];
+        }
+        strides.push(make_pair(lit->nthArgument(1)->var(),mult));
+      }else{
+        unsigned functor = lit->functor();
+        unsigned arity = lit->arity();
+        // cannot have predicate 0 here (it's equality)
+        ASS(functor>0);
+        const DArray<unsigned>& signature = _sortedSignature->predicateSignatures[functor];
+        ASS_EQ(signature.size(),arity);
+        plan.base = p_offsets[functor];
+        for(unsigned j=0;j<arity;j++){
+          ASS(lit->nthArgument(j)->isVar());
+          strides.push(make_pair(lit->nthArgument(j)->var(),mult));
+          mult *= _sortModelSizes[signature[j]];
+        }
+      }
+      plan.strideCnt = strides.size()-plan.firstStride;
+      plans.push(plan);
+    }
+
     grounding.ensure(vars);
 
     for(unsigned i=0;i<vars;i++) grounding[i]=1;
@@ -1038,7 +1132,6 @@ instanceLabel:
       else{
         grounding[var]++;
         // Grounding represents a new instance
-        static SATLiteralStack satClauseLits;
         satClauseLits.reset();
 
         if (_xmass) {
@@ -1084,49 +1177,26 @@ instanceLabel:
         }
 
         // Ground and translate each literal into a SATLiteral
-        for(unsigned lindex=0;lindex<c->length();lindex++){
-          Literal* lit = (*c)[lindex];
+        for(unsigned lindex=0;lindex<plans.size();lindex++){
+          const LiteralPlan& plan = plans[lindex];
 
           // check cases where literal is x=y
-          if(lit->isTwoVarEquality()){
-            bool equal = grounding[lit->nthArgument(0)->var()] == grounding[lit->nthArgument(1)->var()]; 
-            if((lit->isPositive() && equal) || (!lit->isPositive() && !equal)){
+          if(plan.twoVarEquality){
+            bool equal = grounding[plan.var0] == grounding[plan.var1]; 
+            if(plan.polarity == equal){
               //Skip instance
               goto instanceLabel; 
             } 
-            if((lit->isPositive() && !equal) || (!lit->isPositive() && equal)){
-              //Skip literal
-              continue;
-            }
+            //Skip literal
+            continue;
           }
-          if(lit->isEquality()){
-            ASS(lit->nthArgument(0)->isTerm());
-            ASS(lit->nthArgument(1)->isVar());
-            Term* t = lit->nthArgument(0)->term();
-            unsigned functor = t->functor();
-            unsigned arity = t->arity();
-            static DArray<unsigned> use;
-            use.ensure(arity+1);
-
-            for(unsigned j=0;j<arity;j++){
-              ASS(t->nthArgument(j)->isVar());
-              use[j] = grounding[t->nthArgument(j)->var()];
-            }
-            use[arity]=grounding[lit->nthArgument(1)->var()];
-            satClauseLits.push(getSATLiteral(functor,use,lit->polarity(),true));
-            
-          }else{
-            unsigned functor = lit->functor();
-            unsigned arity = lit->arity();
-            static DArray<unsigned> use;
-            use.ensure(arity);
-
-            for(unsigned j=0;j<arity;j++){
-              ASS(lit->nthArgument(j)->isVar());
-              use[j] = grounding[lit->nthArgument(j)->var()];
-            }
-            satClauseLits.push(getSATLiteral(functor,use,lit->polarity(),false));
+
+          unsigned satVar = plan.base;
+          unsigned strideEnd = plan.firstStride+plan.strideCnt;
+          for(unsigned k=plan.firstStride;k<strideEnd;k++){
+            satVar += strides[k].second*(grounding[strides[k].first]-1);
           }
+          satClauseLits.push(SATLiteral(satVar,plan.polarity));
         }
      
         SATClause* satCl = SATClause::fromStack(satClauseLits);
@@ -1544,6 +1614,7 @@ MainLoopResult FiniteModelBuilder::runImpl()
 
   env.statistics->phase = Statistics::FMB_CONSTRAINT_GEN;
 
+  int startTime = env.timer->elapsedMilliseconds();
 
   if(outputAllowed()){
       bool doPrinting = false;
@@ -1593,33 +1664,60 @@ MainLoopResult FiniteModelBuilder::runImpl()
     Timer::syncClock();
     if(env.timeLimitReached()){ return MainLoopResult(Statistics::TIME_LIMIT); }
 
+    env.statistics->fmbSizesTried++;
+
+    int phaseStart = env.timer->elapsedMilliseconds();
     {
     TimeCounter tc(TC_FMB_CONSTRAINT_CREATION);
 
     // add the new clauses to _clausesToBeAdded
+    // the per-phase clause counts are the growth of _clausesToBeAdded
 #if VTRACE_FMB
     cout << "GROUND" << endl;
 #endif
     addGroundClauses();
+    _sizeStats.groundClauses = _clausesToBeAdded.size();
 #if VTRACE_FMB
     cout << "INSTANCES" << endl;
 #endif
-    addNewInstances();
+    {
+      TimeCounter tci(TC_FMB_INSTANCES);
+      addNewInstances();
+    }
+    _sizeStats.instances = _clausesToBeAdded.size() - _sizeStats.groundClauses;
 #if VTRACE_FMB
     cout << "FUNC DEFS" << endl;
 #endif
-    addNewFunctionalDefs();
+    unsigned before = _clausesToBeAdded.size();
+    {
+      TimeCounter tcf(TC_FMB_FUNCTIONAL_DEFS);
+      addNewFunctionalDefs();
+    }
+    _sizeStats.functionalDefs = _clausesToBeAdded.size() - before;
 #if VTRACE_FMB
     cout << "SYM DEFS" << endl;
 #endif
-    addNewSymmetryAxioms();
+    before = _clausesToBeAdded.size();
+    {
+      TimeCounter tcs(TC_FMB_SYMMETRY_AXIOMS);
+      addNewSymmetryAxioms();
+    }
+    _sizeStats.symmetryAxioms = _clausesToBeAdded.size() - before;
     
 #if VTRACE_FMB
     cout << "TOTAL DEFS" << endl;
 #endif
-    addNewTotalityDefs();
+    before = _clausesToBeAdded.size();
+    {
+      TimeCounter tct(TC_FMB_TOTALITY_DEFS);
+      addNewTotalityDefs();
+    }
+    _sizeStats.totalityDefs = _clausesToBeAdded.size() - before;
 
     }
+    _sizeStats.satVariables = _satVariables;
+    _sizeStats.constraintTime = env.timer->elapsedMilliseconds() - phaseStart;
+    phaseStart = env.timer->elapsedMilliseconds();
 
 #if VTRACE_FMB
     cout << "SOLVING" << endl;
@@ -1655,9 +1753,12 @@ MainLoopResult FiniteModelBuilder::runImpl()
       satResult = _solver->solveUnderAssumptions(assumptions);
       env.statistics->phase = Statistics::FMB_CONSTRAINT_GEN;
     }
+    _sizeStats.satTime = env.timer->elapsedMilliseconds() - phaseStart;
+    dumpSizeStatistics(satResult);
 
     // if the clauses are satisfiable then we have found a finite model
     if(satResult == SATSolver::SATISFIABLE){
+      env.statistics->fmbTimeToModel = env.timer->elapsedMilliseconds() - startTime;
       onModelFound();
       return MainLoopResult(Statistics::SATISFIABLE);
     }
@@ -1667,10 +1768,9 @@ MainLoopResult FiniteModelBuilder::runImpl()
     unsigned clauseSetSize = _clausesToBeAdded.size();
     unsigned weight = clauseSetSize;
 
-    // destroy the clauses
-    SATClauseStack::Iterator it(_clausesToBeAdded);
-    while (it.hasNext()) {
-      it.next()->destroy();
+    // destroy the clauses, except for the ground ones which are kept for the next size
+    for (unsigned i = _groundSATClauses.size(); i < clauseSetSize; i++) {
+      _clausesToBeAdded[i]->destroy();
     }
     // but the container needs to be empty for the next round in any case
     _clausesToBeAdded.reset();
@@ -1834,6 +1934,46 @@ MainLoopResult FiniteModelBuilder::runImpl()
   return MainLoopResult(Statistics::REFUTATION_NOT_FOUND);
 }
 
+/**
+ * Append the statistics of the model size just tried to the file given
+ * by --fmb_statistics_file, one JSON object per line. The file is truncated
+ * when the first record is written.
+ */
+void FiniteModelBuilder::dumpSizeStatistics(SATSolver::Status status)
+{
+  CALL("FiniteModelBuilder::dumpSizeStatistics");
+
+  vstring fileName = _opt.fmbStatisticsFile();
+  if (fileName == "off") {
+    return;
+  }
+
+  BYPASSING_ALLOCATOR;
+
+  ofstream out(fileName.c_str(), _sizeStatsWritten ? ios::app : ios::trunc);
+  if (out.fail()) {
+    USER_ERROR("Cannot open fmb statistics file: "+fileName);
+  }
+  _sizeStatsWritten++;
+
+  out << "{\"sizes\":[";
+  for (unsigned i = 0; i < _distinctSortSizes.size(); i++) {
+    out << (i ? "," : "") << _distinctSortSizes[i];
+  }
+  out << "],\"sat_variables\":" << _sizeStats.satVariables
+      << ",\"ground_clauses\":" << _sizeStats.groundClauses
+      << ",\"instances\":" << _sizeStats.instances
+      << ",\"functional_defs\":" << _sizeStats.functionalDefs
+      << ",\"symmetry_axioms\":" << _sizeStats.symmetryAxioms
+      << ",\"totality_defs\":" << _sizeStats.totalityDefs
+      << ",\"constraint_time_ms\":" << _sizeStats.constraintTime
+      << ",\"sat_time_ms\":" << _sizeStats.satTime
+      << ",\"memory_bytes\":" << Allocator::getUsedMemory()
+      << ",\"result\":\"" << (status == SATSolver::SATISFIABLE ? "sat" :
+                               status == SATSolver::UNSATISFIABLE ? "unsat" : "unknown")
+      << "\"}" << endl;
+}
+
 void FiniteModelBuilder::onModelFound()
 {
  CALL("FiniteModelBuilder::onModelFound");
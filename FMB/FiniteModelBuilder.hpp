@@ -163,6 +163,9 @@ private:
   }
   // SAT clauses to be added. We record them so we can delete them after calling the SAT solver
   SATClauseStack _clausesToBeAdded;
+  // The translation of _groundClauses, made once and given to the solver of every model size
+  SATClauseStack _groundSATClauses;
+  bool _groundClausesTranslated;
 
   // The inferred signature of sorts (see SortInference.hpp)
   SortedSignature* _sortedSignature;
@@ -234,6 +237,26 @@ private:
   // how often do we pick the next domain to grow by size and how often by weight (= encoding size estimate)
   unsigned _sizeWeightRatio;
 
+  // Breakdown of the work done for one model size, written to --fmb_statistics_file
+  struct SizeStatistics {
+    unsigned satVariables;
+    unsigned groundClauses;
+    unsigned instances;
+    unsigned functionalDefs;
+    unsigned symmetryAxioms;
+    unsigned totalityDefs;
+    int constraintTime;
+    int satTime;
+  };
+  SizeStatistics _sizeStats;
+  // the number of SAT variables allocated by the last reset()
+  unsigned _satVariables;
+  // number of records written to --fmb_statistics_file so far
+  unsigned _sizeStatsWritten;
+
+  // Appends the record for the current model size to --fmb_statistics_file (if set)
+  void dumpSizeStatistics(SATSolver::Status status);
+
   // sizes to use for each sort
   DArray<unsigned> _sortModelSizes;
   DArray<unsigned> _distinctSortSizes;
@@ -216,6 +216,7 @@ typedef VirtualIterator<Matcher*> MatchIterator;
 
 class TermTransformer;
 class TermTransformerTransformTransformed;
+class PolynomialNormalizer;
 class FormulaTransformer;
 class FormulaUnitTransformer;
 
@@ -319,11 +320,13 @@ class PassiveClauseContainer;
 typedef Lib::SmartPtr<PassiveClauseContainer> PassiveClauseContainerSP;
 
 class ActiveClauseContainer;
+class DeferredClauseContainer;
 
 class Splitter;
 class ConsequenceFinder;
 class LabelFinder;
 class SymElOutput;
+class OriginProfiler;
 }
 
 namespace Inferences
@@ -26,6 +26,10 @@
 #include "Kernel/Signature.hpp"
 #include "Kernel/SortHelper.hpp"
 
+#include <algorithm>
+
+#include "Debug/RuntimeStatistics.hpp"
+
 #include "Lib/Backtrackable.hpp"
 #include "Lib/Environment.hpp"
 #include "Lib/Stack.hpp"
@@ -139,7 +143,9 @@ namespace Indexing
       lit(l),
       clause(c),
       t(t),
-      subterms(subterms)
+      subterms(subterms),
+      order(0),
+      visited(false)
     {}
 
     CLASS_NAME(AcyclicityIndex::IndexEntry);
@@ -149,6 +155,16 @@ namespace Indexing
     Clause* clause;
     TermList t;
     List<TermList>* subterms;
+
+    /** position of the entry in the topological order of the graph */
+    unsigned order;
+    bool visited;
+    /** the edges consistent with the order */
+    Stack<IndexEntry*> succ;
+    Stack<IndexEntry*> pred;
+    /** the back edges */
+    Stack<IndexEntry*> backSucc;
+    Stack<IndexEntry*> backPred;
   };
 
   struct AcyclicityIndex::CycleSearchTreeNode
@@ -406,6 +422,25 @@ namespace Indexing
     unsigned _currentDepth;
   };
 
+  AcyclicityIndex::~AcyclicityIndex()
+  {
+    CALL("AcyclicityIndex::~AcyclicityIndex");
+
+    DHMap<unsigned, SIndex*>::Iterator sit(_sIndexes);
+    while (sit.hasNext()) {
+      SIndex* index = sit.next();
+      SIndex::Iterator eit(*index);
+      while (eit.hasNext()) {
+        IndexEntry* entry = eit.next();
+        List<TermList>::destroy(entry->subterms);
+        delete entry;
+      }
+      delete index;
+    }
+    delete _tis;
+    delete _subtermTis;
+  }
+
   void AcyclicityIndex::handleClause(Clause* c, bool adding)
   {
     CALL("AcyclicityIndex::handleClause");
@@ -442,8 +477,14 @@ namespace Indexing
 
       ULit ulit = make_pair(lit, c);
       if (!index->find(ulit)) {
-        index->insert(ulit, new IndexEntry(lit, c, *t, getSubterms(fs->term())));
+        IndexEntry* entry = new IndexEntry(lit, c, *t, getSubterms(fs->term()));
+        index->insert(ulit, entry);
         _tis->insert(*t, lit, c);
+        List<TermList>::Iterator it(entry->subterms);
+        while (it.hasNext()) {
+          _subtermTis->insert(it.next(), lit, c);
+        }
+        addNode(entry);
       }
     }
   }
@@ -458,18 +499,304 @@ namespace Indexing
      
     if (matchesPattern(lit, fs, t, &sort) && _sIndexes.find(sort)) {
       ULit ulit = make_pair(lit, c);
-      if (!_sIndexes.get(sort)->find(ulit))
+      IndexEntry* entry;
+      if (!_sIndexes.get(sort)->find(ulit, entry))
         return;
 
+      removeNode(entry);
+      List<TermList>::Iterator it(entry->subterms);
+      while (it.hasNext()) {
+        _subtermTis->remove(it.next(), lit, c);
+      }
       _sIndexes.get(sort)->remove(ulit);
-     _tis->remove(*t, lit, c);
+      _tis->remove(*t, lit, c);
+      List<TermList>::destroy(entry->subterms);
+      delete entry;
+    }
+  }
+
+  AcyclicityIndex::IndexEntry* AcyclicityIndex::findEntry(Literal* lit, Clause* c)
+  {
+    CALL("AcyclicityIndex::findEntry");
+
+    SIndex* index;
+    IndexEntry* res = nullptr;
+    if (lit->isEquality() && _sIndexes.find(SortHelper::getEqualityArgumentSort(lit), index)) {
+      index->find(make_pair(lit, c), res);
+    }
+    return res;
+  }
+
+  /**
+   * Add the edges from and to the new entry @b e, which must already be
+   * in the term indexing structures, and put it at the end of the order.
+   */
+  void AcyclicityIndex::addNode(IndexEntry* e)
+  {
+    CALL("AcyclicityIndex::addNode");
+
+    e->order = _nextOrder++;
+
+    List<TermList>::Iterator sit(e->subterms);
+    while (sit.hasNext()) {
+      TermQueryResultIterator it = _tis->getUnifications(sit.next(), false);
+      while (it.hasNext()) {
+        TermQueryResult tqr = it.next();
+        IndexEntry* to = findEntry(tqr.literal, tqr.clause);
+        if (to) {
+          addEdge(e, to);
+        }
+      }
+    }
+
+    TermQueryResultIterator it = _subtermTis->getUnifications(e->t, false);
+    while (it.hasNext()) {
+      TermQueryResult tqr = it.next();
+      IndexEntry* from = findEntry(tqr.literal, tqr.clause);
+      if (from) {
+        addEdge(from, e);
+      }
     }
   }
 
+  void AcyclicityIndex::removeNode(IndexEntry* e)
+  {
+    CALL("AcyclicityIndex::removeNode");
+
+    Stack<IndexEntry*>::Iterator sit(e->succ);
+    while (sit.hasNext()) {
+      ALWAYS(sit.next()->pred.remove(e));
+    }
+    Stack<IndexEntry*>::Iterator pit(e->pred);
+    while (pit.hasNext()) {
+      ALWAYS(pit.next()->succ.remove(e));
+    }
+
+    if (e->backSucc.isNonEmpty() || e->backPred.isNonEmpty()) {
+      Stack<IndexEntry*>::Iterator bsit(e->backSucc);
+      while (bsit.hasNext()) {
+        bsit.next()->backPred.remove(e);
+      }
+      Stack<IndexEntry*>::Iterator bpit(e->backPred);
+      while (bpit.hasNext()) {
+        bpit.next()->backSucc.remove(e);
+      }
+      unsigned i = 0;
+      while (i < _backEdges.size()) {
+        if (_backEdges[i].first == e || _backEdges[i].second == e) {
+          std::swap(_backEdges[i], _backEdges.top());
+          _backEdges.pop();
+        } else {
+          i++;
+        }
+      }
+    }
+    // removing the entry may have broken the cycles some back edges closed
+    _backEdgesChanged = _backEdges.isNonEmpty();
+  }
+
+  void AcyclicityIndex::addEdge(IndexEntry* from, IndexEntry* to)
+  {
+    CALL("AcyclicityIndex::addEdge");
+
+    if (from->succ.find(to) || from->backSucc.find(to)) {
+      return;
+    }
+    if (!orderEdge(from, to)) {
+      from->backSucc.push(to);
+      to->backPred.push(from);
+      _backEdges.push(make_pair(from, to));
+    }
+  }
+
+  /**
+   * Add the edge from @b from to @b to to the ordered graph, reordering the
+   * entries between them if needed, and return true, or return false if the
+   * edge would close a cycle.
+   */
+  bool AcyclicityIndex::orderEdge(IndexEntry* from, IndexEntry* to)
+  {
+    CALL("AcyclicityIndex::orderEdge");
+
+    if (from == to) {
+      return false;
+    }
+    if (from->order < to->order) {
+      from->succ.push(to);
+      to->pred.push(from);
+      return true;
+    }
+
+    unsigned lb = to->order;
+    unsigned ub = from->order;
+
+    // the entries reachable from to which are before from in the order
+    static Stack<IndexEntry*> forward;
+    // the entries from which from is reachable and which are after to in the order
+    static Stack<IndexEntry*> backward;
+    static Stack<IndexEntry*> toVisit;
+    forward.reset();
+    backward.reset();
+    toVisit.reset();
+
+    bool cycle = false;
+    to->visited = true;
+    forward.push(to);
+    toVisit.push(to);
+    while (toVisit.isNonEmpty() && !cycle) {
+      Stack<IndexEntry*>::Iterator it(toVisit.pop()->succ);
+      while (it.hasNext()) {
+        IndexEntry* n = it.next();
+        if (n == from) {
+          cycle = true;
+          break;
+        }
+        if (!n->visited && n->order < ub) {
+          n->visited = true;
+          forward.push(n);
+          toVisit.push(n);
+        }
+      }
+    }
+
+    if (!cycle) {
+      toVisit.reset();
+      from->visited = true;
+      backward.push(from);
+      toVisit.push(from);
+      while (toVisit.isNonEmpty()) {
+        Stack<IndexEntry*>::Iterator it(toVisit.pop()->pred);
+        while (it.hasNext()) {
+          IndexEntry* n = it.next();
+          if (!n->visited && n->order > lb) {
+            n->visited = true;
+            backward.push(n);
+            toVisit.push(n);
+          }
+        }
+      }
+    }
+
+    Stack<IndexEntry*>::Iterator fit(forward);
+    while (fit.hasNext()) {
+      fit.next()->visited = false;
+    }
+    Stack<IndexEntry*>::Iterator bit(backward);
+    while (bit.hasNext()) {
+      bit.next()->visited = false;
+    }
+    if (cycle) {
+      return false;
+    }
+
+    // the backward entries take the smallest of the positions of the affected
+    // entries, keeping their relative order, and the forward entries the rest
+    auto orderLess = [](IndexEntry* e1, IndexEntry* e2) { return e1->order < e2->order; };
+    std::sort(forward.begin(), forward.end(), orderLess);
+    std::sort(backward.begin(), backward.end(), orderLess);
+
+    static Stack<unsigned> orders;
+    orders.reset();
+    for (unsigned i = 0; i < backward.size(); i++) {
+      orders.push(backward[i]->order);
+    }
+    for (unsigned i = 0; i < forward.size(); i++) {
+      orders.push(forward[i]->order);
+    }
+    std::sort(orders.begin(), orders.end());
+
+    unsigned next = 0;
+    for (unsigned i = 0; i < backward.size(); i++) {
+      backward[i]->order = orders[next++];
+    }
+    for (unsigned i = 0; i < forward.size(); i++) {
+      forward[i]->order = orders[next++];
+    }
+
+    from->succ.push(to);
+    to->pred.push(from);
+    return true;
+  }
+
+  void AcyclicityIndex::orderBackEdges()
+  {
+    CALL("AcyclicityIndex::orderBackEdges");
+
+    if (!_backEdgesChanged) {
+      return;
+    }
+    _backEdgesChanged = false;
+
+    unsigned i = 0;
+    while (i < _backEdges.size()) {
+      IndexEntry* from = _backEdges[i].first;
+      IndexEntry* to = _backEdges[i].second;
+      if (orderEdge(from, to)) {
+        ALWAYS(from->backSucc.remove(to));
+        ALWAYS(to->backPred.remove(from));
+        std::swap(_backEdges[i], _backEdges.top());
+        _backEdges.pop();
+      } else {
+        i++;
+      }
+    }
+  }
+
+  /**
+   * Return true if @b e can reach itself in the graph. As every cycle of
+   * the graph contains a back edge, this is only searched for if there are any.
+   */
+  bool AcyclicityIndex::mayLieOnCycle(IndexEntry* e)
+  {
+    CALL("AcyclicityIndex::mayLieOnCycle");
+
+    orderBackEdges();
+    if (_backEdges.isEmpty()) {
+      return false;
+    }
+
+    static Stack<IndexEntry*> visited;
+    static Stack<IndexEntry*> toVisit;
+    visited.reset();
+    toVisit.reset();
+
+    bool res = false;
+    toVisit.push(e);
+    while (toVisit.isNonEmpty() && !res) {
+      IndexEntry* n = toVisit.pop();
+      for (unsigned i = 0; i < 2 && !res; i++) {
+        Stack<IndexEntry*>::Iterator it(i == 0 ? n->succ : n->backSucc);
+        while (it.hasNext()) {
+          IndexEntry* m = it.next();
+          if (m == e) {
+            res = true;
+            break;
+          }
+          if (!m->visited) {
+            m->visited = true;
+            visited.push(m);
+            toVisit.push(m);
+          }
+        }
+      }
+    }
+
+    Stack<IndexEntry*>::Iterator vit(visited);
+    while (vit.hasNext()) {
+      vit.next()->visited = false;
+    }
+    return res;
+  }
+
   CycleQueryResultsIterator AcyclicityIndex::queryCycles(Literal *lit, Clause *c)
   {
     CALL("AcyclicityIndex::queryCycle");
 
+    IndexEntry* entry = findEntry(lit, c);
+    if (!entry || !mayLieOnCycle(entry)) {
+      RSTAT_CTR_INC("acyclicity queries answered by the entry graph");
+      return CycleQueryResultsIterator::getEmpty();
+    }
     return pvi(CycleSearchIterator(lit, c, *this));
   }
 }
@@ -33,6 +33,7 @@
 
 #include "Lib/DHMap.hpp"
 #include "Lib/List.hpp"
+#include "Lib/Stack.hpp"
 #include "Lib/VirtualIterator.hpp"
 
 #include "Forwards.hpp"
@@ -61,16 +62,32 @@ struct CycleQueryResult {
 
 typedef Lib::VirtualIterator<CycleQueryResult*> CycleQueryResultsIterator;
 
+/**
+ * Index of the equalities t = f(...) between a term and a constructor term
+ * of an acyclic term algebra, for finding the cycles of such equalities.
+ *
+ * Besides the entries, the index keeps a graph on them with an edge from
+ * e1 to e2 if a subterm of the constructor term of e1 unifies with the term
+ * of e2, so that each cycle the search can find is a cycle of the graph.
+ * A topological order of the graph is maintained incrementally (using the
+ * algorithm of Pearce and Kelly), edges that would close a cycle are kept
+ * aside as back edges, and a query only searches for cycles if its entry
+ * lies on a cycle of the graph. In particular, queries cost nothing as long
+ * as the graph is acyclic.
+ */
 class AcyclicityIndex
 : public Index
 {
 public:
-  AcyclicityIndex(Indexing::TermIndexingStructure* tis) :
+  AcyclicityIndex(Indexing::TermIndexingStructure* tis, Indexing::TermIndexingStructure* subtermTis) :
     _sIndexes(),
-    _tis(tis)
+    _tis(tis),
+    _subtermTis(subtermTis),
+    _nextOrder(0),
+    _backEdgesChanged(false)
   {}
 
-  ~AcyclicityIndex() {}
+  ~AcyclicityIndex();
   
   void insert(Kernel::Literal *lit, Kernel::Clause *c);
   void remove(Kernel::Literal *lit, Kernel::Clause *c);
@@ -91,8 +108,23 @@ private:
   typedef pair<Kernel::Literal*, Kernel::Clause*> ULit;
   typedef Lib::DHMap<ULit, IndexEntry*> SIndex;
 
+  IndexEntry* findEntry(Kernel::Literal* lit, Kernel::Clause* c);
+  void addNode(IndexEntry* e);
+  void removeNode(IndexEntry* e);
+  void addEdge(IndexEntry* from, IndexEntry* to);
+  bool orderEdge(IndexEntry* from, IndexEntry* to);
+  void orderBackEdges();
+  bool mayLieOnCycle(IndexEntry* e);
+
   Lib::DHMap<unsigned, SIndex*> _sIndexes;
   Indexing::TermIndexingStructure* _tis;
+  /** the subterms of the constructor terms of the entries */
+  Indexing::TermIndexingStructure* _subtermTis;
+  /** the edges of the graph that are not consistent with the order */
+  Lib::Stack<pair<IndexEntry*, IndexEntry*> > _backEdges;
+  unsigned _nextOrder;
+  /** true if entries were removed since the last attempt to order the back edges */
+  bool _backEdgesChanged;
 };
 
 }
@@ -33,6 +33,7 @@
 #include "SAT/TWLSolver.hpp"
 #include "SAT/MinisatInterfacing.hpp"
 #include "SAT/BufferedSolver.hpp"
+#include "SAT/TraceRecordingSolver.hpp"
 
 #include "Saturation/SaturationAlgorithm.hpp"
 
@@ -51,13 +52,16 @@ GroundingIndex::GroundingIndex(const Options& opt)
     case Options::SatSolver::Z3:
       //cout << "Warning, Z3 not curently used for Global Subsumption" << endl; 
 #endif
+    // the simplifier does not pay off for the propagation-only calls made here
+    case Options::SatSolver::MINISAT_SIMP:
     case Options::SatSolver::MINISAT:
       _solver = new MinisatInterfacing(opt,true);
     	break;
     default:
       ASSERTION_VIOLATION_REP(opt.satSolver());
   }
-  
+  _solver = TraceRecordingSolver::wrapIfRequested(_solver.release(), opt);
+
   _grounder = new GlobalSubsumptionGrounder(_solver.ptr());
 }
 
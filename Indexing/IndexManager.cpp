@@ -200,7 +200,7 @@ Index* IndexManager::create(IndexType t)
 
   case ACYCLICITY_INDEX:
     tis = new TermSubstitutionTree();
-    res = new AcyclicityIndex(tis);
+    res = new AcyclicityIndex(tis, new TermSubstitutionTree());
     isGenerating = true;
     break;
 
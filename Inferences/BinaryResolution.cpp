@@ -34,17 +34,22 @@
 #include "Kernel/Unit.hpp"
 #include "Kernel/Inference.hpp"
 #include "Kernel/LiteralSelector.hpp"
+#include "Kernel/RobSubstitution.hpp"
 #include "Kernel/SortHelper.hpp"
 
 #include "Indexing/Index.hpp"
 #include "Indexing/LiteralIndex.hpp"
 #include "Indexing/IndexManager.hpp"
+#include "Indexing/ResultSubstitution.hpp"
 
+#include "Saturation/DeferredClauseContainer.hpp"
 #include "Saturation/SaturationAlgorithm.hpp"
 
 #include "Shell/Options.hpp"
 #include "Shell/Statistics.hpp"
 
+#include "WeightLimitCheck.hpp"
+
 #include "BinaryResolution.hpp"
 
 namespace Inferences
@@ -65,6 +70,12 @@ void BinaryResolution::attach(SaturationAlgorithm* salg)
 	  _salg->getIndexManager()->request(GENERATING_SUBST_TREE) );
 
   _unificationWithAbstraction = env.options->unificationWithAbstraction()!=Options::UnificationWithAbstraction::OFF;
+
+  // the constraints of unification with abstraction cannot be recomputed by plain unification
+  if(!_unificationWithAbstraction) {
+    _deferred = _salg->getDeferredClauseContainer();
+    _deferredWeight = getOptions().deferredClauseWeight();
+  }
 }
 
 void BinaryResolution::detach()
@@ -73,6 +84,7 @@ void BinaryResolution::detach()
   ASS(_salg);
 
   _index=0;
+  _deferred=0;
   _salg->getIndexManager()->release(GENERATING_SUBST_TREE);
   GeneratingInferenceEngine::detach();
 }
@@ -111,6 +123,9 @@ struct BinaryResolution::ResultFn
     SLQueryResult& qr = arg.second;
     Literal* resLit = arg.first;
 
+    if(_parent._deferred && _parent.tryDefer(_cl, resLit, qr)) {
+      return 0;
+    }
     return BinaryResolution::generateClause(_cl, resLit, qr, _parent.getOptions(), _passiveClauseContainer, _afterCheck ? _ord : 0, &_selector);
   }
 private:
@@ -122,6 +137,109 @@ private:
   BinaryResolution& _parent;
 };
 
+/**
+ * Recipe of a resolvent of two active clauses. The unifier of the
+ * resolved literals is recomputed when the resolvent is built.
+ */
+class BinaryResolution::Recipe
+: public ClauseRecipe
+{
+public:
+  CLASS_NAME(BinaryResolution::Recipe);
+  USE_ALLOCATOR(BinaryResolution::Recipe);
+
+  Recipe(BinaryResolution& parent, Clause* queryCl, Literal* queryLit, Clause* resultCl, Literal* resultLit,
+      unsigned weightLowerBound, unsigned age)
+  : ClauseRecipe(weightLowerBound, age), _parent(parent),
+    _queryCl(queryCl), _queryLit(queryLit), _resultCl(resultCl), _resultLit(resultLit)
+  {
+    _queryCl->incRefCnt();
+    _resultCl->incRefCnt();
+  }
+  ~Recipe()
+  {
+    _queryCl->decRefCnt();
+    _resultCl->decRefCnt();
+  }
+
+  Clause* materialise() override
+  {
+    CALL("BinaryResolution::Recipe::materialise");
+
+    // if a premise was simplified away, the resolvent is redundant
+    if(_queryCl->store()!=Clause::ACTIVE || _resultCl->store()!=Clause::ACTIVE || !_parent._salg) {
+      return 0;
+    }
+    TimeCounter tc(TC_RESOLUTION);
+
+    RobSubstitution subst;
+    ALWAYS(subst.unifyArgs(_queryLit, 0, _resultLit, 1));
+    SLQueryResult qr(_resultLit, _resultCl, ResultSubstitution::fromSubstitution(&subst, 0, 1));
+
+    SaturationAlgorithm* salg = _parent._salg;
+    bool afterCheck = _parent.getOptions().literalMaximalityAftercheck() && salg->getLiteralSelector().isBGComplete();
+    return BinaryResolution::generateClause(_queryCl, _queryLit, qr, _parent.getOptions(), salg->getPassiveClauseContainer(),
+        afterCheck ? &salg->getOrdering() : 0, &salg->getLiteralSelector());
+  }
+
+private:
+  BinaryResolution& _parent;
+  Clause* _queryCl;
+  Literal* _queryLit;
+  Clause* _resultCl;
+  Literal* _resultLit;
+};
+
+/**
+ * If the resolvent is heavy enough, put its recipe into the deferred clause
+ * container instead of building it and return true.
+ *
+ * The weight of the resolvent is bounded from below by the weights of the
+ * premise literals it consists of, as the unifier can only make them heavier.
+ */
+bool BinaryResolution::tryDefer(Clause* queryCl, Literal* queryLit, const SLQueryResult& qr)
+{
+  CALL("BinaryResolution::tryDefer");
+  ASS(_deferred);
+
+  if(!ColorHelper::compatible(queryCl->color(),qr.clause->color())) {
+    // leave it to generateClause to report the blocked inference
+    return false;
+  }
+
+  unsigned weight = 0;
+  unsigned clength = queryCl->length();
+  for(unsigned i=0;i<clength;i++) {
+    Literal* curr=(*queryCl)[i];
+    if(curr!=queryLit) {
+      weight+=curr->weight();
+    }
+  }
+  unsigned dlength = qr.clause->length();
+  for(unsigned i=0;i<dlength;i++) {
+    Literal* curr=(*qr.clause)[i];
+    if(curr!=qr.literal) {
+      weight+=curr->weight();
+    }
+  }
+  if(weight<_deferredWeight) {
+    return false;
+  }
+
+  const Options& opts = getOptions();
+  bool derivedFromGoal = queryCl->derivedFromGoal() || qr.clause->derivedFromGoal();
+  unsigned weightForClauseSelection = Clause::computeWeightForClauseSelection(weight, 0, 0, derivedFromGoal, opts);
+  if(derivedFromGoal && opts.restrictNWCtoGC()) {
+    // whether the resolvent counts as derived from the goal depends on its symbols
+    weightForClauseSelection = Int::min(weightForClauseSelection,
+        Clause::computeWeightForClauseSelection(weight, 0, 0, false, opts));
+  }
+  unsigned age = Int::max(queryCl->age(), qr.clause->age())+1;
+
+  _deferred->add(new Recipe(*this, queryCl, queryLit, qr.clause, qr.literal, weightForClauseSelection, age));
+  return true;
+}
+
 /**
  * Ordering aftercheck is performed iff ord is not 0,
  * in which case also ls is assumed to be not 0.
@@ -157,7 +275,6 @@ Clause* BinaryResolution::generateClause(Clause* queryCl, Literal* queryLit, SLQ
   // check whether we can conclude that the resulting clause will be discarded by LRS since it does not fulfil the age/weight limits (in which case we can discard the clause)
   // we already know the age here so we can immediately conclude whether the clause fulfils the age limit
   // since we have not built the clause yet we compute lower bounds on the weight of the clause after each step and recheck whether the weight-limit can still be fulfilled.
-  unsigned wlb=0;//weight lower bound
   unsigned numPositiveLiteralsLowerBound = // lower bound on number of positive literals, don't know at this point whether duplicate positive literals will occur
       Int::max(queryLit->isPositive() ? queryCl->numPositiveLiterals()-1 : queryCl->numPositiveLiterals(),
               qr.literal->isPositive() ? qr.clause->numPositiveLiterals()-1 : qr.clause->numPositiveLiterals());
@@ -166,31 +283,19 @@ Clause* BinaryResolution::generateClause(Clause* queryCl, Literal* queryLit, SLQ
       InferenceRule::CONSTRAINED_RESOLUTION:InferenceRule::RESOLUTION,queryCl, qr.clause));
   Inference::Destroyer inf_destroyer(inf); // will call destroy on inf when coming out of scope unless disabled
 
-  bool needsToFulfilWeightLimit = passiveClauseContainer && !passiveClauseContainer->fulfilsAgeLimit(wlb, numPositiveLiteralsLowerBound, inf) && passiveClauseContainer->weightLimited();
+  unsigned conlength = withConstraints ? constraints->size() : 0;
+  unsigned newLength = clength+dlength-2+conlength;
 
-  if(needsToFulfilWeightLimit) {
-    for(unsigned i=0;i<clength;i++) {
-      Literal* curr=(*queryCl)[i];
-      if(curr!=queryLit) {
-        wlb+=curr->weight();
-      }
-    }
-    for(unsigned i=0;i<dlength;i++) {
-      Literal* curr=(*qr.clause)[i];
-      if(curr!=qr.literal) {
-        wlb+=curr->weight();
-      }
-    }
-    if(!passiveClauseContainer->fulfilsWeightLimit(wlb, numPositiveLiteralsLowerBound, inf)) {
+  WeightLimitCheck weightCheck(passiveClauseContainer, numPositiveLiteralsLowerBound, inf);
+  if(weightCheck.enabled()) {
+    weightCheck.addPremise(queryCl, queryLit);
+    weightCheck.addPremise(qr.clause, qr.literal);
+    if(!weightCheck.checkBeforeConstruction(newLength)) {
       RSTAT_CTR_INC("binary resolutions skipped for weight limit before building clause");
-      env.statistics->discardedNonRedundantClauses++;
       return 0;
     }
   }
 
-  unsigned conlength = withConstraints ? constraints->size() : 0;
-  unsigned newLength = clength+dlength-2+conlength;
-
   inf_destroyer.disable(); // ownership passed to the the clause below
   Clause* res = new(newLength) Clause(newLength, inf); // the inference object owned by res from now on
 
@@ -247,11 +352,10 @@ Clause* BinaryResolution::generateClause(Clause* queryCl, Literal* queryLit, SLQ
     Literal* curr=(*queryCl)[i];
     if(curr!=queryLit) {
       Literal* newLit=qr.substitution->applyToQuery(curr);
-      if(needsToFulfilWeightLimit) {
-        wlb+=newLit->weight() - curr->weight();
-        if(!passiveClauseContainer->fulfilsWeightLimit(wlb, numPositiveLiteralsLowerBound, res->inference())) {
+      if(weightCheck.enabled()) {
+        weightCheck.add(newLit->weight() - curr->weight());
+        if(!weightCheck.check(newLength-next-1)) {
           RSTAT_CTR_INC("binary resolutions skipped for weight limit while building clause");
-          env.statistics->discardedNonRedundantClauses++;
           res->destroy();
           return 0;
         }
@@ -285,11 +389,10 @@ Clause* BinaryResolution::generateClause(Clause* queryCl, Literal* queryLit, SLQ
     Literal* curr=(*qr.clause)[i];
     if(curr!=qr.literal) {
       Literal* newLit = qr.substitution->applyToResult(curr);
-      if(needsToFulfilWeightLimit) {
-        wlb+=newLit->weight() - curr->weight();
-        if(!passiveClauseContainer->fulfilsWeightLimit(wlb, numPositiveLiteralsLowerBound, res->inference())) {
+      if(weightCheck.enabled()) {
+        weightCheck.add(newLit->weight() - curr->weight());
+        if(!weightCheck.check(newLength-next-1)) {
           RSTAT_CTR_INC("binary resolutions skipped for weight limit while building clause");
-          env.statistics->discardedNonRedundantClauses++;
           res->destroy();
           return 0;
         }
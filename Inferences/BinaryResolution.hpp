@@ -44,7 +44,7 @@ public:
   CLASS_NAME(BinaryResolution);
   USE_ALLOCATOR(BinaryResolution);
 
-  BinaryResolution() : _index(0), _unificationWithAbstraction(false) {}
+  BinaryResolution() : _index(0), _unificationWithAbstraction(false), _deferred(0), _deferredWeight(0) {}
 
   void attach(SaturationAlgorithm* salg);
   void detach();
@@ -55,9 +55,15 @@ public:
 private:
   struct UnificationsFn;
   struct ResultFn;
+  class Recipe;
+
+  bool tryDefer(Clause* queryCl, Literal* queryLit, const SLQueryResult& qr);
 
   GeneratingLiteralIndex* _index;
   bool _unificationWithAbstraction;
+  /** where to put the recipes of deferred resolvents, 0 if resolvents are not deferred */
+  DeferredClauseContainer* _deferred;
+  unsigned _deferredWeight;
 };
 
 };
@@ -41,6 +41,8 @@
 
 #include "Shell/Statistics.hpp"
 
+#include "WeightLimitCheck.hpp"
+
 #include "EqualityFactoring.hpp"
 
 #if VDEBUG
@@ -94,8 +96,8 @@ private:
 
 struct EqualityFactoring::ResultFn
 {
-  ResultFn(Clause* cl, bool afterCheck, Ordering& ordering)
-      : _cl(cl), _cLen(cl->length()), _afterCheck(afterCheck), _ordering(ordering) {}
+  ResultFn(Clause* cl, bool afterCheck, Ordering& ordering, PassiveClauseContainer* passive)
+      : _cl(cl), _cLen(cl->length()), _afterCheck(afterCheck), _ordering(ordering), _passive(passive) {}
   DECL_RETURN_TYPE(Clause*);
   Clause* operator() (pair<pair<Literal*,TermList>,pair<Literal*,TermList> > arg)
   {
@@ -133,7 +135,21 @@ struct EqualityFactoring::ResultFn
       return 0;
     }
 
-    Clause* res = new(_cLen) Clause(_cLen, GeneratingInference1(InferenceRule::EQUALITY_FACTORING, _cl));
+    Inference inf(GeneratingInference1(InferenceRule::EQUALITY_FACTORING, _cl));
+    Inference::Destroyer inf_destroyer(inf);
+
+    // the factored-out literal is positive and the new one negative
+    WeightLimitCheck weightCheck(_passive, _cl->numPositiveLiterals()-1, inf);
+    if(weightCheck.enabled()) {
+      weightCheck.addPremise(_cl, sLit);
+      weightCheck.add(1+sRHSS.weight()+fRHSS.weight());
+      if(!weightCheck.checkBeforeConstruction(_cLen)) {
+        return 0;
+      }
+    }
+
+    inf_destroyer.disable(); // ownership passed to the clause below
+    Clause* res = new(_cLen) Clause(_cLen, inf);
 
     (*res)[0]=Literal::createEquality(false, sRHSS, fRHSS, srt);
 
@@ -149,6 +165,14 @@ struct EqualityFactoring::ResultFn
       if(curr!=sLit) {
         Literal* currAfter = subst.apply(curr, 0);
 
+        if (weightCheck.enabled()) {
+          weightCheck.add(currAfter->weight() - curr->weight());
+          if (!weightCheck.check(_cLen-next-1)) {
+            res->destroy();
+            return 0;
+          }
+        }
+
         if (sLitAfter) {
           TimeCounter tc(TC_LITERAL_ORDER_AFTERCHECK);
           if (i < _cl->numSelected() && _ordering.compare(currAfter,sLitAfter) == Ordering::GREATER) {
@@ -172,6 +196,7 @@ private:
   unsigned _cLen;
   bool _afterCheck;
   Ordering& _ordering;
+  PassiveClauseContainer* _passive;
 };
 
 ClauseIterator EqualityFactoring::generateClauses(Clause* premise)
@@ -192,7 +217,8 @@ ClauseIterator EqualityFactoring::generateClauses(Clause* premise)
   auto it4 = getMapAndFlattenIterator(it3,FactorablePairsFn(premise));
 
   auto it5 = getMappingIterator(it4,ResultFn(premise,
-      getOptions().literalMaximalityAftercheck() && _salg->getLiteralSelector().isBGComplete(), _salg->getOrdering()));
+      getOptions().literalMaximalityAftercheck() && _salg->getLiteralSelector().isBGComplete(), _salg->getOrdering(),
+      _salg->getPassiveClauseContainer()));
 
   auto it6 = getFilteredIterator(it5,NonzeroFn());
 
@@ -39,6 +39,8 @@
 #include "Kernel/LiteralSelector.hpp"
 #include "Saturation/SaturationAlgorithm.hpp"
 
+#include "WeightLimitCheck.hpp"
+
 #include "EqualityResolution.hpp"
 
 #if VDEBUG
@@ -63,8 +65,8 @@ struct EqualityResolution::IsNegativeEqualityFn
 
 struct EqualityResolution::ResultFn
 {
-  ResultFn(Clause* cl, bool afterCheck = false, Ordering* ord = nullptr)
-      : _afterCheck(afterCheck), _ord(ord), _cl(cl), _cLen(cl->length()) {}
+  ResultFn(Clause* cl, bool afterCheck = false, Ordering* ord = nullptr, PassiveClauseContainer* passive = nullptr)
+      : _afterCheck(afterCheck), _ord(ord), _passive(passive), _cl(cl), _cLen(cl->length()) {}
   DECL_RETURN_TYPE(Clause*);
   Clause* operator() (Literal* lit)
   {
@@ -80,7 +82,20 @@ struct EqualityResolution::ResultFn
     }
     unsigned newLen=_cLen-1;
 
-    Clause* res = new(newLen) Clause(newLen, GeneratingInference1(InferenceRule::EQUALITY_RESOLUTION, _cl));
+    Inference inf(GeneratingInference1(InferenceRule::EQUALITY_RESOLUTION, _cl));
+    Inference::Destroyer inf_destroyer(inf);
+
+    // the resolved literal is negative, so all the positive ones remain
+    WeightLimitCheck weightCheck(_passive, _cl->numPositiveLiterals(), inf);
+    if(weightCheck.enabled()) {
+      weightCheck.addPremise(_cl, lit);
+      if(!weightCheck.checkBeforeConstruction(newLen)) {
+        return 0;
+      }
+    }
+
+    inf_destroyer.disable(); // ownership passed to the clause below
+    Clause* res = new(newLen) Clause(newLen, inf);
 
     Literal* litAfter = 0;
 
@@ -95,6 +110,14 @@ struct EqualityResolution::ResultFn
       if(curr!=lit) {
         Literal* currAfter = subst.apply(curr, 0);
 
+        if (weightCheck.enabled()) {
+          weightCheck.add(currAfter->weight() - curr->weight());
+          if (!weightCheck.check(newLen-next-1)) {
+            res->destroy();
+            return 0;
+          }
+        }
+
         if (litAfter) {
           TimeCounter tc(TC_LITERAL_ORDER_AFTERCHECK);
 
@@ -117,6 +140,7 @@ struct EqualityResolution::ResultFn
 private:
   bool _afterCheck;
   Ordering* _ord;
+  PassiveClauseContainer* _passive;
   Clause* _cl;
   unsigned _cLen;
 };
@@ -136,7 +160,7 @@ ClauseIterator EqualityResolution::generateClauses(Clause* premise)
 
   auto it3 = getMappingIterator(it2,ResultFn(premise,
       getOptions().literalMaximalityAftercheck() && _salg->getLiteralSelector().isBGComplete(),
-      &_salg->getOrdering()));
+      &_salg->getOrdering(), _salg->getPassiveClauseContainer()));
 
   auto it4 = getFilteredIterator(it3,NonzeroFn());
 
@@ -53,6 +53,8 @@
 #include "BinaryResolution.hpp"
 #include "EqualityResolution.hpp"
 
+#include "WeightLimitCheck.hpp"
+
 #include "HyperSuperposition.hpp"
 
 namespace Inferences
@@ -290,36 +292,57 @@ void HyperSuperposition::tryUnifyingSuperpositioins(Clause* cl, unsigned literal
     return;
   }
 
+  UnitList* premLst = 0;
+  UnitList::pushFromIterator(ClauseStack::Iterator(premises), premLst);
+  UnitList::push(cl, premLst);
+
+  Inference inf(GeneratingInferenceMany(InferenceRule::HYPER_SUPERPOSITION_GENERATING, premLst));
+  Inference::Destroyer inf_destroyer(inf);
+  // MS: keeping the original semantics (GeneratingInferenceMany would compute max over all parents+1)
+  inf.setAge(cl->age()+1);
+
+  unsigned clen = cl->length();
+  Literal* rwLit = (*cl)[literalIndex];
+
+  // the rewritten literal may get lighter, the other ones can only grow
+  WeightLimitCheck weightCheck(_salg->getPassiveClauseContainer(),
+      cl->numPositiveLiterals() - (rwLit->isPositive() ? 1 : 0), inf);
+  if(weightCheck.enabled()) {
+    weightCheck.addPremise(cl, rwLit);
+    if(!weightCheck.checkBeforeConstruction(clen)) {
+      return;
+    }
+  }
+
   static LiteralStack resLits;
   resLits.reset();
 
-  unsigned clen = cl->length();
   for(unsigned i=0; i<clen; i++) {
     Literal* lit0 = (*cl)[i];
+    Literal* resLit;
     if(i==literalIndex) {
       if(t1->isLiteral()) {
 	ASS_EQ(lit0, t1);
-	resLits.push(static_cast<Literal*>(t1Rwr));
+	resLit = static_cast<Literal*>(t1Rwr);
       }
       else {
 	Literal* lSubst = subst.apply(lit0, 0);
-	Literal* lRwr = EqHelper::replace(lSubst, TermList(t1Subst), TermList(t1Rwr));
-	resLits.push(lRwr);
+	resLit = EqHelper::replace(lSubst, TermList(t1Subst), TermList(t1Rwr));
       }
+      weightCheck.add(resLit->weight());
     }
     else {
-      Literal* lSubst = subst.apply(lit0, 0);
-      resLits.push(lSubst);
+      resLit = subst.apply(lit0, 0);
+      weightCheck.add(resLit->weight() - lit0->weight());
     }
+    if(weightCheck.enabled() && !weightCheck.checkBeforeConstruction(clen-i-1)) {
+      return;
+    }
+    resLits.push(resLit);
   }
 
-  UnitList* premLst = 0;
-  UnitList::pushFromIterator(ClauseStack::Iterator(premises), premLst);
-  UnitList::push(cl, premLst);
-
-  Clause* res = Clause::fromStack(resLits, GeneratingInferenceMany(InferenceRule::HYPER_SUPERPOSITION_GENERATING, premLst));
-  // MS: keeping the original semantics (GeneratingInferenceMany would compute max over all parents+1)
-  res->setAge(cl->age()+1);
+  inf_destroyer.disable(); // ownership passed to the clause below
+  Clause* res = Clause::fromStack(resLits, inf);
 
   RSTAT_CTR_INC("hyper-superposition");
 
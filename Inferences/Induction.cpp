@@ -109,10 +109,50 @@ ClauseIterator Induction::generateClauses(Clause* premise)
 {
   CALL("Induction::generateClauses");
 
-  return pvi(InductionClauseIterator(premise));
+  return pvi(InductionClauseIterator(premise, _cache));
 }
 
-InductionClauseIterator::InductionClauseIterator(Clause* premise)
+InductionSchemaCache::~InductionSchemaCache()
+{
+  CALL("InductionSchemaCache::~InductionSchemaCache");
+
+  DHMap<Key,Schema*>::Iterator it(_schemas);
+  while(it.hasNext()){
+    delete it.next();
+  }
+}
+
+InductionSchemaCache::Schema* InductionSchemaCache::find(Kind kind, unsigned depth, Literal* lit, Term* term)
+{
+  CALL("InductionSchemaCache::find");
+
+  Schema* res = 0;
+  _schemas.find(Key(make_pair(lit,term),make_pair(kind,depth)), res);
+  return res;
+}
+
+/**
+ * Store the clausified schema for @b lit and @b term. The clauses are kept
+ * alive by the cache, as the resolvents with them may be deleted.
+ */
+InductionSchemaCache::Schema* InductionSchemaCache::insert(Kind kind, unsigned depth, Literal* lit, Term* term,
+                                                           Stack<Clause*>& clauses, Literal* conclusion)
+{
+  CALL("InductionSchemaCache::insert");
+
+  Schema* res = new Schema();
+  res->clauses = clauses;
+  res->conclusion = conclusion;
+  Stack<Clause*>::Iterator cit(clauses);
+  while(cit.hasNext()){
+    cit.next()->incRefCnt();
+  }
+  ALWAYS(_schemas.insert(Key(make_pair(lit,term),make_pair(kind,depth)), res));
+  return res;
+}
+
+InductionClauseIterator::InductionClauseIterator(Clause* premise, InductionSchemaCache& cache)
+: _cache(cache)
 {
   CALL("InductionClauseIterator::InductionClauseIterator");
 
@@ -162,6 +202,12 @@ void InductionClauseIterator::process(Clause* premise, Literal* lit)
        lit->ground()
       ){
 
+      // all the candidates of a literal are tried the first time it is seen,
+      // so another occurrence of it can only lead to induction already done
+      if(!_cache.markProcessed(lit)){
+        return;
+      }
+
       Set<Term*> ta_terms;
       Set<Term*> int_terms;
       SubtermIterator it(lit);
@@ -254,6 +300,13 @@ void InductionClauseIterator::performMathInductionOne(Clause* premise, Literal*
 
   //cout << "PERFORM INDUCTION on " << env.signature->functionName(c) << endl;
 
+  unsigned prev_depth = premise->inference().inductionDepth();
+  InductionSchemaCache::Schema* schema = _cache.find(InductionSchemaCache::MATH_ONE, prev_depth, lit, term);
+  if(schema){
+    resolveWithSchema(premise,lit,schema,true);
+    return;
+  }
+
   TermList zero(theory->representConstant(IntegerConstantType(0)));
   TermList one(theory->representConstant(IntegerConstantType(1)));
   TermList mone(theory->representConstant(IntegerConstantType(-1)));
@@ -322,7 +375,6 @@ void InductionClauseIterator::performMathInductionOne(Clause* premise, Literal*
   NewCNF cnf(0);
   cnf.setForInduction();
   Stack<Clause*> hyp_clauses;
-  unsigned prev_depth = premise->inference().inductionDepth();
   Inference inf1 = TheoryAxiom(InferenceRule::INDUCTION_AXIOM);
   inf1.setInductionDepth(prev_depth+1);
   FormulaUnit* fu1 = new FormulaUnit(hyp1,inf1);
@@ -332,19 +384,8 @@ void InductionClauseIterator::performMathInductionOne(Clause* premise, Literal*
   cnf.clausify(NNF::ennf(fu1), hyp_clauses);
   cnf.clausify(NNF::ennf(fu2), hyp_clauses);
 
-  ScopedPtr<RobSubstitution> subst(new RobSubstitution());
-
-  // Now perform resolution between lit and the hyp_clauses on clit, which should be contained in each clause!
-  Stack<Clause*>::Iterator cit(hyp_clauses);
-  while(cit.hasNext()){
-    Clause* c = cit.next();
-    subst->unify(TermList(lit),0,TermList(Ly->literal()),1);
-    SLQueryResult qr(lit,premise,ResultSubstitution::fromSubstitution(subst.ptr(),1,0));
-    subst->reset();
-    Clause* r = BinaryResolution::generateClause(c,Ly->literal(),qr,*env.options);
-    _clauses.push(r);
-  }
-  env.statistics->induction++;
+  schema = _cache.insert(InductionSchemaCache::MATH_ONE, prev_depth, lit, term, hyp_clauses, Ly->literal());
+  resolveWithSchema(premise,lit,schema,true);
 }
 
 void InductionClauseIterator::performMathInductionTwo(Clause* premise, Literal* origLit, Literal* lit, Term* term) 
@@ -365,6 +406,12 @@ void InductionClauseIterator::performStructInductionOne(Clause* premise, Literal
 {
   CALL("InductionClauseIterator::performStructInductionOne"); 
 
+  InductionSchemaCache::Schema* schema = _cache.find(InductionSchemaCache::STRUCT_ONE, premise->inference().inductionDepth(), lit, term);
+  if(schema){
+    resolveWithSchema(premise,origLit,schema,false);
+    return;
+  }
+
   TermAlgebra* ta = env.signature->getTermAlgebraOfSort(env.signature->getFunction(term->functor())->fnType()->result());
   unsigned ta_sort = ta->sort();
 
@@ -450,16 +497,8 @@ void InductionClauseIterator::performStructInductionOne(Clause* premise, Literal
 
   //cout << "Clausify " << fu->toString() << endl;
 
-  // Now perform resolution between origLit and the hyp_clauses on conclusion, which should be contained in each clause!
-  Stack<Clause*>::Iterator cit(hyp_clauses);
-  while(cit.hasNext()){
-    Clause* c = cit.next();
-    static ResultSubstitutionSP identity = ResultSubstitutionSP(new IdentitySubstitution());
-    SLQueryResult qr(origLit,premise,identity);
-    Clause* r = BinaryResolution::generateClause(c,conclusion,qr,*env.options);
-    _clauses.push(r);
-  }
-  env.statistics->induction++;
+  schema = _cache.insert(InductionSchemaCache::STRUCT_ONE, premise->inference().inductionDepth(), lit, term, hyp_clauses, conclusion);
+  resolveWithSchema(premise,origLit,schema,false);
 }
 
 /**
@@ -471,6 +510,12 @@ void InductionClauseIterator::performStructInductionTwo(Clause* premise, Literal
 {
   //cout << "TWO " << premise->toString() << endl;
 
+  InductionSchemaCache::Schema* schema = _cache.find(InductionSchemaCache::STRUCT_TWO, premise->inference().inductionDepth(), lit, term);
+  if(schema){
+    resolveWithSchema(premise,origLit,schema,false);
+    return;
+  }
+
   TermAlgebra* ta = env.signature->getTermAlgebraOfSort(env.signature->getFunction(term->functor())->fnType()->result());
   unsigned ta_sort = ta->sort();
 
@@ -558,16 +603,8 @@ void InductionClauseIterator::performStructInductionTwo(Clause* premise, Literal
 
   //cout << "Clausify " << fu->toString() << endl;
 
-  // Now perform resolution between origLit and the hyp_clauses on conclusion, which should be contained in each clause!
-  Stack<Clause*>::Iterator cit(hyp_clauses);
-  while(cit.hasNext()){
-    Clause* c = cit.next();
-    static ResultSubstitutionSP identity = ResultSubstitutionSP(new IdentitySubstitution());
-    SLQueryResult qr(origLit,premise,identity);
-    Clause* r = BinaryResolution::generateClause(c,conclusion,qr,*env.options);
-    _clauses.push(r);
-  }
-  env.statistics->induction++;  
+  schema = _cache.insert(InductionSchemaCache::STRUCT_TWO, premise->inference().inductionDepth(), lit, term, hyp_clauses, conclusion);
+  resolveWithSchema(premise,origLit,schema,false);
 
 }
 
@@ -585,6 +622,12 @@ void InductionClauseIterator::performStructInductionThree(Clause* premise, Liter
 {
   CALL("InductionClauseIterator::performStructInductionThree");
 
+  InductionSchemaCache::Schema* schema = _cache.find(InductionSchemaCache::STRUCT_THREE, premise->inference().inductionDepth(), lit, term);
+  if(schema){
+    resolveWithSchema(premise,origLit,schema,false);
+    return;
+  }
+
 
   TermAlgebra* ta = env.signature->getTermAlgebraOfSort(env.signature->getFunction(term->functor())->fnType()->result());
   unsigned ta_sort = ta->sort();
@@ -704,16 +747,40 @@ void InductionClauseIterator::performStructInductionThree(Clause* premise, Liter
 
   //cout << "Clausify " << fu->toString() << endl;
 
-  // Now perform resolution between origLit and the hyp_clauses on conclusion, which should be contained in each clause!
-  Stack<Clause*>::Iterator cit(hyp_clauses);
+  schema = _cache.insert(InductionSchemaCache::STRUCT_THREE, premise->inference().inductionDepth(), lit, term, hyp_clauses, conclusion);
+  resolveWithSchema(premise,origLit,schema,false);
+}
+
+/**
+ * Resolve the premise with each clause of the induction schema on its conclusion.
+ * Mathematical induction resolves @b lit unified with the conclusion, structural
+ * induction resolves it as it is.
+ */
+void InductionClauseIterator::resolveWithSchema(Clause* premise, Literal* lit, InductionSchemaCache::Schema* schema, bool unify)
+{
+  CALL("InductionClauseIterator::resolveWithSchema");
+
+  static ResultSubstitutionSP identity = ResultSubstitutionSP(new IdentitySubstitution());
+  ScopedPtr<RobSubstitution> subst(unify ? new RobSubstitution() : 0);
+
+  Stack<Clause*>::Iterator cit(schema->clauses);
   while(cit.hasNext()){
     Clause* c = cit.next();
-    static ResultSubstitutionSP identity = ResultSubstitutionSP(new IdentitySubstitution());
-    SLQueryResult qr(origLit,premise,identity);
-    Clause* r = BinaryResolution::generateClause(c,conclusion,qr,*env.options);
-    _clauses.push(r);
+    ResultSubstitutionSP rsubst = identity;
+    if(unify){
+      subst->unify(TermList(lit),0,TermList(schema->conclusion),1);
+      rsubst = ResultSubstitution::fromSubstitution(subst.ptr(),1,0);
+    }
+    SLQueryResult qr(lit,premise,rsubst);
+    Clause* r = BinaryResolution::generateClause(c,schema->conclusion,qr,*env.options);
+    if(unify){
+      subst->reset();
+    }
+    if(r){
+      _clauses.push(r);
+    }
   }
-  env.statistics->induction++; 
+  env.statistics->induction++;
 }
 
 bool InductionClauseIterator::notDone(Literal* lit, Term* term)
@@ -28,6 +28,10 @@
 
 #include "Forwards.hpp"
 
+#include "Lib/DHMap.hpp"
+#include "Lib/DHSet.hpp"
+#include "Lib/Stack.hpp"
+
 #include "Kernel/TermTransformer.hpp"
 
 #include "InferenceEngine.hpp"
@@ -75,6 +79,49 @@ private:
   TermList _r;
 };
 
+/**
+ * Induction state that persists between premises: the clausified
+ * induction schemas, shared by all premises with the same induction
+ * literal and induction term, and the literals whose induction
+ * candidates were all tried already.
+ */
+class InductionSchemaCache
+{
+public:
+  CLASS_NAME(InductionSchemaCache);
+  USE_ALLOCATOR(InductionSchemaCache);
+
+  enum Kind {
+    MATH_ONE,
+    STRUCT_ONE,
+    STRUCT_TWO,
+    STRUCT_THREE
+  };
+
+  struct Schema {
+    CLASS_NAME(InductionSchemaCache::Schema);
+    USE_ALLOCATOR(InductionSchemaCache::Schema);
+
+    Stack<Clause*> clauses;
+    /** the literal of each of @b clauses that is resolved against the premise */
+    Literal* conclusion;
+  };
+
+  ~InductionSchemaCache();
+
+  Schema* find(Kind kind, unsigned depth, Literal* lit, Term* term);
+  Schema* insert(Kind kind, unsigned depth, Literal* lit, Term* term, Stack<Clause*>& clauses, Literal* conclusion);
+
+  /** Return true if @b lit was not processed before, and remember it */
+  bool markProcessed(Literal* lit) { return _processed.insert(lit); }
+
+private:
+  typedef pair<pair<Literal*,Term*>,pair<unsigned,unsigned> > Key;
+
+  DHMap<Key,Schema*> _schemas;
+  DHSet<Literal*> _processed;
+};
+
 class Induction
 : public GeneratingInferenceEngine
 {
@@ -85,13 +132,15 @@ public:
   Induction() {}
   ClauseIterator generateClauses(Clause* premise);
 
+private:
+  InductionSchemaCache _cache;
 };
 
 class InductionClauseIterator
 {
 public:
   // all the work happens in the constructor!
-  InductionClauseIterator(Clause* premise);
+  InductionClauseIterator(Clause* premise, InductionSchemaCache& cache);
 
   CLASS_NAME(InductionClauseIterator);
   USE_ALLOCATOR(InductionClauseIterator);
@@ -118,10 +167,13 @@ private:
   void performStructInductionTwo(Clause* premise, Literal* origLit, Literal* lit, Term* t);
   void performStructInductionThree(Clause* premise, Literal* origLit, Literal* lit, Term* t);
 
+  void resolveWithSchema(Clause* premise, Literal* lit, InductionSchemaCache::Schema* schema, bool unify);
+
   bool notDone(Literal* lit, Term* t);
   Term* getPlaceholderForTerm(Term* t);
 
   Stack<Clause*> _clauses;
+  InductionSchemaCache& _cache;
 };
 
 };
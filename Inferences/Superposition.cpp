@@ -437,6 +437,8 @@ Clause* Superposition::performSuperposition(
   bool needsToFulfilWeightLimit = passiveClauseContainer && !passiveClauseContainer->fulfilsAgeLimit(0, numPositiveLiteralsLowerBound, inf) && passiveClauseContainer->weightLimited(); // 0 here denotes the current weight estimate
   if(needsToFulfilWeightLimit) {
     if(!earlyWeightLimitCheck(eqClause, eqLit, rwClause, rwLit, rwTerm, eqLHS, tgtTerm, subst, eqIsResult, passiveClauseContainer, numPositiveLiteralsLowerBound, inf)) {
+      env.statistics->discardedBeforeConstruction++;
+      env.statistics->literalsNotInstantiated += rwLength+eqLength-1;
       return 0;
     }
   }
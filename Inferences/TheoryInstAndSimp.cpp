@@ -21,8 +21,6 @@
  * Implements class TheoryInstAndSimp.
  */
 
-#if VZ3
-
 #define DPRINT 0
 
 #include "Debug/RuntimeStatistics.hpp"
@@ -34,6 +32,7 @@
 #include "Kernel/Clause.hpp"
 #include "Kernel/Unit.hpp"
 #include "Kernel/Inference.hpp"
+#include "Kernel/InterpretedLiteralEvaluator.hpp"
 #include "Kernel/Signature.hpp"
 #include "Kernel/Term.hpp"
 #include "Kernel/Substitution.hpp"
@@ -53,6 +52,8 @@
 #include "SAT/SAT2FO.hpp"
 #include "SAT/Z3Interfacing.hpp"
 
+#include "DP/LinearArithmeticDP.hpp"
+
 #include "TheoryInstAndSimp.hpp"
 
 
@@ -64,6 +65,7 @@ using namespace Kernel;
 using namespace Shell;
 using namespace Saturation;
 using namespace SAT;
+using namespace DP;
 
 
 void TheoryInstAndSimp::attach(SaturationAlgorithm* salg)
@@ -614,28 +616,200 @@ Term* getFreshConstant(unsigned index, unsigned srt)
   return (*sortedConstants)[index];
 }
 
-VirtualIterator<Solution> TheoryInstAndSimp::getSolutions(Stack<Literal*>& theoryLiterals, bool guarded){
-  CALL("TheoryInstAndSimp::getSolutions");
+/**
+ * The solver the theory parts of clauses are checked with. It is created once
+ * and each query is enclosed in push() and pop(), so that the solver keeps
+ * the literals it has already translated instead of being rebuilt for every
+ * clause. Without Z3, ground linear arithmetic is decided by LinearArithmeticDP
+ * and its models are checked by evaluation before they are used.
+ */
+class TheoryInstAndSimp::SolverContext
+{
+public:
+  CLASS_NAME(TheoryInstAndSimp::SolverContext);
+  USE_ALLOCATOR(SolverContext);
 
-  BYPASSING_ALLOCATOR;
+#if VZ3
+  SolverContext() : _solver(*env.options,_naming) {}
 
-  // Currently we just get the single solution from Z3
+  void push() { _solver.push(); }
+  void pop() { _solver.pop(); }
 
-  // We use a new SMT solver
-  // currently these are not needed outside of this function so we put them here
-  static SAT2FO naming;
-  static Z3Interfacing solver(*env.options,naming);
-  solver.reset(); // the solver will reset naming
+  /** Assert @b lit, return false if the solver cannot handle it */
+  bool addLiteral(Literal* lit, bool guarded)
+  {
+    CALL("TheoryInstAndSimp::SolverContext::addLiteral");
+    BYPASSING_ALLOCATOR;
 
+    // the naming is kept between the queries, so each literal is registered once
+    SATLiteral slit = _naming.toSAT(lit);
+
+    static SATLiteralStack satLits;
+    satLits.reset();
+    satLits.push(slit);
+    SATClause* sc = SATClause::fromStack(satLits);
+    // guarded is normally true, apart from when we are checking a theory tautology
+    try{
+      _solver.addClause(sc,guarded);
+    }
+    catch(UninterpretedForZ3Exception){
+      return false;
+    }
+    return true;
+  }
+
+  SATSolver::Status solve()
+  {
+    BYPASSING_ALLOCATOR;
+    return _solver.solve(UINT_MAX);
+  }
+
+  /** Return the value of @b t in the last model, or 0 if it cannot be represented */
+  Term* evaluate(Term* t)
+  {
+    BYPASSING_ALLOCATOR;
+    return _solver.evaluateInModel(t);
+  }
+
+  /** Models of Z3 are trusted */
+  bool checkSolution(Literal* lit) { return true; }
+
+private:
+  SAT2FO _naming;
+  Z3Interfacing _solver;
+#else
+  void push() { _dp.pushLevel(); }
+  void pop() { _dp.popLevels(1); }
+
+  bool addLiteral(Literal* lit, bool guarded)
+  {
+    CALL("TheoryInstAndSimp::SolverContext::addLiteral");
+
+    // quotients by non-numerals are read as uninterpreted terms, so the guards are not needed
+    if(!LinearArithmeticDP::isLinearConstraint(lit)){
+      return false;
+    }
+    _dp.addLiterals(pvi( getSingletonIterator(lit) ), false);
+    return true;
+  }
+
+  SATSolver::Status solve()
+  {
+    CALL("TheoryInstAndSimp::SolverContext::solve");
+
+    _model.reset();
+    if(_dp.getStatus(false)==DecisionProcedure::UNSATISFIABLE){
+      return SATSolver::UNSATISFIABLE;
+    }
+    // the relaxation of an integer problem may still have an integer model
+    static LiteralStack model;
+    model.reset();
+    _dp.getModel(model);
+    LiteralStack::Iterator mit(model);
+    while(mit.hasNext()){
+      Literal* eq = mit.next();
+      Term* t = eq->nthArgument(0)->term();
+      Term* val = eq->nthArgument(1)->term();
+      // sharing may have swapped the arguments of the equality
+      if(theory->isInterpretedNumber(t)){
+        swap(t,val);
+      }
+      _model.insert(t,val);
+    }
+    return SATSolver::SATISFIABLE;
+  }
+
+  Term* evaluate(Term* t)
+  {
+    Term* res = 0;
+    _model.find(t,res);
+    return res;
+  }
+
+  /**
+   * Non-linear terms get values independent of their arguments, so each
+   * instantiated literal is evaluated to make sure it holds.
+   */
+  bool checkSolution(Literal* lit)
+  {
+    CALL("TheoryInstAndSimp::SolverContext::checkSolution");
+
+    bool isConstant;
+    bool constantTrue;
+    Literal* res;
+    static Stack<Literal*> sideConditions;
+    sideConditions.reset();
+    return _evaluator.evaluate(lit,isConstant,res,constantTrue,sideConditions) &&
+      isConstant && constantTrue && sideConditions.isEmpty();
+  }
+
+private:
+  LinearArithmeticDP _dp;
+  DHMap<Term*,Term*> _model;
+  InterpretedLiteralEvaluator _evaluator;
+#endif
+};
+
+/**
+ * A candidate clause waiting for the rest of its batch
+ */
+struct TheoryInstAndSimp::PendingQuery
+{
+  CLASS_NAME(TheoryInstAndSimp::PendingQuery);
+  USE_ALLOCATOR(PendingQuery);
+
+  PendingQuery(Clause* premise, Clause* flattened, Stack<Literal*>& theoryLits)
+   : premise(premise), flattened(flattened), theoryLits(theoryLits)
+  {
+    premise->incRefCnt();
+    flattened->incRefCnt();
+  }
+  ~PendingQuery()
+  {
+    premise->decRefCnt();
+    flattened->decRefCnt();
+  }
+
+  Clause* premise;
+  Clause* flattened;
+  Stack<Literal*> theoryLits;
+  Substitution subst;
+  Stack<unsigned> vars;
+};
+
+TheoryInstAndSimp::TheoryInstAndSimp()
+ : _splitter(0), _solver(new SolverContext()),
+   _batchSize(env.options->theoryInstAndSimpBatch())
+{
+}
+
+TheoryInstAndSimp::~TheoryInstAndSimp()
+{
+  CALL("TheoryInstAndSimp::~TheoryInstAndSimp");
+
+  while(_pending.isNonEmpty()){
+    delete _pending.pop();
+  }
+  while(_redundant.isNonEmpty()){
+    _redundant.pop()->decRefCnt();
+  }
+}
+
+/**
+ * Skolemize the complements of @b theoryLiterals with fresh constants from
+ * index @b used on and assert them in the solver. The variables are bound
+ * in @b subst and collected in @b vars. Return false if the solver cannot
+ * handle some of the literals.
+ */
+bool TheoryInstAndSimp::addQuery(Stack<Literal*>& theoryLiterals, bool guarded, unsigned& used,
+    Substitution& subst, Stack<unsigned>& vars)
+{
+  CALL("TheoryInstAndSimp::addQuery");
 
   // Firstly, we need to consistently replace variables by constants (i.e. Skolemize)
   // Secondly, we take the complement of each literal and consider the conjunction
   // This subst is for the consistent replacement
-  Substitution subst;
-
   Stack<Literal*>::Iterator it(theoryLiterals);
-  Stack<unsigned> vars;
-  unsigned used = 0;
   while(it.hasNext()){
     // get the complementary of the literal
     Literal* lit = Literal::complementaryLiteral(it.next());
@@ -666,66 +840,81 @@ VirtualIterator<Solution> TheoryInstAndSimp::getSolutions(Stack<Literal*>& theor
     cout << " to get " << lit->toString() << endl;
 #endif
 
-    // register the lit in naming in such a way that the solver will pick it up!
-    SATLiteral slit = naming.toSAT(lit);
+    if(!_solver->addLiteral(lit,guarded)){
+      return false;
+    }
+  }
+  return true;
+}
 
-    // now add the SAT representation
-    static SATLiteralStack satLits;
-    satLits.reset();
-    satLits.push(slit);
-    SATClause* sc = SATClause::fromStack(satLits);
-    //clause->setInference(new FOConversionInference(cl));
-    // guarded is normally true, apart from when we are checking a theory tautology
-    try{
-      solver.addClause(sc,guarded);
+/**
+ * Bind @b vars in @b sol to the values the last model gives to the fresh
+ * constants @b subst replaced them with. Return false if some value
+ * is not available.
+ */
+bool TheoryInstAndSimp::readSolution(Stack<Literal*>& theoryLiterals, Substitution& subst,
+    Stack<unsigned>& vars, Solution& sol)
+{
+  CALL("TheoryInstAndSimp::readSolution");
+
+  Stack<unsigned>::Iterator vit(vars);
+  while(vit.hasNext()){
+    unsigned v = vit.next();
+    Term* t = subst.apply(v).term();
+    ASS(t);
+    t = _solver->evaluate(t);
+    // If we could evaluate the term in the model then bind it
+    if(t){
+      sol.subst.bind(v,t);
+    } else {
+      // Failed to obtain a value; could be an algebraic number or some other currently unhandled beast...
+      env.statistics->theoryInstSimpLostSolution++;
+      return false;
     }
-    catch(UninterpretedForZ3Exception){
-      return VirtualIterator<Solution>::getEmpty();
+  }
+  Stack<Literal*>::Iterator it(theoryLiterals);
+  while(it.hasNext()){
+    Literal* lit = Literal::complementaryLiteral(it.next());
+    if(!_solver->checkSolution(SubstHelper::apply(lit,sol.subst))){
+      env.statistics->theoryInstSimpLostSolution++;
+      return false;
     }
   }
+#if DPRINT
+  cout << "solution with " << sol.subst.toString() << endl;
+#endif
+  return true;
+}
 
-  // now we can call the solver
-  SATSolver::Status status = solver.solve(UINT_MAX);
+VirtualIterator<Solution> TheoryInstAndSimp::getSolutions(Stack<Literal*>& theoryLiterals, bool guarded){
+  CALL("TheoryInstAndSimp::getSolutions");
+
+  // Currently we just get the single solution from the solver
+  Substitution subst;
+  Stack<unsigned> vars;
+  unsigned used = 0;
 
-  if(status == SATSolver::UNSATISFIABLE){
+  VirtualIterator<Solution> res = VirtualIterator<Solution>::getEmpty();
+  _solver->push();
+  if(addQuery(theoryLiterals,guarded,used,subst,vars)){
+    // now we can call the solver
+    SATSolver::Status status = _solver->solve();
+
+    if(status == SATSolver::UNSATISFIABLE){
 #if DPRINT
-    cout << "z3 says unsat" << endl;
+      cout << "solver says unsat" << endl;
 #endif
-    return pvi(getSingletonIterator(Solution(false)));
-  }
-  else if(status == SATSolver::SATISFIABLE){
-    Solution sol = Solution(true);
-    Stack<unsigned>::Iterator vit(vars);
-    while(vit.hasNext()){
-      unsigned v = vit.next();
-      Term* t = subst.apply(v).term();
-      ASS(t);
-      //cout << v << ": " << t->toString() << endl;
-      t = solver.evaluateInModel(t);
-      // If we could evaluate the term in the model then bind it
-      if(t){
-        //cout << "evaluate to " << t->toString() << endl;
-        sol.subst.bind(v,t);
-      } else {
-        // Failed to obtain a value; could be an algebraic number or some other currently unhandled beast...
-        env.statistics->theoryInstSimpLostSolution++;
-        goto fail;
+      res = pvi(getSingletonIterator(Solution(false)));
+    }
+    else if(status == SATSolver::SATISFIABLE){
+      Solution sol = Solution(true);
+      if(readSolution(theoryLiterals,subst,vars,sol)){
+        res = pvi(getSingletonIterator(sol));
       }
     }
-#if DPRINT
-    cout << "solution with " << sol.subst.toString() << endl;
-#endif
-    return pvi(getSingletonIterator(sol));
   }
-
-  fail:
-#if DRPINT
-    cout << "no solution" << endl;
-#endif
-
-  // SMT solving was incomplete
-  return VirtualIterator<Solution>::getEmpty();
-
+  _solver->pop();
+  return res;
 }
 
 
@@ -900,6 +1089,19 @@ ClauseIterator TheoryInstAndSimp::generateClauses(Clause* premise,bool& premiseR
     selectedLiterals.loadFromIterator(Stack<Literal*>::Iterator(theoryLiterals));
   }
 
+  if(_batchSize>1){
+    TimeCounter t(TC_THEORY_INST_SIMP);
+
+    _pending.push(new PendingQuery(premise,flattened,selectedLiterals));
+    if(_pending.size()<_batchSize){
+      return ClauseIterator::getEmpty();
+    }
+    static ClauseStack instances;
+    instances.reset();
+    solveBatch(premise,premiseRedundant,instances);
+    return pvi(getPersistentIterator(ClauseStack::Iterator(instances)));
+  }
+
   {
     TimeCounter t(TC_THEORY_INST_SIMP);
 
@@ -919,6 +1121,113 @@ ClauseIterator TheoryInstAndSimp::generateClauses(Clause* premise,bool& premiseR
   }
 }
 
+/**
+ * Solve the pending clauses of an incomplete batch and add the instances
+ * to @b res, and remove the recorded theory tautologies. Called when the
+ * saturation would otherwise end, so that the instances of the last clauses
+ * activated are not lost, and no clause is being activated.
+ */
+void TheoryInstAndSimp::flushPending(ClauseStack& res)
+{
+  CALL("TheoryInstAndSimp::flushPending");
+
+  if(_pending.isNonEmpty()){
+    TimeCounter t(TC_THEORY_INST_SIMP);
+
+    bool premiseRedundant = false;
+    solveBatch(0,premiseRedundant,res);
+    ASS(!premiseRedundant);
+  }
+
+  while(_redundant.isNonEmpty()){
+    Clause* cl = _redundant.pop();
+    if(cl->store()==Clause::ACTIVE || cl->store()==Clause::PASSIVE){
+      _salg->removeActiveOrPassiveClause(cl);
+    }
+    cl->decRefCnt();
+  }
 }
 
-#endif
+/**
+ * Solve the theory parts of the pending clauses in one query and add the
+ * instances to @b res. The parts share no fresh constants, so the query is
+ * satisfiable iff each of them is, and then one model answers all of them.
+ * Otherwise, which is rare as it means some clause is a theory tautology,
+ * the parts are solved one by one.
+ *
+ * @b premise is the clause being activated (or 0 when flushing). The other
+ * pending clauses that turn out to be theory tautologies are only recorded,
+ * as the saturation may be in the middle of activating @b premise, and they
+ * are removed from the active set by flushPending.
+ */
+void TheoryInstAndSimp::solveBatch(Clause* premise, bool& premiseRedundant, ClauseStack& res)
+{
+  CALL("TheoryInstAndSimp::solveBatch");
+
+  // the clauses that left the active set while waiting are not solved
+  static Stack<PendingQuery*> queries;
+  queries.reset();
+  while(_pending.isNonEmpty()){
+    PendingQuery* q = _pending.pop();
+    if(q->premise==premise || q->premise->store()==Clause::ACTIVE){
+      queries.push(q);
+    }
+    else {
+      delete q;
+    }
+  }
+
+  _solver->push();
+  bool jointSat = true;
+  unsigned used = 0;
+  Stack<PendingQuery*>::Iterator qit(queries);
+  while(qit.hasNext()){
+    PendingQuery* q = qit.next();
+    if(!addQuery(q->theoryLits,true,used,q->subst,q->vars)){
+      jointSat = false;
+      break;
+    }
+  }
+  jointSat = jointSat && _solver->solve()==SATSolver::SATISFIABLE;
+  if(jointSat){
+    Stack<PendingQuery*>::Iterator sit(queries);
+    while(sit.hasNext()){
+      PendingQuery* q = sit.next();
+      Solution sol(true);
+      if(readSolution(q->theoryLits,q->subst,q->vars,sol)){
+        bool red = false;
+        Clause* inst = InstanceFn(q->premise,q->flattened,q->theoryLits,_splitter,_salg,this,red)(sol);
+        if(inst){
+          res.push(inst);
+        }
+      }
+    }
+  }
+  _solver->pop();
+
+  while(queries.isNonEmpty()){
+    PendingQuery* q = queries.pop();
+    if(!jointSat){
+      bool red = false;
+      VirtualIterator<Solution> sols = getSolutions(q->theoryLits);
+      while(sols.hasNext()){
+        Clause* inst = InstanceFn(q->premise,q->flattened,q->theoryLits,_splitter,_salg,this,red)(sols.next());
+        if(inst){
+          res.push(inst);
+        }
+      }
+      if(red){
+        if(q->premise==premise){
+          premiseRedundant = true;
+        }
+        else {
+          q->premise->incRefCnt();
+          _redundant.push(q->premise);
+        }
+      }
+    }
+    delete q;
+  }
+}
+
+}
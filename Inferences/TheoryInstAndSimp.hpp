@@ -25,10 +25,12 @@
 #ifndef __TheoryInstAndSimp__
 #define __TheoryInstAndSimp__
 
-#if VZ3
-
 #include "Forwards.hpp"
 #include "InferenceEngine.hpp"
+
+#include "Lib/ScopedPtr.hpp"
+#include "Lib/Stack.hpp"
+
 #include "Kernel/Substitution.hpp"
 
 namespace Inferences
@@ -51,7 +53,8 @@ public:
   CLASS_NAME(TheoryInstAndSimp);
   USE_ALLOCATOR(TheoryInstAndSimp);
 
-  TheoryInstAndSimp() : _splitter(0) {}
+  TheoryInstAndSimp();
+  ~TheoryInstAndSimp();
   void attach(SaturationAlgorithm* salg);
 
   ClauseIterator generateClauses(Clause* premise, bool& premiseRedundant);
@@ -62,7 +65,16 @@ public:
 
   VirtualIterator<Solution> getSolutions(Stack<Literal*>& theoryLiterals,bool guarded=true);
 
+  void flushPending(ClauseStack& res);
+
 private:
+  class SolverContext;
+  struct PendingQuery;
+
+  bool addQuery(Stack<Literal*>& theoryLiterals, bool guarded, unsigned& used,
+      Substitution& subst, Stack<unsigned>& vars);
+  bool readSolution(Stack<Literal*>& theoryLiterals, Substitution& subst, Stack<unsigned>& vars, Solution& sol);
+  void solveBatch(Clause* premise, bool& premiseRedundant, ClauseStack& res);
 
   void selectTheoryLiterals(Clause* cl, Stack<Literal*>& theoryLits);
 
@@ -101,13 +113,18 @@ private:
   bool literalContainsVar(const Literal* lit, unsigned v);
 
   Splitter* _splitter;
-  //SAT2F0 _naming;
-  //Z3Interfacing* _solver;
 
-};
+  /** The solver context shared by all the queries */
+  ScopedPtr<SolverContext> _solver;
 
+  /** Number of candidate clauses solved together, 1 means no batching */
+  unsigned _batchSize;
+  /** Candidate clauses waiting for the batch to fill up */
+  Stack<PendingQuery*> _pending;
+  /** Other premises of solved batches found to be theory tautologies, removed by flushPending */
+  Stack<Clause*> _redundant;
 };
 
-#endif
+};
 
 #endif /*__TheoryInstAndSimp__*/
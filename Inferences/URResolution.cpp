@@ -43,6 +43,8 @@
 #include "Shell/Options.hpp"
 #include "Shell/Statistics.hpp"
 
+#include "WeightLimitCheck.hpp"
+
 #include "URResolution.hpp"
 
 namespace Inferences
@@ -159,6 +161,7 @@ struct URResolution::Item
     _atMostOneNonGround = nonGroundCnt<=1;
   }
 
+  /** Return the conclusion, or 0 if it would be discarded by the LRS weight limit */
   Clause* generateClause() const
   {
     CALL("URResolution::Item::generateClause");
@@ -180,6 +183,21 @@ struct URResolution::Item
       }
     }
     Inference inf(GeneratingInferenceMany(InferenceRule::UNIT_RESULTING_RESOLUTION, premLst));
+    Inference::Destroyer inf_destroyer(inf);
+
+    if(single) {
+      // renaming doesn't change the weight, so the weight of the conclusion is known exactly
+      PassiveClauseContainer* passive = _parent._salg ? _parent._salg->getPassiveClauseContainer() : 0;
+      WeightLimitCheck weightCheck(passive, single->isPositive() ? 1 : 0, inf);
+      if(weightCheck.enabled()) {
+        weightCheck.add(single->weight());
+        if(!weightCheck.checkBeforeConstruction(1)) {
+          return 0;
+        }
+      }
+    }
+
+    inf_destroyer.disable(); // ownership passed to the clause below
     Clause* res;
     if(single) {
       single = Renaming::normalize(single);
@@ -328,8 +346,11 @@ void URResolution::processAndGetClauses(Item* itm, unsigned startIdx, ClauseList
 
   while(itms) {
     Item* itm = ItemList::pop(itms);
-    ClauseList::push(itm->generateClause(), acc);
-    env.statistics->urResolution++;
+    Clause* res = itm->generateClause();
+    if(res) {
+      ClauseList::push(res, acc);
+      env.statistics->urResolution++;
+    }
     delete itm;
   }
 }
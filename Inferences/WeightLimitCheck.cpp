@@ -0,0 +1,112 @@
+
+/*
+ * File WeightLimitCheck.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file WeightLimitCheck.cpp
+ * Implements class WeightLimitCheck.
+ */
+
+#include "Lib/Environment.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Inference.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Saturation/ClauseContainer.hpp"
+
+#include "Shell/Statistics.hpp"
+
+#include "WeightLimitCheck.hpp"
+
+namespace Inferences
+{
+
+/**
+ * @b passive may be 0, for inferences used outside of a saturation algorithm.
+ * @b inf must stay alive as long as this object is used.
+ */
+WeightLimitCheck::WeightLimitCheck(PassiveClauseContainer* passive, unsigned numPositiveLiteralsLowerBound, const Inference& inf)
+ : _passive(passive), _numPositiveLiteralsLowerBound(numPositiveLiteralsLowerBound), _inf(inf), _weightLowerBound(0)
+{
+  CALL("WeightLimitCheck::WeightLimitCheck");
+
+  _enabled = passive && passive->weightLimited() && !passive->fulfilsAgeLimit(0, numPositiveLiteralsLowerBound, inf);
+}
+
+/**
+ * Add the weights of the literals of @b cl except for @b removed.
+ */
+void WeightLimitCheck::addPremise(Clause* cl, Literal* removed)
+{
+  CALL("WeightLimitCheck::addPremise");
+
+  unsigned clen = cl->length();
+  for (unsigned i = 0; i < clen; i++) {
+    Literal* lit = (*cl)[i];
+    if (lit != removed) {
+      _weightLowerBound += lit->weight();
+    }
+  }
+}
+
+bool WeightLimitCheck::fulfilsLimit()
+{
+  CALL("WeightLimitCheck::fulfilsLimit");
+  ASS(_enabled);
+
+  unsigned weight = _weightLowerBound > 0 ? _weightLowerBound : 0;
+  if (_passive->fulfilsWeightLimit(weight, _numPositiveLiteralsLowerBound, _inf)) {
+    return true;
+  }
+  env.statistics->discardedNonRedundantClauses++;
+  return false;
+}
+
+/**
+ * Return false if the clause is over the weight limit and should not be
+ * allocated, @b literalsNotInstantiated being the number of its literals
+ * that would have to be built.
+ */
+bool WeightLimitCheck::checkBeforeConstruction(unsigned literalsNotInstantiated)
+{
+  CALL("WeightLimitCheck::checkBeforeConstruction");
+
+  if (fulfilsLimit()) {
+    return true;
+  }
+  env.statistics->discardedBeforeConstruction++;
+  env.statistics->literalsNotInstantiated += literalsNotInstantiated;
+  return false;
+}
+
+/**
+ * Return false if the clause, already allocated, is over the weight limit,
+ * @b literalsNotInstantiated being the number of its literals still to be built.
+ */
+bool WeightLimitCheck::check(unsigned literalsNotInstantiated)
+{
+  CALL("WeightLimitCheck::check");
+
+  if (fulfilsLimit()) {
+    return true;
+  }
+  env.statistics->literalsNotInstantiated += literalsNotInstantiated;
+  return false;
+}
+
+}
@@ -0,0 +1,75 @@
+
+/*
+ * File WeightLimitCheck.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file WeightLimitCheck.hpp
+ * Defines class WeightLimitCheck.
+ */
+
+#ifndef __WeightLimitCheck__
+#define __WeightLimitCheck__
+
+#include "Forwards.hpp"
+
+namespace Inferences {
+
+using namespace Kernel;
+using namespace Saturation;
+
+/**
+ * Lower bound on the weight of a clause a generating inference is about
+ * to build, checked against the LRS weight limit of the passive container.
+ *
+ * The bound starts from the weights of the premise literals that are
+ * carried over to the conclusion. Since applying a substitution never
+ * decreases the weight of a literal, the inference can then add the
+ * growth of each literal as it instantiates it and recheck, so that
+ * a clause that is going to be discarded is found before it is allocated,
+ * or at least before all of its literals are built.
+ */
+class WeightLimitCheck
+{
+public:
+  WeightLimitCheck(PassiveClauseContainer* passive, unsigned numPositiveLiteralsLowerBound, const Inference& inf);
+
+  /**
+   * False if the clause cannot be discarded by the weight limit
+   * (there is no limit or the clause fulfils the age limit),
+   * in which case no other method needs to be called.
+   */
+  bool enabled() const { return _enabled; }
+
+  void addPremise(Clause* cl, Literal* removed = 0);
+  void add(int weight) { _weightLowerBound += weight; }
+
+  bool checkBeforeConstruction(unsigned literalsNotInstantiated);
+  bool check(unsigned literalsNotInstantiated);
+
+private:
+  bool fulfilsLimit();
+
+  PassiveClauseContainer* _passive;
+  unsigned _numPositiveLiteralsLowerBound;
+  const Inference& _inf;
+  bool _enabled;
+  int _weightLowerBound;
+};
+
+}
+
+#endif // __WeightLimitCheck__
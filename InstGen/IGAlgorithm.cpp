@@ -46,6 +46,8 @@
 #include "SAT/SATClause.hpp"
 #include "SAT/TWLSolver.hpp"
 #include "SAT/MinisatInterfacing.hpp"
+#include "SAT/MinisatInterfacingNewSimp.hpp"
+#include "SAT/TraceRecordingSolver.hpp"
 
 #include "Saturation/SaturationAlgorithm.hpp"
 
@@ -95,22 +97,27 @@ IGAlgorithm::IGAlgorithm(Problem& prb,const Options& opt)
   _passive.setAgeWeightRatio(_opt.ageRatio(), _opt.weightRatio());
   
   //TODO - Consider using MinimizingSolver here
+  SATSolverWithAssumptions* solver;
   switch(opt.satSolver()){
     case Options::SatSolver::VAMPIRE:
-      _satSolver = new TWLSolver(opt,true);
+      solver = new TWLSolver(opt,true);
       break;
     case Options::SatSolver::MINISAT:
-      _satSolver = new MinisatInterfacing(opt,true);
+      solver = new MinisatInterfacing(opt,true);
+      break;
+    case Options::SatSolver::MINISAT_SIMP:
+      solver = new MinisatInterfacingNewSimp(opt,true,true);
       break;
 #if VZ3
     case Options::SatSolver::Z3:
       //cout << "Warning: Z3 not compatible with inst_gen, using Minisat" << endl;
-      _satSolver = new MinisatInterfacing(opt,true);
+      solver = new MinisatInterfacing(opt,true);
       break;
 #endif
     default:
       ASSERTION_VIOLATION_REP(opt.satSolver());
   }
+  _satSolver = TraceRecordingSolver::wrapIfRequested(solver, opt);
 
   // TODO: should instgen use buffering?
 
@@ -282,12 +289,82 @@ Clause* IGAlgorithm::getFORefutation(SATClause* satRefutation, SATClauseList* sa
   return foRef;
 }
 
+/**
+ * The hash does not depend on the order of literals, as the SAT solver
+ * may permute the literals of the clauses it was given (e.g. to keep
+ * the watched ones in front).
+ */
+unsigned IGAlgorithm::GroundClauseHash::hash(SATClause* cl)
+{
+  unsigned res = cl->length();
+  unsigned clen = cl->length();
+  for(unsigned i=0; i<clen; i++) {
+    res += Hash::hash((*cl)[i].content());
+  }
+  return res;
+}
+
+/**
+ * Clauses without duplicate literals are equal if they have the
+ * same length and one contains all the literals of the other.
+ */
+bool IGAlgorithm::GroundClauseHash::equals(SATClause* cl1, SATClause* cl2)
+{
+  unsigned clen = cl1->length();
+  if(clen!=cl2->length()) {
+    return false;
+  }
+  for(unsigned i=0; i<clen; i++) {
+    bool found = false;
+    for(unsigned j=0; j<clen && !found; j++) {
+      found = (*cl1)[i]==(*cl2)[j];
+    }
+    if(!found) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Ground @c cl and push the result into @c acc, unless it is a tautology
+ * or a clause that was already passed to the SAT solver.
+ * Return true if a clause was pushed.
+ */
+bool IGAlgorithm::addGroundClause(Clause* cl, SATClauseStack& acc)
+{
+  CALL("IGAlgorithm::addGroundClause");
+
+  SATClause* sc = _gnd->ground(cl,_use_niceness);
+  sc = Preprocess::removeDuplicateLiterals(sc); //this is required by the SAT solver
+
+  // sc could have been a tautology, in which case sc == 0 after the removeDuplicateLiterals call
+  if (!sc) {
+    return false;
+  }
+  if (!_groundClauses.insert(sc)) {
+    // different first-order clauses may have the same grounding
+    env.statistics->instGenDuplicateGroundClauses++;
+    sc->destroy();
+    return false;
+  }
+  acc.push(sc);
+  return true;
+}
+
+/**
+ * Move the unprocessed clauses to passive and give their groundings
+ * to the SAT solver as one batch before solving.
+ */
 void IGAlgorithm::processUnprocessed()
 {
   CALL("IGAlgorithm::processUnprocessed");
 
   TimeCounter tc(TC_INST_GEN_SAT_SOLVING);
 
+  static SATClauseStack groundClauses;
+  groundClauses.reset();
+
   while(_unprocessed.isNonEmpty()) {
     Clause* cl = _unprocessed.popWithoutDec();
 
@@ -301,14 +378,9 @@ void IGAlgorithm::processUnprocessed()
       env.endOutput();
     }
 
-    SATClause* sc = _gnd->ground(cl,_use_niceness);
-    sc = Preprocess::removeDuplicateLiterals(sc); //this is required by the SAT solver
-
-    // sc could have been a tautology, in which case sc == 0 after the removeDuplicateLiterals call
-    if (sc) {
-      _satSolver->addClause(sc);
-    }
+    addGroundClause(cl, groundClauses);
   }
+  _satSolver->addClausesIter(pvi(SATClauseStack::ConstIterator(groundClauses)));
 
   if(_satSolver->solve()==SATSolver::UNSATISFIABLE) {
     Clause* foRefutation = getFORefutation(_satSolver->getRefutation(),_satSolver->getRefutationPremiseList());
@@ -619,13 +691,12 @@ void IGAlgorithm::onResolutionClauseDerived(Clause* cl)
     cl = _equalityProxy->apply(cl);
   }
 
-  SATClause* sc = _gnd->ground(cl,_use_niceness);
-  sc = Preprocess::removeDuplicateLiterals(sc); //this is required by the SAT solver
-
-  // sc could have been a tautology, in which case sc == 0 after the removeDuplicateLiterals call
-  if (sc) {
-    _satSolver->addClause(sc);
+  static SATClauseStack groundClauses;
+  groundClauses.reset();
+  if (!addGroundClause(cl, groundClauses)) {
+    return;
   }
+  _satSolver->addClause(groundClauses.pop());
 
   if(_satSolver->solve(true)==SATSolver::UNSATISFIABLE) {
     Clause* foRefutation = getFORefutation(_satSolver->getRefutation(),_satSolver->getRefutationPremiseList());
@@ -95,6 +95,7 @@ private:
   void wipeIndexes();
 
   void processUnprocessed();
+  bool addGroundClause(Clause* cl, SATClauseStack& acc);
   void activate(Clause* cl, bool wasDeactivated=false);
 
   void deactivate(Clause* cl);
@@ -133,6 +134,21 @@ private:
   SATSolver* _satSolver;
   ScopedPtr<IGGrounder> _gnd;
 
+  /**
+   * Compares SAT clauses by their sets of literals, so that
+   * each ground clause is given to the SAT solver only once.
+   */
+  struct GroundClauseHash {
+    static unsigned hash(SATClause* cl);
+    static bool equals(SATClause* cl1, SATClause* cl2);
+  };
+  /**
+   * Ground clauses already in the SAT solver. The solver lives as long
+   * as the algorithm, so the set is kept across restarts, when the
+   * surviving clauses would otherwise be grounded and added again.
+   */
+  DHSet<SATClause*,GroundClauseHash,GroundClauseHash> _groundClauses;
+
   /** Used by global subsumption */
   ScopedPtr<GroundingIndex> _groundingIndex;
   ScopedPtr<GlobalSubsumption> _globalSubsumption;
@@ -33,7 +33,6 @@
 #include "Lib/Int.hpp"
 #include "Lib/SharedSet.hpp"
 #include "Lib/Stack.hpp"
-#include "Lib/BitUtils.hpp"
 
 #include "Saturation/ClauseContainer.hpp"
 #include "Saturation/Splitter.hpp"
@@ -549,7 +548,7 @@ unsigned Clause::getNumeralWeight() const
       }
       IntegerConstantType intVal;
       if (theory->tryInterpretConstant(t,intVal)) {
-	int w = BitUtils::log2(abs(intVal.toInner()))-1;
+	int w = intVal.log2Abs()-1;
 	if (w > 0) {
 	  res += w;
 	}
@@ -568,8 +567,8 @@ unsigned Clause::getNumeralWeight() const
       if (!haveRat) {
 	continue;
       }
-      int wN = BitUtils::log2(abs(ratVal.numerator().toInner()))-1;
-      int wD = BitUtils::log2(abs(ratVal.denominator().toInner()))-1;
+      int wN = ratVal.numerator().log2Abs()-1;
+      int wD = ratVal.denominator().log2Abs()-1;
       int v = wN + wD;
       if (v > 0) {
 	res += v;
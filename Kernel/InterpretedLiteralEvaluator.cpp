@@ -30,6 +30,8 @@
 #include "Term.hpp"
 #include "Theory.hpp"
 
+#include "PolynomialNormalizer.hpp"
+
 #include "InterpretedLiteralEvaluator.hpp"
 
 #define IDEBUG 0
@@ -566,10 +568,10 @@ class InterpretedLiteralEvaluator::IntEvaluator : public TypedEvaluator<IntegerC
 {
 protected:
 
-  virtual bool isZero(IntegerConstantType arg){ return arg.toInner()==0;}
+  virtual bool isZero(IntegerConstantType arg){ return arg.isZero();}
   virtual TermList getZero(){ return TermList(theory->representConstant(IntegerConstantType(0))); }
-  virtual bool isOne(IntegerConstantType arg){ return arg.toInner()==1;}
-  virtual bool isMinusOne(IntegerConstantType arg){ return arg.toInner()==-1;}
+  virtual bool isOne(IntegerConstantType arg){ return arg==1;}
+  virtual bool isMinusOne(IntegerConstantType arg){ return arg==-1;}
 
   virtual TermList invert(TermList t){ 
     unsigned um = env.signature->getInterpretingSymbol(Theory::INT_UNARY_MINUS);
@@ -942,6 +944,7 @@ protected:
 // This is where the evaluators defined above are used.
 
 InterpretedLiteralEvaluator::InterpretedLiteralEvaluator()
+ : _normalizer(0)
 {
   CALL("InterpretedLiteralEvaluator::InterpretedLiteralEvaluator");
 
@@ -990,6 +993,9 @@ InterpretedLiteralEvaluator::InterpretedLiteralEvaluator()
   _funEvaluators.ensure(0);
   _predEvaluators.ensure(0);
 
+  if(env.options->polynomialNormalisation()){
+    _normalizer = new PolynomialNormalizer();
+  }
 }
 
 InterpretedLiteralEvaluator::~InterpretedLiteralEvaluator()
@@ -999,6 +1005,9 @@ InterpretedLiteralEvaluator::~InterpretedLiteralEvaluator()
   while (_evals.isNonEmpty()) {
     delete _evals.pop();
   }
+  if(_normalizer){
+    delete _normalizer;
+  }
 }
 
 /**
@@ -1333,8 +1342,11 @@ bool InterpretedLiteralEvaluator::evaluate(Literal* lit, bool& isConstant, Liter
   cout << "evaluate " << lit->toString() << endl;
 #endif
 
+  // Normalising the polynomials first merges numerals that are not next to each other
+  resLit = _normalizer ? _normalizer->transform(lit) : lit;
+
   // This tries to transform each subterm using tryEvaluateFunc (see transform Subterm below)
-  resLit = TermTransformerTransformTransformed::transform(lit);
+  resLit = TermTransformerTransformTransformed::transform(resLit);
 
 #if IDEBUG
   cout << "transformed " << resLit->toString() << endl;
@@ -62,6 +62,8 @@ protected:
   EvalStack _evals;
   DArray<Evaluator*> _funEvaluators;
   DArray<Evaluator*> _predEvaluators;
+  /** if non-zero, arithmetic subterms are normalised by it before evaluation */
+  PolynomialNormalizer* _normalizer;
 
   bool balancable(Literal* lit);
   bool balance(Literal* lit,Literal*& res,Stack<Literal*>& sideConditions);
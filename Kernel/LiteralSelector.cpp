@@ -35,6 +35,7 @@
 #include "MaximalLiteralSelector.hpp"
 #include "BestLiteralSelector.hpp"
 #include "LookaheadLiteralSelector.hpp"
+#include "OccupancyLiteralSelector.hpp"
 #include "SpassLiteralSelector.hpp"
 #include "ELiteralSelector.hpp"
 
@@ -142,6 +143,7 @@ LiteralSelector* LiteralSelector::getSelector(const Ordering& ordering, const Op
   case 10: res = new CompleteBestLiteralSelector<Comparator10>(ordering, options); break;
 
   case 11: res = new LookaheadLiteralSelector(true, ordering, options); break;
+  case 12: res = new OccupancyLiteralSelector(true, ordering, options); break;
 
   case 20:
   case 21:
@@ -164,6 +166,7 @@ LiteralSelector* LiteralSelector::getSelector(const Ordering& ordering, const Op
   case 1010: res = new BestLiteralSelector<Comparator10>(ordering, options); break;
 
   case 1011: res = new LookaheadLiteralSelector(false, ordering, options); break;
+  case 1012: res = new OccupancyLiteralSelector(false, ordering, options); break;
 
   default:
     INVALID_OPERATION("Undefined selection function");
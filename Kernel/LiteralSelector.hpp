@@ -93,6 +93,12 @@ public:
    */
   virtual bool isBGComplete() const = 0;
 
+  /**
+   * Called by the saturation algorithm with its container of active
+   * clauses, for selectors that take the active clauses into account
+   */
+  virtual void attachActiveContainer(Saturation::ClauseContainer* active) {}
+
 protected:
   /**
    * Perform selection on the first @b eligible literals of clause @b c
@@ -216,6 +216,21 @@ Literal* LookaheadLiteralSelector::pickTheBest(Literal** lits, unsigned cnt)
     }
   } while(candidates.isEmpty());
 
+  for(unsigned i=0;i<cnt;i++) {
+    runifs[i].drop(); //release the iterators
+  }
+  return pickAmongCandidates(candidates);
+}
+
+/**
+ * Return the best of the non-empty stack @b candidates of literals that
+ * lead to the same number of inferences. The stack is emptied.
+ */
+Literal* LookaheadLiteralSelector::pickAmongCandidates(LiteralStack& candidates)
+{
+  CALL("LookaheadLiteralSelector::pickAmongCandidates");
+  ASS(candidates.isNonEmpty());
+
   using namespace LiteralComparators;
   typedef Composite<ColoredFirst,
 	    Composite<NoPositiveEquality,
@@ -232,10 +247,6 @@ Literal* LookaheadLiteralSelector::pickTheBest(Literal** lits, unsigned cnt)
       }
     }
   }
-
-  for(unsigned i=0;i<cnt;i++) {
-    runifs[i].drop(); //release the iterators
-  }
   return res;
 }
 
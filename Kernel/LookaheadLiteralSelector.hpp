@@ -48,8 +48,10 @@ public:
   bool isBGComplete() const override { return _completeSelection; }
 protected:
   void doSelection(Clause* c, unsigned eligible) override;
+
+  virtual Literal* pickTheBest(Literal** lits, unsigned cnt);
+  Literal* pickAmongCandidates(LiteralStack& candidates);
 private:
-  Literal* pickTheBest(Literal** lits, unsigned cnt);
   void removeVariants(LiteralStack& lits);
   VirtualIterator<void> getGeneraingInferenceIterator(Literal* lit);
 
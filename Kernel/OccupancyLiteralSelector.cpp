@@ -0,0 +1,149 @@
+
+/*
+ * File OccupancyLiteralSelector.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file OccupancyLiteralSelector.cpp
+ * Implements class OccupancyLiteralSelector.
+ */
+
+#include "Lib/Stack.hpp"
+
+#include "Saturation/ClauseContainer.hpp"
+
+#include "Shell/Options.hpp"
+
+#include "Clause.hpp"
+#include "EqHelper.hpp"
+#include "Term.hpp"
+
+#include "OccupancyLiteralSelector.hpp"
+
+namespace Kernel
+{
+
+using namespace Lib;
+using namespace Saturation;
+
+void OccupancyLiteralSelector::attachActiveContainer(ClauseContainer* active)
+{
+  CALL("OccupancyLiteralSelector::attachActiveContainer");
+
+  active->addedEvent.subscribe(this, &OccupancyLiteralSelector::onActiveAdded);
+  active->removedEvent.subscribe(this, &OccupancyLiteralSelector::onActiveRemoved);
+}
+
+void OccupancyLiteralSelector::onActiveAdded(Clause* c)
+{
+  CALL("OccupancyLiteralSelector::onActiveAdded");
+
+  updateCounts(c, true);
+}
+
+void OccupancyLiteralSelector::onActiveRemoved(Clause* c)
+{
+  CALL("OccupancyLiteralSelector::onActiveRemoved");
+
+  updateCounts(c, false);
+}
+
+static void updateCount(unsigned& cnt, bool adding)
+{
+  if(adding) {
+    cnt++;
+  }
+  else {
+    ASS_G(cnt,0);
+    cnt--;
+  }
+}
+
+/**
+ * Count the symbols of the selected literals of @b c in the same way
+ * as the generating indexes would index them
+ */
+void OccupancyLiteralSelector::updateCounts(Clause* c, bool adding)
+{
+  CALL("OccupancyLiteralSelector::updateCounts");
+
+  unsigned selCnt = c->numSelected();
+  for(unsigned i=0;i<selCnt;i++) {
+    Literal* lit = (*c)[i];
+    updateCount(_literalCnts[lit->header()], adding);
+
+    TermIterator lhsIt = EqHelper::getLHSIterator(lit, _ord);
+    while(lhsIt.hasNext()) {
+      TermList lhs = lhsIt.next();
+      updateCount(lhs.isVar() ? _varLHSCnt : _lhsCnts[lhs.term()->functor()], adding);
+    }
+    TermIterator stIt = EqHelper::getRewritableSubtermIterator(lit, _ord);
+    while(stIt.hasNext()) {
+      updateCount(_subtermCnts[stIt.next().term()->functor()], adding);
+      updateCount(_subtermCnt, adding);
+    }
+  }
+}
+
+/**
+ * Return an estimate of the number of inferences with the active clauses
+ * that selecting @b lit would lead to: resolutions with the complementary
+ * literals, superpositions from @b lit into subterms with the same functor
+ * as its left-hand sides and superpositions into @b lit from left-hand sides
+ * with the same functor as its subterms. Unlike in LookaheadLiteralSelector,
+ * unifiability is not checked, so the estimate is an upper bound.
+ */
+unsigned OccupancyLiteralSelector::estimateInferences(Literal* lit)
+{
+  CALL("OccupancyLiteralSelector::estimateInferences");
+
+  unsigned res = _literalCnts[lit->complementaryHeader()];
+
+  TermIterator lhsIt = EqHelper::getLHSIterator(lit, _ord);
+  while(lhsIt.hasNext()) {
+    TermList lhs = lhsIt.next();
+    res += lhs.isVar() ? _subtermCnt : _subtermCnts[lhs.term()->functor()];
+  }
+  TermIterator stIt = EqHelper::getRewritableSubtermIterator(lit, _ord);
+  while(stIt.hasNext()) {
+    res += _lhsCnts[stIt.next().term()->functor()] + _varLHSCnt;
+  }
+  return res;
+}
+
+Literal* OccupancyLiteralSelector::pickTheBest(Literal** lits, unsigned cnt)
+{
+  CALL("OccupancyLiteralSelector::pickTheBest");
+  ASS_G(cnt,1); //special cases are handled elsewhere
+
+  static Stack<Literal*> candidates;
+  candidates.reset();
+  unsigned best = 0;
+  for(unsigned i=0;i<cnt;i++) {
+    unsigned estimate = estimateInferences(lits[i]);
+    if(candidates.isEmpty() || estimate<best) {
+      candidates.reset();
+      best = estimate;
+    }
+    if(estimate==best) {
+      candidates.push(lits[i]);
+    }
+  }
+
+  return pickAmongCandidates(candidates);
+}
+
+}
@@ -0,0 +1,72 @@
+
+/*
+ * File OccupancyLiteralSelector.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file OccupancyLiteralSelector.hpp
+ * Defines class OccupancyLiteralSelector.
+ */
+
+#ifndef __OccupancyLiteralSelector__
+#define __OccupancyLiteralSelector__
+
+#include "Forwards.hpp"
+
+#include "Lib/Array.hpp"
+
+#include "LookaheadLiteralSelector.hpp"
+
+namespace Kernel {
+
+/**
+ * Look-ahead selection that estimates the number of inferences with each
+ * literal from the symbols occurring in the selected literals of the active
+ * clauses, instead of querying the indexes. The symbol counts are updated
+ * as clauses enter and leave the active clause container.
+ */
+class OccupancyLiteralSelector
+: public LookaheadLiteralSelector
+{
+public:
+  CLASS_NAME(OccupancyLiteralSelector);
+  USE_ALLOCATOR(OccupancyLiteralSelector);
+
+  OccupancyLiteralSelector(bool completeSelection, const Ordering& ordering, const Options& options)
+  : LookaheadLiteralSelector(completeSelection, ordering, options), _varLHSCnt(0), _subtermCnt(0) {}
+
+  void attachActiveContainer(Saturation::ClauseContainer* active) override;
+protected:
+  Literal* pickTheBest(Literal** lits, unsigned cnt) override;
+private:
+  void onActiveAdded(Clause* c);
+  void onActiveRemoved(Clause* c);
+  void updateCounts(Clause* c, bool adding);
+  unsigned estimateInferences(Literal* lit);
+
+  /** the selected literals of active clauses, by their headers */
+  ZIArray<unsigned> _literalCnts;
+  /** the left-hand sides of superposition in the selected literals of active clauses, by their functors */
+  ZIArray<unsigned> _lhsCnts;
+  unsigned _varLHSCnt;
+  /** the subterms that superposition may rewrite in the selected literals of active clauses, by their functors */
+  ZIArray<unsigned> _subtermCnts;
+  unsigned _subtermCnt;
+};
+
+}
+
+#endif // __OccupancyLiteralSelector__
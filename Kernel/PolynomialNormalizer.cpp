@@ -0,0 +1,410 @@
+
+/*
+ * File PolynomialNormalizer.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file PolynomialNormalizer.cpp
+ * Implements class PolynomialNormalizer.
+ */
+
+#include "Lib/Environment.hpp"
+#include "Lib/Int.hpp"
+#include "Lib/Sort.hpp"
+
+#include "Ordering.hpp"
+#include "Signature.hpp"
+#include "Term.hpp"
+
+#include "PolynomialNormalizer.hpp"
+
+namespace Kernel
+{
+
+using namespace Lib;
+
+/**
+ * Interpretations of the polynomial operations over the numbers of type @b Number
+ */
+template<class Number>
+struct NumberTraits;
+
+template<>
+struct NumberTraits<IntegerConstantType>
+{
+  static Interpretation plus() { return Theory::INT_PLUS; }
+  static Interpretation minus() { return Theory::INT_MINUS; }
+  static Interpretation unaryMinus() { return Theory::INT_UNARY_MINUS; }
+  static Interpretation multiply() { return Theory::INT_MULTIPLY; }
+  static IntegerConstantType zero() { return IntegerConstantType(0); }
+  static IntegerConstantType one() { return IntegerConstantType(1); }
+};
+
+template<>
+struct NumberTraits<RationalConstantType>
+{
+  static Interpretation plus() { return Theory::RAT_PLUS; }
+  static Interpretation minus() { return Theory::RAT_MINUS; }
+  static Interpretation unaryMinus() { return Theory::RAT_UNARY_MINUS; }
+  static Interpretation multiply() { return Theory::RAT_MULTIPLY; }
+  static RationalConstantType zero() { return RationalConstantType(0); }
+  static RationalConstantType one() { return RationalConstantType(1); }
+};
+
+template<>
+struct NumberTraits<RealConstantType>
+{
+  static Interpretation plus() { return Theory::REAL_PLUS; }
+  static Interpretation minus() { return Theory::REAL_MINUS; }
+  static Interpretation unaryMinus() { return Theory::REAL_UNARY_MINUS; }
+  static Interpretation multiply() { return Theory::REAL_MULTIPLY; }
+  static RealConstantType zero() { return RealConstantType(RationalConstantType(0)); }
+  static RealConstantType one() { return RealConstantType(RationalConstantType(1)); }
+};
+
+/**
+ * A numeral coefficient times a product of atoms, which are kept sorted.
+ * A monomial without atoms is just the numeral.
+ */
+template<class Number>
+struct PolynomialNormalizer::Monomial
+{
+  Monomial() {}
+  explicit Monomial(const Number& c) : coeff(c) {}
+  Monomial(const Number& c, TermList atom) : coeff(c) { atoms.push(atom); }
+
+  Number coeff;
+  Stack<TermList> atoms;
+};
+
+/**
+ * Variables go first, ordered by their numbers, then other terms ordered by id.
+ */
+struct PolynomialNormalizer::AtomComparator
+{
+  static Comparison compare(TermList a1, TermList a2)
+  {
+    if (a1.isVar() != a2.isVar()) {
+      return a1.isVar() ? LESS : GREATER;
+    }
+    if (a1.isVar()) {
+      return Int::compare(a1.var(), a2.var());
+    }
+    return Int::compare(a1.term()->getId(), a2.term()->getId());
+  }
+};
+
+template<class Number>
+struct PolynomialNormalizer::MonomialComparator
+{
+  static Comparison compare(const Monomial<Number>& m1, const Monomial<Number>& m2)
+  {
+    // the numeral goes last
+    if (m1.atoms.isEmpty() != m2.atoms.isEmpty()) {
+      return m1.atoms.isEmpty() ? GREATER : LESS;
+    }
+    if (m1.atoms.size() != m2.atoms.size()) {
+      return Int::compare(m1.atoms.size(), m2.atoms.size());
+    }
+    for (unsigned i = 0; i < m1.atoms.size(); i++) {
+      Comparison res = AtomComparator::compare(m1.atoms[i], m2.atoms[i]);
+      if (res != EQUAL) {
+        return res;
+      }
+    }
+    return EQUAL;
+  }
+};
+
+PolynomialNormalizer::PolynomialNormalizer()
+ : _ordering(0)
+{
+}
+
+/**
+ * Replace maximal polynomial subterms by their normal forms. Other terms are
+ * left for TermTransformer to descend into.
+ */
+TermList PolynomialNormalizer::transformSubterm(TermList trm)
+{
+  CALL("PolynomialNormalizer::transformSubterm");
+
+  if (!theory->isInterpretedFunction(trm) || !trm.term()->shared()) {
+    return trm;
+  }
+  Ordering* ord = Ordering::tryGetGlobalOrdering();
+  if (ord != _ordering) {
+    // the normal forms built so far were oriented without the ordering
+    _ordering = ord;
+    _cache.reset();
+  }
+  Term* t = trm.term();
+  switch (theory->interpretFunction(t)) {
+  case Theory::INT_PLUS:
+  case Theory::INT_MINUS:
+  case Theory::INT_UNARY_MINUS:
+  case Theory::INT_MULTIPLY:
+    return normalize<IntegerConstantType>(t);
+  case Theory::RAT_PLUS:
+  case Theory::RAT_MINUS:
+  case Theory::RAT_UNARY_MINUS:
+  case Theory::RAT_MULTIPLY:
+    return normalize<RationalConstantType>(t);
+  case Theory::REAL_PLUS:
+  case Theory::REAL_MINUS:
+  case Theory::REAL_UNARY_MINUS:
+  case Theory::REAL_MULTIPLY:
+    return normalize<RealConstantType>(t);
+  default:
+    return trm;
+  }
+}
+
+template<class Number>
+TermList PolynomialNormalizer::normalize(Term* t)
+{
+  CALL("PolynomialNormalizer::normalize");
+
+  TermList res;
+  if (_cache.find(t->getId(), res)) {
+    return res;
+  }
+
+  Stack<Monomial<Number> > monomials;
+  collect(TermList(t), NumberTraits<Number>::one(), monomials);
+  merge(monomials);
+  res = build(monomials);
+
+  _cache.insert(t->getId(), res);
+  if (res.isTerm()) {
+    // a normal form is its own normal form
+    _cache.insert(res.term()->getId(), res);
+  }
+  return res;
+}
+
+/**
+ * Push to @b acc the monomials of @b t multiplied by @b factor.
+ */
+template<class Number>
+void PolynomialNormalizer::collect(TermList t, const Number& factor, Stack<Monomial<Number> >& acc)
+{
+  CALL("PolynomialNormalizer::collect");
+
+  typedef NumberTraits<Number> Traits;
+
+  if (t.isVar()) {
+    acc.push(Monomial<Number>(factor, t));
+    return;
+  }
+  Term* trm = t.term();
+  Number num;
+  if (theory->tryInterpretConstant(trm, num)) {
+    acc.push(Monomial<Number>(factor*num));
+    return;
+  }
+  Interpretation itp = theory->isInterpretedFunction(trm) ? theory->interpretFunction(trm) : Theory::INVALID_INTERPRETATION;
+  if (itp != Traits::plus() && itp != Traits::minus() && itp != Traits::unaryMinus() && itp != Traits::multiply()) {
+    acc.push(Monomial<Number>(factor, normalizeAtom(trm)));
+    return;
+  }
+
+  TermList cached;
+  if (_cache.find(trm->getId(), cached) && cached != t) {
+    collect(cached, factor, acc);
+    return;
+  }
+
+  TermList arg0 = *trm->nthArgument(0);
+  if (itp == Traits::unaryMinus()) {
+    collect(arg0, -factor, acc);
+    return;
+  }
+  TermList arg1 = *trm->nthArgument(1);
+  if (itp == Traits::plus()) {
+    collect(arg0, factor, acc);
+    collect(arg1, factor, acc);
+    return;
+  }
+  if (itp == Traits::minus()) {
+    collect(arg0, factor, acc);
+    collect(arg1, -factor, acc);
+    return;
+  }
+  ASS_EQ(itp, Traits::multiply());
+
+  Stack<Monomial<Number> > left;
+  Stack<Monomial<Number> > right;
+  collect(arg0, Traits::one(), left);
+  collect(arg1, Traits::one(), right);
+  merge(left);
+  merge(right);
+
+  if (left.size() > 1 && right.size() > 1) {
+    // multiplying out would make the term grow, keep the product as an atom
+    unsigned mul = env.signature->getInterpretingSymbol(Traits::multiply());
+    acc.push(Monomial<Number>(factor, TermList(Term::create2(mul, build(left), build(right)))));
+    return;
+  }
+  for (unsigned i = 0; i < left.size(); i++) {
+    for (unsigned j = 0; j < right.size(); j++) {
+      Monomial<Number> prod(factor*left[i].coeff*right[j].coeff);
+      prod.atoms.loadFromIterator(Stack<TermList>::BottomFirstIterator(left[i].atoms));
+      prod.atoms.loadFromIterator(Stack<TermList>::BottomFirstIterator(right[j].atoms));
+      sort<AtomComparator>(prod.atoms.begin(), prod.atoms.end());
+      acc.push(prod);
+    }
+  }
+}
+
+/**
+ * Sort @b monomials and merge the ones with the same atoms.
+ * Monomials with zero coefficient are removed.
+ */
+template<class Number>
+void PolynomialNormalizer::merge(Stack<Monomial<Number> >& monomials)
+{
+  CALL("PolynomialNormalizer::merge");
+
+  sort<MonomialComparator<Number> >(monomials.begin(), monomials.end());
+
+  unsigned next = 0;
+  for (unsigned i = 0; i < monomials.size(); i++) {
+    if (next > 0 && MonomialComparator<Number>::compare(monomials[next-1], monomials[i]) == EQUAL) {
+      monomials[next-1].coeff = monomials[next-1].coeff + monomials[i].coeff;
+      continue;
+    }
+    if (next > 0 && monomials[next-1].coeff == NumberTraits<Number>::zero()) {
+      next--;
+    }
+    if (next != i) {
+      monomials[next] = monomials[i];
+    }
+    next++;
+  }
+  if (next > 0 && monomials[next-1].coeff == NumberTraits<Number>::zero()) {
+    next--;
+  }
+  monomials.truncate(next);
+}
+
+/**
+ * Compare @b t1 and @b t2 by the term ordering. Terms the ordering does not
+ * compare (or all terms if there is no ordering yet) are compared by
+ * AtomComparator.
+ */
+Comparison PolynomialNormalizer::compareTerms(TermList t1, TermList t2)
+{
+  CALL("PolynomialNormalizer::compareTerms");
+
+  if (_ordering) {
+    switch (_ordering->compare(t1, t2)) {
+    case Ordering::GREATER:
+    case Ordering::GREATER_EQ:
+      return GREATER;
+    case Ordering::LESS:
+    case Ordering::LESS_EQ:
+      return LESS;
+    default:
+      break;
+    }
+  }
+  return AtomComparator::compare(t1, t2);
+}
+
+/**
+ * Return the term @b fun(a1,fun(a2,...,fun(an-1,an))) with the arguments
+ * @b args sorted in ascending order by compareTerms. The commutativity and
+ * associativity axioms of @b fun cannot rewrite it by demodulation, since
+ * they only rewrite into a smaller term.
+ */
+TermList PolynomialNormalizer::buildOrdered(unsigned fun, Stack<TermList>& args)
+{
+  CALL("PolynomialNormalizer::buildOrdered");
+  ASS(args.isNonEmpty());
+
+  // insertion sort, as the ordering need not be total on non-ground terms
+  for (unsigned i = 1; i < args.size(); i++) {
+    TermList t = args[i];
+    unsigned j = i;
+    while (j > 0 && compareTerms(args[j-1], t) == GREATER) {
+      args[j] = args[j-1];
+      j--;
+    }
+    args[j] = t;
+  }
+
+  TermList res = args.top();
+  for (unsigned i = args.size()-1; i > 0; i--) {
+    res = TermList(Term::create2(fun, args[i-1], res));
+  }
+  return res;
+}
+
+template<class Number>
+TermList PolynomialNormalizer::build(const Stack<Monomial<Number> >& monomials)
+{
+  CALL("PolynomialNormalizer::build");
+
+  typedef NumberTraits<Number> Traits;
+
+  if (monomials.isEmpty()) {
+    return TermList(theory->representConstant(Traits::zero()));
+  }
+  unsigned plus = env.signature->getInterpretingSymbol(Traits::plus());
+  unsigned mul = env.signature->getInterpretingSymbol(Traits::multiply());
+  unsigned um = env.signature->getInterpretingSymbol(Traits::unaryMinus());
+
+  Stack<TermList> summands;
+  Stack<TermList> factors;
+  for (unsigned i = 0; i < monomials.size(); i++) {
+    const Monomial<Number>& m = monomials[i];
+    if (m.atoms.isEmpty()) {
+      summands.push(TermList(theory->representConstant(m.coeff)));
+      continue;
+    }
+    factors.reset();
+    factors.loadFromIterator(Stack<TermList>::BottomFirstIterator(m.atoms));
+    // the forms with coefficients one and minus one are those the evaluator produces
+    if (m.coeff != Traits::one() && m.coeff != -Traits::one()) {
+      factors.push(TermList(theory->representConstant(m.coeff)));
+    }
+    TermList mt = buildOrdered(mul, factors);
+    if (m.coeff == -Traits::one()) {
+      mt = TermList(Term::create1(um, mt));
+    }
+    summands.push(mt);
+  }
+  return buildOrdered(plus, summands);
+}
+
+/**
+ * Return @b t with its polynomial subterms normalised.
+ */
+TermList PolynomialNormalizer::normalizeAtom(Term* t)
+{
+  CALL("PolynomialNormalizer::normalizeAtom");
+
+  TermList res;
+  if (_cache.find(t->getId(), res)) {
+    return res;
+  }
+  res = TermList(transform(t));
+  _cache.insert(t->getId(), res);
+  return res;
+}
+
+}
@@ -0,0 +1,92 @@
+
+/*
+ * File PolynomialNormalizer.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file PolynomialNormalizer.hpp
+ * Defines class PolynomialNormalizer.
+ */
+
+#ifndef __PolynomialNormalizer__
+#define __PolynomialNormalizer__
+
+#include "Forwards.hpp"
+
+#include "Lib/DHMap.hpp"
+#include "Lib/Stack.hpp"
+
+#include "TermTransformer.hpp"
+#include "Theory.hpp"
+
+namespace Kernel {
+
+/**
+ * Rewrites integer, rational and real terms built from +, -, unary minus,
+ * multiplication and numerals into a normal form, a sum of monomials with
+ * merged numeral coefficients.
+ *
+ * The summands of the normal form and the factors of each monomial are
+ * sorted by the global term ordering and nested to the right, so that the
+ * commutativity and associativity theory axioms cannot rewrite the normal
+ * form back. A product of two sums is not multiplied out, it becomes an atom
+ * whose factors are normalised.
+ *
+ * The normal form of each shared arithmetic term is remembered, so the same
+ * sum occurring in many clauses is normalised only once. The remembered
+ * forms are dropped when the global ordering changes.
+ */
+class PolynomialNormalizer
+  : public TermTransformer
+{
+public:
+  CLASS_NAME(PolynomialNormalizer);
+  USE_ALLOCATOR(PolynomialNormalizer);
+
+  PolynomialNormalizer();
+
+  using TermTransformer::transform;
+
+protected:
+  virtual TermList transformSubterm(TermList trm);
+
+private:
+  template<class Number> struct Monomial;
+  struct AtomComparator;
+  template<class Number> struct MonomialComparator;
+
+  template<class Number>
+  TermList normalize(Term* t);
+  template<class Number>
+  void collect(TermList t, const Number& factor, Stack<Monomial<Number> >& acc);
+  template<class Number>
+  static void merge(Stack<Monomial<Number> >& monomials);
+  template<class Number>
+  TermList build(const Stack<Monomial<Number> >& monomials);
+  Comparison compareTerms(TermList t1, TermList t2);
+  TermList buildOrdered(unsigned fun, Stack<TermList>& args);
+
+  TermList normalizeAtom(Term* t);
+
+  /** normal forms of the shared terms with the given ids */
+  DHMap<unsigned,TermList> _cache;
+  /** the global ordering the normal forms in _cache were oriented by */
+  Ordering* _ordering;
+};
+
+}
+
+#endif // __PolynomialNormalizer__
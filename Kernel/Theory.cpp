@@ -21,11 +21,13 @@
  * Implements class Theory.
  */
 
+#include <cstdio>
 #include <math.h>
 
 #include "Debug/Assertion.hpp"
 #include "Debug/Tracer.hpp"
 
+#include "Lib/BitUtils.hpp"
 #include "Lib/Environment.hpp"
 #include "Lib/Int.hpp"
 
@@ -51,10 +53,32 @@ IntegerConstantType::IntegerConstantType(const vstring& str)
 {
   CALL("IntegerConstantType::IntegerConstantType(vstring)");
 
-  if (!Int::stringToInt(str, _val)) {
-    //TODO: raise exception only on overflow, the proper syntax should be guarded by assertion
+  if (Int::stringToInt(str, _val)) {
+    return;
+  }
+  BigInteger big;
+  if (!BigInteger::fromString(str, big)) {
+    //TODO: the proper syntax should be guarded by assertion
     throw ArithmeticException();
   }
+  *this = IntegerConstantType(big);
+}
+
+IntegerConstantType::IntegerConstantType(const BigInteger& big)
+ : _val(0)
+{
+  CALL("IntegerConstantType::IntegerConstantType(BigInteger)");
+
+  if (!big.toInt(_val)) {
+    _big = SmartPtr<BigInteger>(new BigInteger(big));
+  }
+}
+
+BigInteger IntegerConstantType::toBig() const
+{
+  CALL("IntegerConstantType::toBig");
+
+  return fitsInner() ? BigInteger(_val) : *_big;
 }
 
 IntegerConstantType IntegerConstantType::operator+(const IntegerConstantType& num) const
@@ -62,10 +86,10 @@ IntegerConstantType IntegerConstantType::operator+(const IntegerConstantType& nu
   CALL("IntegerConstantType::operator+");
 
   InnerType res;
-  if (!Int::safePlus(_val, num._val, res)) {
-    throw ArithmeticException();
+  if (fitsInner() && num.fitsInner() && Int::safePlus(_val, num._val, res)) {
+    return IntegerConstantType(res);
   }
-  return IntegerConstantType(res);
+  return IntegerConstantType(toBig()+num.toBig());
 }
 
 IntegerConstantType IntegerConstantType::operator-(const IntegerConstantType& num) const
@@ -73,10 +97,10 @@ IntegerConstantType IntegerConstantType::operator-(const IntegerConstantType& nu
   CALL("IntegerConstantType::operator-/1");
 
   InnerType res;
-  if (!Int::safeMinus(_val, num._val, res)) {
-    throw ArithmeticException();
+  if (fitsInner() && num.fitsInner() && Int::safeMinus(_val, num._val, res)) {
+    return IntegerConstantType(res);
   }
-  return IntegerConstantType(res);
+  return IntegerConstantType(toBig()-num.toBig());
 }
 
 IntegerConstantType IntegerConstantType::operator-() const
@@ -84,10 +108,10 @@ IntegerConstantType IntegerConstantType::operator-() const
   CALL("IntegerConstantType::operator-/0");
 
   InnerType res;
-  if (!Int::safeUnaryMinus(_val, res)) {
-    throw ArithmeticException();
+  if (fitsInner() && Int::safeUnaryMinus(_val, res)) {
+    return IntegerConstantType(res);
   }
-  return IntegerConstantType(res);
+  return IntegerConstantType(-toBig());
 }
 
 IntegerConstantType IntegerConstantType::operator*(const IntegerConstantType& num) const
@@ -95,49 +119,155 @@ IntegerConstantType IntegerConstantType::operator*(const IntegerConstantType& nu
   CALL("IntegerConstantType::operator*");
 
   InnerType res;
-  if (!Int::safeMultiply(_val, num._val, res)) {
-    throw ArithmeticException();
+  if (fitsInner() && num.fitsInner() && Int::safeMultiply(_val, num._val, res)) {
+    return IntegerConstantType(res);
   }
-  return IntegerConstantType(res);
+  return IntegerConstantType(toBig()*num.toBig());
 }
 
+/**
+ * Truncating division, i.e. the same as the C++ one on native integers.
+ */
 IntegerConstantType IntegerConstantType::operator/(const IntegerConstantType& num) const
 {
   CALL("IntegerConstantType::operator/");
 
-  //TODO: check if division corresponds to the TPTP semantic
-  if (num._val==0) {
+  if (num.isZero()) {
     throw ArithmeticException();
   }
-  if(_val == numeric_limits<InnerType>::min() && num._val == -1){
-    throw ArithmeticException();
+  if (fitsInner() && num.fitsInner() && !(_val == numeric_limits<InnerType>::min() && num._val == -1)) {
+    return IntegerConstantType(_val/num._val);
   }
-  return IntegerConstantType(_val/num._val);
+  BigInteger quot, rem;
+  BigInteger::divide(toBig(), num.toBig(), quot, rem);
+  return IntegerConstantType(quot);
 }
 
+/**
+ * Remainder of the truncating division, so it has the sign of this number.
+ */
 IntegerConstantType IntegerConstantType::operator%(const IntegerConstantType& num) const
 {
   CALL("IntegerConstantType::operator%");
 
-  //TODO: check if modulo corresponds to the TPTP semantic
-  if (num._val==0) {
+  if (num.isZero()) {
     throw ArithmeticException();
   }
-  return IntegerConstantType(_val%num._val);
+  if (fitsInner() && num.fitsInner() && !(_val == numeric_limits<InnerType>::min() && num._val == -1)) {
+    return IntegerConstantType(_val%num._val);
+  }
+  BigInteger quot, rem;
+  BigInteger::divide(toBig(), num.toBig(), quot, rem);
+  return IntegerConstantType(rem);
+}
+
+/**
+ * True if this number is non-zero and @b num is its multiple.
+ */
+bool IntegerConstantType::divides(const IntegerConstantType& num) const
+{
+  CALL("IntegerConstantType::divides");
+
+  if (isZero()) {
+    return false;
+  }
+  return (num % (*this)).isZero();
+}
+
+/**
+ * Euclidean quotient, i.e. the one for which the remainder is non-negative.
+ */
+IntegerConstantType IntegerConstantType::quotientE(const IntegerConstantType& num) const
+{
+  CALL("IntegerConstantType::quotientE");
+
+  IntegerConstantType res = (*this)/num;
+  if ((*this % num).isNegative()) {
+    res = num.isNegative() ? res+1 : res-1;
+  }
+  return res;
+}
+
+/**
+ * Quotient rounded towards zero.
+ */
+IntegerConstantType IntegerConstantType::quotientT(const IntegerConstantType& num) const
+{
+  CALL("IntegerConstantType::quotientT");
+
+  return (*this)/num;
+}
+
+/**
+ * Quotient rounded towards negative infinity.
+ */
+IntegerConstantType IntegerConstantType::quotientF(const IntegerConstantType& num) const
+{
+  CALL("IntegerConstantType::quotientF");
+
+  IntegerConstantType res = (*this)/num;
+  if (!(*this % num).isZero() && isNegative()!=num.isNegative()) {
+    res = res-1;
+  }
+  return res;
 }
 
 bool IntegerConstantType::operator==(const IntegerConstantType& num) const
 {
   CALL("IntegerConstantType::operator==");
 
-  return _val==num._val;
+  if (fitsInner() || num.fitsInner()) {
+    // values that fit are never stored as BigInteger
+    return fitsInner() && num.fitsInner() && _val==num._val;
+  }
+  return BigInteger::compare(*_big, *num._big)==EQUAL;
 }
 
 bool IntegerConstantType::operator>(const IntegerConstantType& num) const
 {
   CALL("IntegerConstantType::operator>");
 
-  return _val>num._val;
+  if (fitsInner() && num.fitsInner()) {
+    return _val>num._val;
+  }
+  return BigInteger::compare(toBig(), num.toBig())==GREATER;
+}
+
+/**
+ * Return the index of the most significant non-zero bit of the absolute value,
+ * i.e. what BitUtils::log2 returns for numbers that fit into unsigned.
+ */
+unsigned IntegerConstantType::log2Abs() const
+{
+  CALL("IntegerConstantType::log2Abs");
+
+  if (fitsInner()) {
+    // the absolute value of the minimal InnerType does not fit into InnerType, but does into unsigned
+    unsigned absVal = _val<0 ? 0u-static_cast<unsigned>(_val) : static_cast<unsigned>(_val);
+    return BitUtils::log2(absVal);
+  }
+  return _big->bitLength()-1;
+}
+
+/**
+ * Return the greatest common divisor of @b n1 and @b n2, or 1 if one of them is zero
+ * (the same as Int::gcd does).
+ */
+IntegerConstantType IntegerConstantType::gcd(const IntegerConstantType& n1, const IntegerConstantType& n2)
+{
+  CALL("IntegerConstantType::gcd");
+
+  if (n1.isZero() || n2.isZero()) {
+    return IntegerConstantType(1);
+  }
+  IntegerConstantType a = n1.isNegative() ? -n1 : n1;
+  IntegerConstantType b = n2.isNegative() ? -n2 : n2;
+  while (!b.isZero()) {
+    IntegerConstantType rem = a%b;
+    a = b;
+    b = rem;
+  }
+  return a;
 }
 
 IntegerConstantType IntegerConstantType::floor(RationalConstantType rat)
@@ -183,40 +313,27 @@ IntegerConstantType IntegerConstantType::ceiling(RationalConstantType rat)
 Comparison IntegerConstantType::comparePrecedence(IntegerConstantType n1, IntegerConstantType n2)
 {
   CALL("IntegerConstantType::comparePrecedence");
-  try {
-    if (n1 == numeric_limits<InnerType>::min()) {
-      if (n2 == numeric_limits<InnerType>::min()) {
-        return EQUAL;
-      } else {
-        return GREATER;
-      }
-    } else {
-      if (n2 == numeric_limits<InnerType>::min()) {
-        return LESS;
-      } else {
-        InnerType an1 = abs(n1.toInner());
-        InnerType an2 = abs(n2.toInner());
-
-        ASS_GE(an1,0);
-        ASS_GE(an2,0);
-
-        return an1 < an2 ? LESS : (an1 == an2 ? // compare the signed ones, making negative greater than positive
-            static_cast<Comparison>(-Int::compare(n1.toInner(), n2.toInner()))
-                              : GREATER);
-      }
-    }
-  }
-  catch(ArithmeticException) {
-    ASSERTION_VIOLATION;
-    throw;
+
+  bool neg1 = n1.isNegative();
+  bool neg2 = n2.isNegative();
+  IntegerConstantType an1 = neg1 ? -n1 : n1;
+  IntegerConstantType an2 = neg2 ? -n2 : n2;
+
+  if (an1 != an2) {
+    return an1 < an2 ? LESS : GREATER;
   }
+  // compare the signed ones, making negative greater than positive
+  return neg1 == neg2 ? EQUAL : (neg1 ? GREATER : LESS);
 }
 
 vstring IntegerConstantType::toString() const
 {
   CALL("IntegerConstantType::toString");
 
-  return Int::toString(_val);
+  if (fitsInner()) {
+    return Int::toString(_val);
+  }
+  return _big->toString();
 }
 
 ///////////////////////
@@ -253,7 +370,7 @@ void RationalConstantType::init(InnerType num, InnerType den)
   cannonize();
 
   // Dividing by zero is bad!
-  if(_den.toInner()==0) throw ArithmeticException();
+  if(_den.isZero()) throw ArithmeticException();
 }
 
 RationalConstantType RationalConstantType::operator+(const RationalConstantType& o) const
@@ -335,7 +452,7 @@ void RationalConstantType::cannonize()
 {
   CALL("RationalConstantType::cannonize");
 
-  InnerType gcd = Int::gcd(_num.toInner(), _den.toInner());
+  InnerType gcd = IntegerConstantType::gcd(_num, _den);
   if (gcd!=1) {
     _num = _num/gcd;
     _den = _den/gcd;
@@ -353,56 +470,18 @@ void RationalConstantType::cannonize()
 Comparison RationalConstantType::comparePrecedence(RationalConstantType n1, RationalConstantType n2)
 {
   CALL("RationalConstantType::comparePrecedence");
-  try {
 
-    if (n1==n2) { return EQUAL; }
+  if (n1==n2) { return EQUAL; }
 
-    bool haveRepr1 = true;
-    bool haveRepr2 = true;
-
-    IntegerConstantType repr1, repr2;
-
-    try {
-      repr1 = n1.numerator()+n1.denominator();
-    } catch(ArithmeticException) {
-      haveRepr1 = false;
-    }
+  IntegerConstantType repr1 = n1.numerator()+n1.denominator();
+  IntegerConstantType repr2 = n2.numerator()+n2.denominator();
 
-    try {
-      repr2 = n2.numerator()+n2.denominator();
-    } catch(ArithmeticException) {
-      haveRepr2 = false;
-    }
-
-    if (haveRepr1 && haveRepr2) {
-      Comparison res = IntegerConstantType::comparePrecedence(repr1, repr2);
-      if (res==EQUAL) {
-	res = IntegerConstantType::comparePrecedence(n1.numerator(), n2.numerator());
-      }
-      ASS_NEQ(res, EQUAL);
-      return res;
-    }
-    if (haveRepr1 && !haveRepr2) {
-      return LESS;
-    }
-    if (!haveRepr1 && haveRepr2) {
-      return GREATER;
-    }
-
-    ASS(!haveRepr1);
-    ASS(!haveRepr2);
-
-    Comparison res = IntegerConstantType::comparePrecedence(n1.denominator(), n2.denominator());
-    if (res==EQUAL) {
-      res = IntegerConstantType::comparePrecedence(n1.numerator(), n2.numerator());
-    }
-    ASS_NEQ(res, EQUAL);
-    return res;
-  }
-  catch(ArithmeticException) {
-    ASSERTION_VIOLATION;
-    throw;
+  Comparison res = IntegerConstantType::comparePrecedence(repr1, repr2);
+  if (res==EQUAL) {
+    res = IntegerConstantType::comparePrecedence(n1.numerator(), n2.numerator());
   }
+  ASS_NEQ(res, EQUAL);
+  return res;
 }
 
 
@@ -426,9 +505,17 @@ bool RealConstantType::parseDouble(const vstring& num, RationalConstantType& res
     IntegerConstantType denominator = 1;
     bool haveDecimal = false;
     bool neg = false;
+    int exponent = 0;
     size_t nlen = num.size();
     for(size_t i=0; i<nlen; i++) {
-      if (num[i]=='.') {
+      if ((num[i]=='e' || num[i]=='E') && newNum.size()) {
+	size_t expStart = (i+1<nlen && num[i+1]=='+') ? i+2 : i+1;
+	if (expStart==nlen || !Int::stringToInt(num.substr(expStart), exponent)) {
+	  return false;
+	}
+	break;
+      }
+      else if (num[i]=='.') {
 	if (haveDecimal) {
 	  return false;
 	}
@@ -452,10 +539,23 @@ bool RealConstantType::parseDouble(const vstring& num, RationalConstantType& res
 	return false;
       }
     }
+    if (newNum.empty()) {
+      return false;
+    }
     if (neg) {
       newNum = '-'+newNum;
     }
     IntegerConstantType numerator(newNum);
+    if (exponent>MAX_DECIMAL_EXPONENT || exponent<-MAX_DECIMAL_EXPONENT) {
+      // the value is exact, but too large to be worth representing
+      return false;
+    }
+    for(int i=0; i<exponent; i++) {
+      numerator = numerator * 10;
+    }
+    for(int i=0; i>exponent; i--) {
+      denominator = denominator * 10;
+    }
     res = RationalConstantType(numerator, denominator);
   } catch(ArithmeticException) {
     return false;
@@ -468,37 +568,23 @@ RealConstantType::RealConstantType(const vstring& number)
   CALL("RealConstantType::RealConstantType");
 
   RationalConstantType value;
-  if (parseDouble(number, value)) {
-    init(value.numerator(), value.denominator());
-    return;
-  }
-
-  double numDbl;
-  if (!Int::stringToDouble(number, numDbl)) {
-    //TODO: raise exception only on overflow, the proper syntax should be guarded by assertion
-    throw ArithmeticException();
-  }
-  InnerType denominator = 1;
-  while(::floor(numDbl)!=numDbl) {
-    denominator = denominator*10;
-    numDbl *= 10;
-  }
-
-  InnerType::InnerType numerator = static_cast<InnerType::InnerType>(numDbl);
-  if (numerator!=numDbl) {
-    //the numerator part of double doesn't fit inside the inner integer type
+  if (!parseDouble(number, value)) {
+    // going through a double would make the value inexact
     throw ArithmeticException();
   }
-  init(numerator, denominator);
+  init(value.numerator(), value.denominator());
 }
 
 vstring RealConstantType::toNiceString() const
 {
   CALL("RealConstantType::toNiceString");
 
-  if (denominator().toInner()==1) {
+  if (denominator()==1) {
     return numerator().toString()+".0";
   }
+  if (!numerator().fitsInner() || !denominator().fitsInner()) {
+    return toString();
+  }
   float frep = (float) numerator().toInner() /(float) denominator().toInner();
   return Int::toString(frep);
   //return toString();
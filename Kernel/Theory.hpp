@@ -28,8 +28,10 @@
 
 #include "Forwards.hpp"
 
+#include "Lib/BigInteger.hpp"
 #include "Lib/DHMap.hpp"
 #include "Lib/Exception.hpp"
+#include "Lib/SmartPtr.hpp"
 
 #include "Shell/TermAlgebra.hpp"
 
@@ -40,10 +42,17 @@ namespace Kernel {
 
 /**
  * Exception to be thrown when the requested operation cannot be performed,
- * e.g. because of overflow of a native type.
+ * e.g. because of division by zero.
  */
 class ArithmeticException : public ThrowableBase {};
 
+/**
+ * A class for representing integers of arbitrary size
+ *
+ * Values that fit into InnerType are stored directly and the arithmetic on
+ * them is done natively with overflow checks. A result that overflows is
+ * computed and stored as a BigInteger instead.
+ */
 class IntegerConstantType
 {
 public:
@@ -51,7 +60,7 @@ public:
 
   typedef int InnerType;
 
-  IntegerConstantType() {}
+  IntegerConstantType() : _val(0) {}
   IntegerConstantType(InnerType v) : _val(v) {}
   explicit IntegerConstantType(const vstring& str);
 
@@ -63,52 +72,11 @@ public:
   IntegerConstantType operator%(const IntegerConstantType& num) const;
 
   // true if this divides num
-  bool divides(const IntegerConstantType& num) const {
-    CALL("IntegerConstantType:divides");
-    // if this is zero it shouldn't divide anything, if num is zero dividing it doesn't make sense
-    if(_val==0 || num._val==0){ return false; }
-    // if this is bigger than num then the result cannot be an integer
-    if(_val > num._val){ return false; }
-    // now we only need to check the absolute value
-    int safeVal=_val;
-    if (_val < 0 && ! Lib::Int::safeUnaryMinus<int>(_val,safeVal)) {
-      return false;
-    }
-    return (num._val % safeVal ==0);
-  }
+  bool divides(const IntegerConstantType& num) const;
 
-  float realDivide(const IntegerConstantType& num) const { 
-    if(num._val==0) throw ArithmeticException();
-    return ((float)_val)/num._val; 
-  }
-  int intDivide(const IntegerConstantType& num) const {
-      CALL("IntegerConstantType::intDivide");
-      ASS(num.divides(*this));
-      if(num._val==0){ throw ArithmeticException(); }
-      return _val/num._val;
-  }
-  // TODO: shouldn't we always be using intDivide for quotientE - when are they different (apart from real rounding)?
-  IntegerConstantType quotientE(const IntegerConstantType& num) const { 
-    CALL("IntegerConstantType::quotientE");
-    //cout << "quotientE " << _val << " and " << num._val << endl;
-    if(num.divides(*this)){
-      return IntegerConstantType(intDivide(num));
-    }
-    if(num._val>0) return IntegerConstantType(::floor(realDivide(num)));
-    else return IntegerConstantType(::ceil(realDivide(num)));
-  }
-  IntegerConstantType quotientT(const IntegerConstantType& num) const { 
-    if(num.divides(*this)){
-      return IntegerConstantType(intDivide(num));
-    }
-    return IntegerConstantType(::trunc(realDivide(num)));
-  }
-  IntegerConstantType quotientF(const IntegerConstantType& num) const { 
-    if(num.divides(*this)){
-      return IntegerConstantType(intDivide(num));
-    }
-    return IntegerConstantType(::floor(realDivide(num)));
-  }
+  IntegerConstantType quotientE(const IntegerConstantType& num) const;
+  IntegerConstantType quotientT(const IntegerConstantType& num) const;
+  IntegerConstantType quotientF(const IntegerConstantType& num) const;
 
   bool operator==(const IntegerConstantType& num) const;
   bool operator>(const IntegerConstantType& num) const;
@@ -118,10 +86,16 @@ public:
   bool operator>=(const IntegerConstantType& o) const { return !(o>(*this)); }
   bool operator<=(const IntegerConstantType& o) const { return !((*this)>o); }
 
-  InnerType toInner() const { return _val; }
+  /** true if the value fits into InnerType and can be retrieved by toInner() */
+  bool fitsInner() const { return !_big; }
+  InnerType toInner() const { ASS(fitsInner()); return _val; }
+
+  bool isZero() const { return fitsInner() && _val==0; }
+  bool isNegative() const { return fitsInner() ? _val<0 : _big->isNegative(); }
+
+  unsigned log2Abs() const;
 
-  bool isZero(){ return _val==0; }
-  bool isNegative(){ return _val<0; }
+  static IntegerConstantType gcd(const IntegerConstantType& n1, const IntegerConstantType& n2);
 
   static IntegerConstantType floor(RationalConstantType rat);
   static IntegerConstantType ceiling(RationalConstantType rat);
@@ -130,20 +104,27 @@ public:
 
   vstring toString() const;
 private:
+  explicit IntegerConstantType(const BigInteger& big);
+  BigInteger toBig() const;
+
+  /**
+   * The value if it fits into InnerType. Otherwise it is stored in _big,
+   * so that each value has exactly one representation.
+   */
   InnerType _val;
+  SmartPtr<BigInteger> _big;
 };
 
 inline
 std::ostream& operator<< (ostream& out, const IntegerConstantType& val) {
-  return out << val.toInner();
+  return out << val.toString();
 }
 
 /**
  * A class for representing rational numbers
  *
- * The class uses IntegerConstantType to store the numerator and denominator.
- * This ensures that if there is an overflow in the operations, an exception
- * will be raised by the IntegerConstantType methods.
+ * The class uses IntegerConstantType to store the numerator and denominator,
+ * so the operations cannot overflow.
  */
 struct RationalConstantType {
   typedef IntegerConstantType InnerType;
@@ -182,12 +163,12 @@ struct RationalConstantType {
   bool operator>=(const RationalConstantType& o) const { return !(o>(*this)); }
   bool operator<=(const RationalConstantType& o) const { return !((*this)>o); }
 
-  bool isZero(){ return _num.toInner()==0; } 
+  bool isZero() const { return _num.isZero(); }
   // relies on the fact that cannonize ensures that _den>=0
-  bool isNegative(){ ASS(_den>=0); return _num.toInner() < 0; }
+  bool isNegative() const { ASS(_den>=0); return _num.isNegative(); }
 
   RationalConstantType quotientE(const RationalConstantType& num) const {
-    if(_num.toInner()>0 && _den.toInner()>0){
+    if(_num>0 && _den>0){
        return ((*this)/num).floor(); 
     }
     else return ((*this)/num).ceiling();
@@ -258,6 +239,9 @@ public:
 
   static Comparison comparePrecedence(RealConstantType n1, RealConstantType n2);
 private:
+  /** largest decimal exponent of a real numeral that is converted exactly */
+  static const int MAX_DECIMAL_EXPONENT = 10000;
+
   static bool parseDouble(const vstring& num, RationalConstantType& res);
 
 };
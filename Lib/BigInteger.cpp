@@ -0,0 +1,451 @@
+
+/*
+ * File BigInteger.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file BigInteger.cpp
+ * Implements class BigInteger.
+ */
+
+#include "Debug/Assertion.hpp"
+#include "Debug/Tracer.hpp"
+
+#include <climits>
+#include <cstdio>
+
+#include "BigInteger.hpp"
+
+namespace Lib {
+
+typedef unsigned long long DoubleDigit;
+
+BigInteger::BigInteger(long long val)
+ : _negative(val<0)
+{
+  CALL("BigInteger::BigInteger");
+
+  // negate in unsigned arithmetic so that LLONG_MIN does not overflow
+  unsigned long long abs = _negative ? 0ull-static_cast<unsigned long long>(val) : static_cast<unsigned long long>(val);
+  while(abs) {
+    _digits.push(static_cast<unsigned>(abs));
+    abs >>= 32;
+  }
+}
+
+/**
+ * Parse a decimal integer with an optional leading sign into @b res.
+ * Return false if @b str is not of this form.
+ */
+bool BigInteger::fromString(const vstring& str, BigInteger& res)
+{
+  CALL("BigInteger::fromString");
+
+  size_t i = 0;
+  bool negative = false;
+  if(str.size() && (str[0]=='-' || str[0]=='+')) {
+    negative = str[0]=='-';
+    i = 1;
+  }
+  if(i==str.size()) {
+    return false;
+  }
+  res._digits.reset();
+  res._negative = false;
+  for(; i<str.size(); i++) {
+    if(str[i]<'0' || str[i]>'9') {
+      return false;
+    }
+    // res = res*10 + digit
+    DoubleDigit carry = str[i]-'0';
+    for(size_t j=0; j<res._digits.size(); j++) {
+      DoubleDigit cur = static_cast<DoubleDigit>(res._digits[j])*10 + carry;
+      res._digits[j] = static_cast<unsigned>(cur);
+      carry = cur >> 32;
+    }
+    if(carry) {
+      res._digits.push(static_cast<unsigned>(carry));
+    }
+  }
+  res._negative = negative && !res.isZero();
+  return true;
+}
+
+void BigInteger::trim(Digits& a)
+{
+  while(a.isNonEmpty() && a.top()==0) {
+    a.pop();
+  }
+}
+
+Comparison BigInteger::compareMagnitudes(const Digits& a, const Digits& b)
+{
+  if(a.size()!=b.size()) {
+    return a.size()<b.size() ? LESS : GREATER;
+  }
+  for(size_t i=a.size(); i>0; i--) {
+    if(a[i-1]!=b[i-1]) {
+      return a[i-1]<b[i-1] ? LESS : GREATER;
+    }
+  }
+  return EQUAL;
+}
+
+void BigInteger::addMagnitudes(const Digits& a, const Digits& b, Digits& res)
+{
+  CALL("BigInteger::addMagnitudes");
+
+  size_t len = max(a.size(), b.size());
+  res.reset();
+  DoubleDigit carry = 0;
+  for(size_t i=0; i<len; i++) {
+    DoubleDigit cur = carry;
+    if(i<a.size()) { cur += a[i]; }
+    if(i<b.size()) { cur += b[i]; }
+    res.push(static_cast<unsigned>(cur));
+    carry = cur >> 32;
+  }
+  if(carry) {
+    res.push(static_cast<unsigned>(carry));
+  }
+}
+
+/**
+ * Subtract the magnitude @b b from the magnitude @b a, which must not be smaller.
+ */
+void BigInteger::subtractMagnitudes(const Digits& a, const Digits& b, Digits& res)
+{
+  CALL("BigInteger::subtractMagnitudes");
+  ASS_NEQ(compareMagnitudes(a,b),LESS);
+
+  res.reset();
+  unsigned borrow = 0;
+  for(size_t i=0; i<a.size(); i++) {
+    DoubleDigit sub = static_cast<DoubleDigit>(i<b.size() ? b[i] : 0) + borrow;
+    DoubleDigit cur = a[i];
+    if(cur>=sub) {
+      res.push(static_cast<unsigned>(cur-sub));
+      borrow = 0;
+    }
+    else {
+      res.push(static_cast<unsigned>((cur | (1ull<<32)) - sub));
+      borrow = 1;
+    }
+  }
+  ASS_EQ(borrow,0);
+  trim(res);
+}
+
+void BigInteger::multiplyMagnitudes(const Digits& a, const Digits& b, Digits& res)
+{
+  CALL("BigInteger::multiplyMagnitudes");
+
+  res.reset();
+  if(a.isEmpty() || b.isEmpty()) {
+    return;
+  }
+  for(size_t i=0; i<a.size()+b.size(); i++) {
+    res.push(0);
+  }
+  for(size_t i=0; i<a.size(); i++) {
+    DoubleDigit carry = 0;
+    for(size_t j=0; j<b.size(); j++) {
+      DoubleDigit cur = static_cast<DoubleDigit>(a[i])*b[j] + res[i+j] + carry;
+      res[i+j] = static_cast<unsigned>(cur);
+      carry = cur >> 32;
+    }
+    res[i+b.size()] = static_cast<unsigned>(carry);
+  }
+  trim(res);
+}
+
+/**
+ * Divide the magnitude @b a in place by the non-zero digit @b d
+ * and return the remainder.
+ */
+unsigned BigInteger::divideMagnitudeByDigit(Digits& a, unsigned d)
+{
+  CALL("BigInteger::divideMagnitudeByDigit");
+  ASS_NEQ(d,0);
+
+  DoubleDigit rem = 0;
+  for(size_t i=a.size(); i>0; i--) {
+    DoubleDigit cur = (rem << 32) | a[i-1];
+    a[i-1] = static_cast<unsigned>(cur / d);
+    rem = cur % d;
+  }
+  trim(a);
+  return static_cast<unsigned>(rem);
+}
+
+/**
+ * Divide the magnitude @b u by the magnitude @b v, which has at least two digits,
+ * using the algorithm D from Knuth's TAOCP vol. 2, section 4.3.1.
+ */
+void BigInteger::divideMagnitudes(const Digits& u, const Digits& v, Digits& q, Digits& r)
+{
+  CALL("BigInteger::divideMagnitudes");
+  ASS_G(v.size(),1);
+
+  q.reset();
+  r.reset();
+  if(compareMagnitudes(u,v)==LESS) {
+    for(size_t i=0; i<u.size(); i++) {
+      r.push(u[i]);
+    }
+    return;
+  }
+
+  size_t n = v.size();
+  size_t m = u.size()-n;
+
+  // normalize so that the top digit of the divisor has its highest bit set
+  unsigned shift = 0;
+  while(!(v[n-1] & (0x80000000u >> shift))) {
+    shift++;
+  }
+  Digits vn;
+  Digits un;
+  for(size_t i=0; i<n; i++) {
+    DoubleDigit cur = static_cast<DoubleDigit>(v[i]) << shift;
+    if(i>0 && shift) {
+      cur |= v[i-1] >> (32-shift);
+    }
+    vn.push(static_cast<unsigned>(cur));
+  }
+  for(size_t i=0; i<u.size(); i++) {
+    DoubleDigit cur = static_cast<DoubleDigit>(u[i]) << shift;
+    if(i>0 && shift) {
+      cur |= u[i-1] >> (32-shift);
+    }
+    un.push(static_cast<unsigned>(cur));
+  }
+  un.push(shift ? u[u.size()-1] >> (32-shift) : 0);
+
+  for(size_t i=0; i<=m; i++) {
+    q.push(0);
+  }
+  const DoubleDigit base = 1ull << 32;
+  for(size_t j=m+1; j>0; j--) {
+    size_t k = j-1;
+    DoubleDigit num = (static_cast<DoubleDigit>(un[k+n]) << 32) | un[k+n-1];
+    DoubleDigit qhat = num / vn[n-1];
+    DoubleDigit rhat = num % vn[n-1];
+    while(qhat>=base || qhat*vn[n-2] > ((rhat << 32) | un[k+n-2])) {
+      qhat--;
+      rhat += vn[n-1];
+      if(rhat>=base) {
+        break;
+      }
+    }
+
+    // un[k..k+n] -= qhat*vn
+    long long borrow = 0;
+    DoubleDigit carry = 0;
+    for(size_t i=0; i<n; i++) {
+      DoubleDigit prod = qhat*vn[i] + carry;
+      carry = prod >> 32;
+      long long cur = static_cast<long long>(un[i+k]) - borrow - static_cast<long long>(prod & 0xFFFFFFFFull);
+      un[i+k] = static_cast<unsigned>(cur);
+      borrow = cur<0 ? 1 : 0;
+    }
+    long long top = static_cast<long long>(un[k+n]) - borrow - static_cast<long long>(carry);
+    un[k+n] = static_cast<unsigned>(top);
+
+    if(top<0) {
+      // qhat was one too large, add the divisor back
+      qhat--;
+      DoubleDigit c = 0;
+      for(size_t i=0; i<n; i++) {
+        DoubleDigit cur = static_cast<DoubleDigit>(un[i+k]) + vn[i] + c;
+        un[i+k] = static_cast<unsigned>(cur);
+        c = cur >> 32;
+      }
+      un[k+n] = static_cast<unsigned>(un[k+n] + c);
+    }
+    q[k] = static_cast<unsigned>(qhat);
+  }
+  trim(q);
+
+  // denormalize the remainder
+  for(size_t i=0; i<n; i++) {
+    DoubleDigit cur = un[i] >> shift;
+    if(shift) {
+      cur |= static_cast<DoubleDigit>(un[i+1]) << (32-shift);
+    }
+    r.push(static_cast<unsigned>(cur));
+  }
+  trim(r);
+}
+
+BigInteger BigInteger::addSigned(const BigInteger& o, bool negateOther) const
+{
+  CALL("BigInteger::addSigned");
+
+  bool otherNegative = negateOther ? (!o._negative && !o.isZero()) : o._negative;
+  BigInteger res;
+  if(_negative==otherNegative) {
+    addMagnitudes(_digits, o._digits, res._digits);
+    res._negative = _negative;
+  }
+  else if(compareMagnitudes(_digits, o._digits)!=LESS) {
+    subtractMagnitudes(_digits, o._digits, res._digits);
+    res._negative = _negative;
+  }
+  else {
+    subtractMagnitudes(o._digits, _digits, res._digits);
+    res._negative = otherNegative;
+  }
+  if(res.isZero()) {
+    res._negative = false;
+  }
+  return res;
+}
+
+BigInteger BigInteger::operator+(const BigInteger& o) const
+{
+  return addSigned(o, false);
+}
+
+BigInteger BigInteger::operator-(const BigInteger& o) const
+{
+  return addSigned(o, true);
+}
+
+BigInteger BigInteger::operator-() const
+{
+  BigInteger res(*this);
+  res._negative = !_negative && !isZero();
+  return res;
+}
+
+BigInteger BigInteger::operator*(const BigInteger& o) const
+{
+  CALL("BigInteger::operator*");
+
+  BigInteger res;
+  multiplyMagnitudes(_digits, o._digits, res._digits);
+  res._negative = !res.isZero() && _negative!=o._negative;
+  return res;
+}
+
+/**
+ * Truncating division, i.e. the @b quotient is rounded towards zero
+ * and the @b remainder has the sign of @b a.
+ */
+void BigInteger::divide(const BigInteger& a, const BigInteger& b, BigInteger& quotient, BigInteger& remainder)
+{
+  CALL("BigInteger::divide");
+  ASS(!b.isZero());
+
+  Digits q;
+  Digits r;
+  if(b._digits.size()==1) {
+    for(size_t i=0; i<a._digits.size(); i++) {
+      q.push(a._digits[i]);
+    }
+    unsigned rem = divideMagnitudeByDigit(q, b._digits[0]);
+    if(rem) {
+      r.push(rem);
+    }
+  }
+  else {
+    divideMagnitudes(a._digits, b._digits, q, r);
+  }
+  quotient._digits = q;
+  quotient._negative = !q.isEmpty() && a._negative!=b._negative;
+  remainder._digits = r;
+  remainder._negative = !r.isEmpty() && a._negative;
+}
+
+Comparison BigInteger::compare(const BigInteger& a, const BigInteger& b)
+{
+  CALL("BigInteger::compare");
+
+  if(a._negative!=b._negative) {
+    return a._negative ? LESS : GREATER;
+  }
+  Comparison res = compareMagnitudes(a._digits, b._digits);
+  if(a._negative) {
+    res = static_cast<Comparison>(-res);
+  }
+  return res;
+}
+
+/**
+ * If the number fits into an int, assign it to @b res and return true.
+ */
+bool BigInteger::toInt(int& res) const
+{
+  CALL("BigInteger::toInt");
+
+  if(_digits.size()>1) {
+    return false;
+  }
+  long long val = _digits.isEmpty() ? 0 : static_cast<long long>(_digits[0]);
+  if(_negative) {
+    val = -val;
+  }
+  if(val<INT_MIN || val>INT_MAX) {
+    return false;
+  }
+  res = static_cast<int>(val);
+  return true;
+}
+
+/**
+ * Return the number of bits of the absolute value, 0 for zero.
+ */
+unsigned BigInteger::bitLength() const
+{
+  if(_digits.isEmpty()) {
+    return 0;
+  }
+  unsigned res = (_digits.size()-1)*32;
+  for(unsigned top = _digits.top(); top; top >>= 1) {
+    res++;
+  }
+  return res;
+}
+
+vstring BigInteger::toString() const
+{
+  CALL("BigInteger::toString");
+
+  if(isZero()) {
+    return "0";
+  }
+  // collect the decimal digits in chunks of nine
+  Digits mag;
+  for(size_t i=0; i<_digits.size(); i++) {
+    mag.push(_digits[i]);
+  }
+  Stack<unsigned> chunks;
+  while(mag.isNonEmpty()) {
+    chunks.push(divideMagnitudeByDigit(mag, 1000000000u));
+  }
+  vstring res = _negative ? "-" : "";
+  char buf[16];
+  snprintf(buf, sizeof(buf), "%u", chunks.top());
+  res += buf;
+  for(size_t i=chunks.size()-1; i>0; i--) {
+    snprintf(buf, sizeof(buf), "%09u", chunks[i-1]);
+    res += buf;
+  }
+  return res;
+}
+
+}
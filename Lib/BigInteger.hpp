@@ -0,0 +1,90 @@
+
+/*
+ * File BigInteger.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file BigInteger.hpp
+ * Defines class BigInteger of arbitrary-precision integers.
+ */
+
+#ifndef __BigInteger__
+#define __BigInteger__
+
+#include "Allocator.hpp"
+#include "Comparison.hpp"
+#include "Stack.hpp"
+#include "VString.hpp"
+
+namespace Lib {
+
+/**
+ * An integer of unbounded size, stored as its sign and the digits of
+ * its absolute value in base 2^32.
+ *
+ * The class is meant as the slow path of number types that store small
+ * values directly (see Kernel::IntegerConstantType), so it aims at being
+ * simple rather than fast on large numbers.
+ */
+class BigInteger
+{
+public:
+  CLASS_NAME(BigInteger);
+  USE_ALLOCATOR(BigInteger);
+
+  BigInteger() : _negative(false) {}
+  explicit BigInteger(long long val);
+
+  static bool fromString(const vstring& str, BigInteger& res);
+
+  BigInteger operator+(const BigInteger& o) const;
+  BigInteger operator-(const BigInteger& o) const;
+  BigInteger operator-() const;
+  BigInteger operator*(const BigInteger& o) const;
+
+  static void divide(const BigInteger& a, const BigInteger& b, BigInteger& quotient, BigInteger& remainder);
+
+  static Comparison compare(const BigInteger& a, const BigInteger& b);
+
+  bool isZero() const { return _digits.isEmpty(); }
+  bool isNegative() const { return _negative; }
+
+  bool toInt(int& res) const;
+  unsigned bitLength() const;
+  vstring toString() const;
+
+private:
+  typedef Stack<unsigned> Digits;
+
+  static Comparison compareMagnitudes(const Digits& a, const Digits& b);
+  static void addMagnitudes(const Digits& a, const Digits& b, Digits& res);
+  static void subtractMagnitudes(const Digits& a, const Digits& b, Digits& res);
+  static void multiplyMagnitudes(const Digits& a, const Digits& b, Digits& res);
+  static unsigned divideMagnitudeByDigit(Digits& a, unsigned d);
+  static void divideMagnitudes(const Digits& u, const Digits& v, Digits& q, Digits& r);
+  static void trim(Digits& a);
+
+  BigInteger addSigned(const BigInteger& o, bool negateOther) const;
+
+  /** digits of the absolute value, least significant first, without leading zeros */
+  Digits _digits;
+  /** false for zero */
+  bool _negative;
+};
+
+}
+
+#endif // __BigInteger__
@@ -0,0 +1,198 @@
+
+/*
+ * File SamplingProfiler.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file SamplingProfiler.cpp
+ * Implements class SamplingProfiler.
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <signal.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/Int.hpp"
+#include "Lib/System.hpp"
+#include "Lib/Sys/Multiprocessing.hpp"
+
+#include "Shell/Statistics.hpp"
+
+#include "SamplingProfiler.hpp"
+
+namespace Lib
+{
+
+using namespace Shell;
+
+bool SamplingProfiler::s_running = false;
+volatile bool SamplingProfiler::s_paused = false;
+vstring* SamplingProfiler::s_fileName = 0;
+SamplingProfiler::Sample SamplingProfiler::s_samples[TABLE_SIZE];
+unsigned SamplingProfiler::s_dropped = 0;
+
+/**
+ * Record one sample. Runs in the signal handler, so it only reads
+ * the counter stack and updates the preallocated table.
+ */
+void SamplingProfiler::handler(int sig)
+{
+  if (s_paused) {
+    return;
+  }
+
+  TimeCounterUnit stack[MAX_DEPTH*4];
+  unsigned total = TimeCounter::activeUnits(stack, MAX_DEPTH*4);
+
+  Sample key;
+  key.phase = env.statistics ? static_cast<unsigned char>(env.statistics->phase) : 0;
+  key.depth = total<MAX_DEPTH ? total : MAX_DEPTH;
+  // outermost unit first
+  for (unsigned i = 0; i < key.depth; i++) {
+    key.units[i] = static_cast<unsigned short>(stack[total-1-i]);
+  }
+
+  unsigned hash = 2166136261u ^ key.phase;
+  for (unsigned i = 0; i < key.depth; i++) {
+    hash = (hash ^ key.units[i]) * 16777619u;
+  }
+
+  for (unsigned probe = 0; probe < TABLE_SIZE; probe++) {
+    Sample& s = s_samples[(hash+probe) & (TABLE_SIZE-1)];
+    if (!s.count) {
+      s = key;
+      s.count = 1;
+      return;
+    }
+    if (s.phase==key.phase && s.depth==key.depth &&
+        !memcmp(s.units, key.units, key.depth*sizeof(key.units[0]))) {
+      s.count++;
+      return;
+    }
+  }
+  s_dropped++;
+}
+
+void SamplingProfiler::setTimer(unsigned usec)
+{
+  itimerval tv;
+  tv.it_interval.tv_sec = 0;
+  tv.it_interval.tv_usec = usec;
+  tv.it_value.tv_sec = 0;
+  tv.it_value.tv_usec = usec;
+  errno = 0;
+  if (setitimer(ITIMER_PROF, &tv, 0)) {
+    SYSTEM_FAIL("Call to setitimer failed when setting the profiling timer.",errno);
+  }
+}
+
+/**
+ * Start sampling, the samples will be written to @b fileName by writeReport().
+ */
+void SamplingProfiler::start(vstring fileName)
+{
+  CALL("SamplingProfiler::start");
+  ASS(!s_running);
+
+  {
+    BYPASSING_ALLOCATOR;
+    s_fileName = new vstring(fileName);
+  }
+
+  struct sigaction sa;
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = handler;
+  sa.sa_flags = SA_RESTART;
+  sigemptyset(&sa.sa_mask);
+  sigaction(SIGPROF, &sa, 0);
+
+  Sys::Multiprocessing::instance()->registerForkHandlers(suspendBeforeFork, restoreAfterFork, restartInChild);
+
+  s_running = true;
+  setTimer(PERIOD_USEC);
+}
+
+void SamplingProfiler::suspendBeforeFork()
+{
+  setTimer(0);
+}
+
+void SamplingProfiler::restoreAfterFork()
+{
+  setTimer(PERIOD_USEC);
+}
+
+/**
+ * A forked child starts with an empty table of its own and writes
+ * it into a file named after its pid.
+ */
+void SamplingProfiler::restartInChild()
+{
+  memset(s_samples, 0, sizeof(s_samples));
+  s_dropped = 0;
+  {
+    BYPASSING_ALLOCATOR;
+    *s_fileName += "." + Int::toString(getpid());
+  }
+  setTimer(PERIOD_USEC);
+}
+
+/**
+ * Write the samples collected so far. May be called repeatedly,
+ * each call rewrites the whole file.
+ */
+void SamplingProfiler::writeReport()
+{
+  CALL("SamplingProfiler::writeReport");
+
+  if (!s_running) {
+    return;
+  }
+
+  s_paused = true;
+  {
+    BYPASSING_ALLOCATOR;
+
+    ofstream out(s_fileName->c_str());
+    if (out.fail()) {
+      s_paused = false;
+      USER_ERROR("Cannot open sampling profile file: "+*s_fileName);
+    }
+    for (unsigned i = 0; i < TABLE_SIZE; i++) {
+      const Sample& s = s_samples[i];
+      if (!s.count) {
+        continue;
+      }
+      out << Statistics::phaseToString(static_cast<Statistics::ExecutionPhase>(s.phase));
+      for (unsigned j = 0; j < s.depth; j++) {
+        out << ';';
+        TimeCounter::outputName(static_cast<TimeCounterUnit>(s.units[j]), out);
+      }
+      out << ' ' << s.count << endl;
+    }
+    if (s_dropped) {
+      out << "dropped samples " << s_dropped << endl;
+    }
+  }
+  s_paused = false;
+}
+
+}
@@ -0,0 +1,85 @@
+
+/*
+ * File SamplingProfiler.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file SamplingProfiler.hpp
+ * Defines class SamplingProfiler.
+ */
+
+#ifndef __SamplingProfiler__
+#define __SamplingProfiler__
+
+#include "Forwards.hpp"
+
+#include "TimeCounter.hpp"
+
+namespace Lib {
+
+/**
+ * SIGPROF-based sampling profiler.
+ *
+ * Every millisecond of CPU time, the signal handler records the
+ * execution phase and the stack of running TimeCounter units into a
+ * fixed-size table allocated up front, so the handler neither allocates
+ * nor takes locks. The samples are written as folded stacks
+ * ("phase;outer unit;...;inner unit count" per line) that flame graph
+ * tools read directly.
+ */
+class SamplingProfiler
+{
+public:
+  static void start(vstring fileName);
+  static void writeReport();
+
+  static bool isRunning() { return s_running; }
+
+private:
+  enum {
+    /** deeper stacks keep their outermost units */
+    MAX_DEPTH = 16,
+    /** must be a power of two */
+    TABLE_SIZE = 8192,
+    PERIOD_USEC = 1000
+  };
+
+  struct Sample {
+    unsigned count;
+    unsigned char phase;
+    unsigned char depth;
+    unsigned short units[MAX_DEPTH];
+  };
+
+  static void handler(int sig);
+  static void setTimer(unsigned usec);
+
+  static void suspendBeforeFork();
+  static void restoreAfterFork();
+  static void restartInChild();
+
+  static bool s_running;
+  /** set while the table is being written out */
+  static volatile bool s_paused;
+  static vstring* s_fileName;
+  static Sample s_samples[TABLE_SIZE];
+  /** samples that found the table full */
+  static unsigned s_dropped;
+};
+
+}
+
+#endif // __SamplingProfiler__
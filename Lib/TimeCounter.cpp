@@ -21,6 +21,8 @@
  * Implements class TimeCounter.
  */
 
+#include <atomic>
+
 #include "Debug/Assertion.hpp"
 #include "Debug/Tracer.hpp"
 
@@ -76,7 +78,8 @@ void TimeCounter::initialize()
 
   s_initialized=true;
 
-  if(!env.options->timeStatistics()) {
+  // the sampling profiler reads the stack of running counters
+  if(!env.options->timeStatistics() && env.options->samplingProfile()=="off") {
     s_measuring=false;
     return;
   }
@@ -106,12 +109,14 @@ void TimeCounter::startMeasuring(TimeCounterUnit tcu)
   // don't run a timer inside itself
   ASS_REP(s_measureInitTimes[tcu] == -1,tcu);
 
+  // the counter must be complete before it becomes visible to the SIGPROF handler
+  _tcu=tcu;
   previousTop = s_currTop;
+  atomic_signal_fence(memory_order_release);
   s_currTop = this;
 
   int currTime=env.timer->elapsedMilliseconds();
 
-  _tcu=tcu;
   s_measureInitTimes[_tcu]=currTime;
 }
 
@@ -167,6 +172,22 @@ void TimeCounter::snapShot()
   s_measureInitTimes[TC_OTHER]=currTime;
 }
 
+/**
+ * Store into @b units the units of the running counters, the innermost one
+ * first, and return their number (at most @b max). Only reads memory, so it
+ * can be called from a signal handler.
+ */
+unsigned TimeCounter::activeUnits(TimeCounterUnit* units, unsigned max)
+{
+  unsigned cnt = 0;
+  TimeCounter* counter = s_currTop;
+  while(counter && cnt<max) {
+    units[cnt++] = counter->_tcu;
+    counter = counter->previousTop;
+  }
+  return cnt;
+}
+
 void TimeCounter::printReport(ostream& out)
 {
   CALL("TimeCounter::printReport");
@@ -181,13 +202,11 @@ void TimeCounter::printReport(ostream& out)
   out<<endl;
 }
 
-void TimeCounter::outputSingleStat(TimeCounterUnit tcu, ostream& out)
+/**
+ * Write into @b out the name of @b tcu as it appears in the report.
+ */
+void TimeCounter::outputName(TimeCounterUnit tcu, ostream& out)
 {
-  if (s_measureInitTimes[tcu]==-1 && !s_measuredTimes[tcu]) {
-    return;
-  }
-
-  addCommentSignForSZS(out);
   switch(tcu) {
   case TC_RAND_OPT:
     out << "random option generation";
@@ -382,6 +401,18 @@ void TimeCounter::outputSingleStat(TimeCounterUnit tcu, ostream& out)
   case TC_FMB_CONSTRAINT_CREATION:
     out << "fmb constraint creation";
     break;
+  case TC_FMB_INSTANCES:
+    out << "fmb instance generation";
+    break;
+  case TC_FMB_FUNCTIONAL_DEFS:
+    out << "fmb functional definitions";
+    break;
+  case TC_FMB_SYMMETRY_AXIOMS:
+    out << "fmb symmetry axioms";
+    break;
+  case TC_FMB_TOTALITY_DEFS:
+    out << "fmb totality definitions";
+    break;
   case TC_HCVI_COMPUTE_HASH:
     out << "hvci compute hash";
     break;
@@ -411,6 +442,16 @@ void TimeCounter::outputSingleStat(TimeCounterUnit tcu, ostream& out)
   default:
     ASSERTION_VIOLATION;
   }
+}
+
+void TimeCounter::outputSingleStat(TimeCounterUnit tcu, ostream& out)
+{
+  if (s_measureInitTimes[tcu]==-1 && !s_measuredTimes[tcu]) {
+    return;
+  }
+
+  addCommentSignForSZS(out);
+  outputName(tcu, out);
   out<<": ";
 
   Timer::printMSString(out, s_measuredTimes[tcu]);
@@ -96,6 +96,10 @@ enum TimeCounterUnit
   TC_FMB_SPLITTING,
   TC_FMB_SAT_SOLVING,
   TC_FMB_CONSTRAINT_CREATION,
+  TC_FMB_INSTANCES,
+  TC_FMB_FUNCTIONAL_DEFS,
+  TC_FMB_SYMMETRY_AXIOMS,
+  TC_FMB_TOTALITY_DEFS,
   TC_HCVI_COMPUTE_HASH,
   TC_HCVI_INSERT,
   TC_HCVI_RETRIEVE,
@@ -125,6 +129,8 @@ public:
   }
 
   static void printReport(ostream& out);
+  static void outputName(TimeCounterUnit tcu, ostream& out);
+  static unsigned activeUnits(TimeCounterUnit* units, unsigned max);
 
 
   /**
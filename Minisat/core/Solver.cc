@@ -72,6 +72,7 @@ Solver::Solver() :
   , rnd_init_act     (opt_rnd_init_act)
   , garbage_frac     (opt_garbage_frac)
   , min_learnts_lim  (opt_min_learnts_lim)
+  , track_model_changes (false)
   , restart_first    (opt_restart_first)
   , restart_inc      (opt_restart_inc)
 
@@ -845,7 +846,8 @@ static double luby(double y, int x){
 // NOTE: assumptions passed in member-variable 'assumptions'.
 lbool Solver::solve_()
 {
-    model.clear();
+    if (!track_model_changes)
+        model.clear();   // otherwise kept to compare the new model with
     conflict.clear();
     if (!ok) return l_False;
 
@@ -881,8 +883,11 @@ lbool Solver::solve_()
 
     if (status == l_True){
         // Extend & copy model:
-        model.growTo(nVars());
-        for (int i = 0; i < nVars(); i++) model[i] = value(i);
+        model.growTo(nVars(), l_Undef);
+        for (int i = 0; i < nVars(); i++){
+            if (track_model_changes && model[i] != value(i))
+                modelChanges.push(i);
+            model[i] = value(i); }
     }else if (status == l_False && conflict.size() == 0)
         ok = false;
 
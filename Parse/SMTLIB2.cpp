@@ -76,8 +76,37 @@ void SMTLIB2::parse(istream& str)
 
   LispLexer lex(str);
   LispParser lpar(lex);
-  LExpr* expr = lpar.parse();
-  parse(expr);
+
+  // read the benchmark one top-level entry at a time, so that the tree of
+  // each entry can be released as soon as it has been turned into units
+  while (LExpr* lexp = lpar.parseNext()) {
+    if (!lexp->isList()) {
+      USER_ERROR("<list> expected, <atom> found: "+lexp->toString());
+    }
+
+    if (readCommand(lexp)) {
+      // sort definitions are expanded lazily and keep pointing to the tree
+      if (!LispListReader(lexp).lookAheadAtom("define-sort")) {
+        lexp->destroy();
+      }
+      continue;
+    }
+
+    LispListReader ibRdr(lexp);
+    if (ibRdr.tryAcceptAtom("check-sat")) {
+      LExpr* next = lpar.parseNext();
+      if (next) {
+        checkEntryAfterCheckSat(next);
+      }
+      break;
+    }
+
+    ALWAYS(ibRdr.tryAcceptAtom("exit"));
+    if (lpar.parseNext()) {
+      USER_ERROR("<eol> expected after exit");
+    }
+    break;
+  }
 }
 
 void SMTLIB2::parse(LExpr* bench)
@@ -97,198 +126,231 @@ void SMTLIB2::readBenchmark(LExprList* bench)
   while(bRdr.hasNext()){
     LExpr* lexp = bRdr.next();
 
-    LOG2("readBenchmark ",lexp->toString(true));
+    if (readCommand(lexp)) {
+      continue;
+    }
 
     LispListReader ibRdr(lexp);
-
-    if (ibRdr.tryAcceptAtom("set-logic")) {
-      if (_logicSet) {
-        USER_ERROR("set-logic can appear only once in a problem");
+    if (ibRdr.tryAcceptAtom("check-sat")) {
+      if (bRdr.hasNext()) {
+        checkEntryAfterCheckSat(bRdr.readNext());
       }
-      readLogic(ibRdr.readAtom());
-      ibRdr.acceptEOL();
-      continue;
+      break;
     }
 
-    if (ibRdr.tryAcceptAtom("set-info")) {
-
-      if (ibRdr.tryAcceptAtom(":status")) {
-        _statusStr = ibRdr.readAtom();
-        ibRdr.acceptEOL();
-        continue;
-      }
+    ALWAYS(ibRdr.tryAcceptAtom("exit"));
+    bRdr.acceptEOL();
+    break;
+  }
+}
 
-      if (ibRdr.tryAcceptAtom(":source")) {
-        _sourceInfo = ibRdr.readAtom();
-        ibRdr.acceptEOL();
-        continue;
-      }
+/**
+ * Warn if @b lexp, the entry following check-sat, is not exit, since
+ * everything after check-sat is ignored.
+ */
+void SMTLIB2::checkEntryAfterCheckSat(LExpr* lexp)
+{
+  CALL("SMTLIB2::checkEntryAfterCheckSat");
 
-      // ignore unknown info
-      ibRdr.readAtom();
-      ibRdr.readAtom();
-      ibRdr.acceptEOL();
-      continue;
+  if (!lexp->isList()) {
+    USER_ERROR("<list> expected, <atom> found: "+lexp->toString());
+  }
+  LispListReader exitRdr(lexp);
+  if (!exitRdr.tryAcceptAtom("exit")) {
+    if(env.options->mode()!=Options::Mode::SPIDER) {
+      env.beginOutput();
+      env.out() << "% Warning: check-sat is not the last entry. Skipping the rest!" << endl;
+      env.endOutput();
     }
+  }
+}
 
-    if (ibRdr.tryAcceptAtom("declare-sort")) {
-      vstring name = ibRdr.readAtom();
-      vstring arity;
-      if (!ibRdr.tryReadAtom(arity)) {
-        USER_ERROR("Unspecified arity while declaring sort: "+name);
-      }
+/**
+ * Process a single top-level entry of a benchmark.
+ *
+ * Return false without doing anything if the entry is check-sat or exit,
+ * i.e. if the rest of the benchmark is not to be read.
+ */
+bool SMTLIB2::readCommand(LExpr* lexp)
+{
+  CALL("SMTLIB2::readCommand");
 
-      readDeclareSort(name,arity);
+  LOG2("readCommand ",lexp->toString(true));
 
-      ibRdr.acceptEOL();
+  LispListReader ibRdr(lexp);
 
-      continue;
+  if (ibRdr.tryAcceptAtom("set-logic")) {
+    if (_logicSet) {
+      USER_ERROR("set-logic can appear only once in a problem");
     }
+    readLogic(ibRdr.readAtom());
+    ibRdr.acceptEOL();
+    return true;
+  }
 
-    if (ibRdr.tryAcceptAtom("define-sort")) {
-      vstring name = ibRdr.readAtom();
-      LExprList* args = ibRdr.readList();
-      LExpr* body = ibRdr.readNext();
+  if (ibRdr.tryAcceptAtom("set-info")) {
 
-      readDefineSort(name,args,body);
+    if (ibRdr.tryAcceptAtom(":status")) {
+      _statusStr = ibRdr.readAtom();
+      ibRdr.acceptEOL();
+      return true;
+    }
 
+    if (ibRdr.tryAcceptAtom(":source")) {
+      _sourceInfo = ibRdr.readAtom();
       ibRdr.acceptEOL();
+      return true;
+    }
 
-      continue;
+    // ignore unknown info
+    ibRdr.readAtom();
+    ibRdr.readAtom();
+    ibRdr.acceptEOL();
+    return true;
+  }
+
+  if (ibRdr.tryAcceptAtom("declare-sort")) {
+    vstring name = ibRdr.readAtom();
+    vstring arity;
+    if (!ibRdr.tryReadAtom(arity)) {
+      USER_ERROR("Unspecified arity while declaring sort: "+name);
     }
 
-    if (ibRdr.tryAcceptAtom("declare-fun")) {
-      vstring name = ibRdr.readAtom();
-      LExprList* iSorts = ibRdr.readList();
-      LExpr* oSort = ibRdr.readNext();
+    readDeclareSort(name,arity);
 
-      readDeclareFun(name,iSorts,oSort);
+    ibRdr.acceptEOL();
 
-      ibRdr.acceptEOL();
+    return true;
+  }
 
-      continue;
-    }
+  if (ibRdr.tryAcceptAtom("define-sort")) {
+    vstring name = ibRdr.readAtom();
+    LExprList* args = ibRdr.readList();
+    LExpr* body = ibRdr.readNext();
 
-    if (ibRdr.tryAcceptAtom("declare-datatypes")) {
-      LExprList* sorts = ibRdr.readList();
-      LExprList* datatypes = ibRdr.readList();
+    readDefineSort(name,args,body);
 
-      readDeclareDatatypes(sorts, datatypes, false);
+    ibRdr.acceptEOL();
 
-      ibRdr.acceptEOL();
+    return true;
+  }
 
-      continue;
-    }
+  if (ibRdr.tryAcceptAtom("declare-fun")) {
+    vstring name = ibRdr.readAtom();
+    LExprList* iSorts = ibRdr.readList();
+    LExpr* oSort = ibRdr.readNext();
 
-    if (ibRdr.tryAcceptAtom("declare-codatatypes")) {
-      LExprList* sorts = ibRdr.readList();
-      LExprList* datatypes = ibRdr.readList();
+    readDeclareFun(name,iSorts,oSort);
 
-      readDeclareDatatypes(sorts, datatypes, true);
+    ibRdr.acceptEOL();
 
-      ibRdr.acceptEOL();
+    return true;
+  }
 
-      continue;
-    }
-    
-    if (ibRdr.tryAcceptAtom("declare-const")) {
-      vstring name = ibRdr.readAtom();
-      LExpr* oSort = ibRdr.readNext();
+  if (ibRdr.tryAcceptAtom("declare-datatypes")) {
+    LExprList* sorts = ibRdr.readList();
+    LExprList* datatypes = ibRdr.readList();
 
-      readDeclareFun(name,nullptr,oSort);
+    readDeclareDatatypes(sorts, datatypes, false);
 
-      ibRdr.acceptEOL();
+    ibRdr.acceptEOL();
 
-      continue;
-    }
+    return true;
+  }
 
-    if (ibRdr.tryAcceptAtom("define-fun")) {
-      vstring name = ibRdr.readAtom();
-      LExprList* iArgs = ibRdr.readList();
-      LExpr* oSort = ibRdr.readNext();
-      LExpr* body = ibRdr.readNext();
+  if (ibRdr.tryAcceptAtom("declare-codatatypes")) {
+    LExprList* sorts = ibRdr.readList();
+    LExprList* datatypes = ibRdr.readList();
 
-      readDefineFun(name,iArgs,oSort,body);
+    readDeclareDatatypes(sorts, datatypes, true);
 
-      ibRdr.acceptEOL();
+    ibRdr.acceptEOL();
 
-      continue;
-    }
+    return true;
+  }
+  
+  if (ibRdr.tryAcceptAtom("declare-const")) {
+    vstring name = ibRdr.readAtom();
+    LExpr* oSort = ibRdr.readNext();
 
-    if (ibRdr.tryAcceptAtom("assert")) {
-      readAssert(ibRdr.readNext());
+    readDeclareFun(name,nullptr,oSort);
 
-      ibRdr.acceptEOL();
+    ibRdr.acceptEOL();
 
-      continue;
-    }
+    return true;
+  }
 
-    if (ibRdr.tryAcceptAtom("assert-not")) {
-      readAssertNot(ibRdr.readNext());
+  if (ibRdr.tryAcceptAtom("define-fun")) {
+    vstring name = ibRdr.readAtom();
+    LExprList* iArgs = ibRdr.readList();
+    LExpr* oSort = ibRdr.readNext();
+    LExpr* body = ibRdr.readNext();
 
-      ibRdr.acceptEOL();
+    readDefineFun(name,iArgs,oSort,body);
 
-      continue;
-    }
+    ibRdr.acceptEOL();
 
-    // not an official SMTLIB command
-    if (ibRdr.tryAcceptAtom("color-symbol")) {
-      vstring symbol = ibRdr.readAtom();
+    return true;
+  }
 
-      if (ibRdr.tryAcceptAtom(":left")) {
-        colorSymbol(symbol, Color::COLOR_LEFT);
-      } else if (ibRdr.tryAcceptAtom(":right")) {
-        colorSymbol(symbol, Color::COLOR_RIGHT);
-      } else {
-        USER_ERROR("'"+ibRdr.readAtom()+"' is not a color keyword");
-      }
+  if (ibRdr.tryAcceptAtom("assert")) {
+    readAssert(ibRdr.readNext());
 
-      ibRdr.acceptEOL();
+    ibRdr.acceptEOL();
 
-      continue;
-    }
+    return true;
+  }
 
-    if (ibRdr.tryAcceptAtom("check-sat")) {
-      if (bRdr.hasNext()) {
-        LispListReader exitRdr(bRdr.readList());
-        if (!exitRdr.tryAcceptAtom("exit")) {
-          if(env.options->mode()!=Options::Mode::SPIDER) {
-            env.beginOutput();
-            env.out() << "% Warning: check-sat is not the last entry. Skipping the rest!" << endl;
-            env.endOutput();
-          }
-        }
-      }
-      break;
-    }
+  if (ibRdr.tryAcceptAtom("assert-not")) {
+    readAssertNot(ibRdr.readNext());
 
-    if (ibRdr.tryAcceptAtom("exit")) {
-      bRdr.acceptEOL();
-      break;
-    }
+    ibRdr.acceptEOL();
 
-    if (ibRdr.tryAcceptAtom("reset")) {
-      LOG1("ignoring reset");
-      continue;
-    }
+    return true;
+  }
 
-    if (ibRdr.tryAcceptAtom("set-option")) {
-      LOG2("ignoring set-option", ibRdr.readAtom());
-      continue;
-    }
+  // not an official SMTLIB command
+  if (ibRdr.tryAcceptAtom("color-symbol")) {
+    vstring symbol = ibRdr.readAtom();
 
-    if (ibRdr.tryAcceptAtom("push")) {
-      LOG1("ignoring push");
-      continue;
+    if (ibRdr.tryAcceptAtom(":left")) {
+      colorSymbol(symbol, Color::COLOR_LEFT);
+    } else if (ibRdr.tryAcceptAtom(":right")) {
+      colorSymbol(symbol, Color::COLOR_RIGHT);
+    } else {
+      USER_ERROR("'"+ibRdr.readAtom()+"' is not a color keyword");
     }
 
-    if (ibRdr.tryAcceptAtom("get-info")) {
-      LOG2("ignoring get-info", ibRdr.readAtom());
-      continue;
-    }
+    ibRdr.acceptEOL();
 
-    USER_ERROR("unrecognized entry "+ibRdr.readAtom());
+    return true;
   }
+
+  if (ibRdr.lookAheadAtom("check-sat") || ibRdr.lookAheadAtom("exit")) {
+    return false;
+  }
+
+  if (ibRdr.tryAcceptAtom("reset")) {
+    LOG1("ignoring reset");
+    return true;
+  }
+
+  if (ibRdr.tryAcceptAtom("set-option")) {
+    LOG2("ignoring set-option", ibRdr.readAtom());
+    return true;
+  }
+
+  if (ibRdr.tryAcceptAtom("push")) {
+    LOG1("ignoring push");
+    return true;
+  }
+
+  if (ibRdr.tryAcceptAtom("get-info")) {
+    LOG2("ignoring get-info", ibRdr.readAtom());
+    return true;
+  }
+
+  USER_ERROR("unrecognized entry "+ibRdr.readAtom());
 }
 
 //  ----------------------------------------------------------------------
@@ -454,6 +454,12 @@ private:
    * Toplevel parsing dispatch for a benchmark.
    */
   void readBenchmark(LExprList* bench);
+
+  /**
+   * Parsing dispatch for a single toplevel entry of a benchmark.
+   */
+  bool readCommand(LExpr* lexp);
+  void checkEntryAfterCheckSat(LExpr* lexp);
 };
 
 }
@@ -616,15 +616,22 @@ private:
 
   /**
    * Get the next characters at the position pos.
+   *
+   * Characters are taken directly from the stream buffer of the current input:
+   * istream::get() constructs a sentry object for every character, which
+   * dominates lexing time on large axiom files pulled in by include().
    */
   inline char getChar(int pos)
   {
     CALL("TPTP::getChar");
 
-    while (_cend <= pos) {
-      int c = _in->get();
-      //      if (c == -1) { cout << "<EOF>"; } else {cout << char(c);}
-      _chars[_cend++] = c == -1 ? 0 : c;
+    if (_cend <= pos) {
+      streambuf* buf = _in->rdbuf();
+      while (_cend <= pos) {
+        int c = buf->sbumpc();
+        //      if (c == EOF) { cout << "<EOF>"; } else {cout << char(c);}
+        _chars[_cend++] = c == EOF ? 0 : c;
+      }
     }
     return _chars[pos];
   } // getChar
@@ -29,7 +29,8 @@ namespace SAT
 {
 
 MinimizingSolver::MinimizingSolver(SATSolver* inner)
- : _varCnt(0), _inner(inner), _assignmentValid(false), _heap(CntComparator(_unsClCnt))
+ : _varCnt(0), _inner(inner), _assignmentValid(false), _innerTracksChanges(true),
+   _heap(CntComparator(_unsClCnt))
 {
   CALL("MinimizingSolver::MinimizingSolver");
 }
@@ -46,6 +47,7 @@ void MinimizingSolver::ensureVarCount(unsigned newVarCnt)
   _asgn.expand(newVarCnt+1);
   _watcher.expand(newVarCnt+1);
   _unsClCnt.expand(newVarCnt+1, 0);
+  _changedMarks.expand(newVarCnt+1, false);
   _heap.elMap().expand(newVarCnt+1);
   _clIdx.expand(newVarCnt+1);
   _assignmentValid = false;
@@ -100,6 +102,37 @@ SATSolver::VarAssignment MinimizingSolver::getAssignment(unsigned var)
   return _asgn[var] ? SATSolver::TRUE : SATSolver::FALSE;
 }
 
+/**
+ * The reported assignment of a variable can only change when its value
+ * in the inner solver (or its zero-implied status) changes, or when it
+ * stops being a don't-care by being selected.
+ */
+bool MinimizingSolver::collectChangedVariables(Stack<unsigned>& res)
+{
+  CALL("MinimizingSolver::collectChangedVariables");
+
+  if(!_assignmentValid) {
+    updateAssignment();
+  }
+  if(!_innerTracksChanges) {
+    return false;
+  }
+  while(_changedVars.isNonEmpty()) {
+    unsigned var = _changedVars.pop();
+    _changedMarks[var] = false;
+    res.push(var);
+  }
+  return true;
+}
+
+void MinimizingSolver::noteChanged(unsigned var)
+{
+  if(!_changedMarks[var]) {
+    _changedMarks[var] = true;
+    _changedVars.push(var);
+  }
+}
+
 bool MinimizingSolver::isZeroImplied(unsigned var)
 {
   CALL("MinimizingSolver::isZeroImplied");
@@ -118,6 +151,8 @@ void MinimizingSolver::selectVariable(unsigned var)
   CALL("MinimizingSolver::selectVariable");  
   ASS_G(var,0); ASS_LE(var,_varCnt);
   ASS_G(_unsClCnt[var],0);
+
+  noteChanged(var);
   
   SATClauseStack& satisfied = _clIdx[var];
   SATClauseStack& watch = _watcher[var];
@@ -153,7 +188,9 @@ void MinimizingSolver::putIntoIndex(SATClause* cl)
 
     if (lit.polarity() == _asgn[var]) {
       _clIdx[var].push(cl);
-      _unsClCnt[var]++;
+      if (_unsClCnt[var]++ == 0) {
+        _heapCandidates.push(var);
+      }
     }
   }
 }
@@ -191,11 +228,13 @@ void MinimizingSolver::processUnprocessedAndFillHeap()
     }
   }
   
-  for(unsigned var=1; var<=_varCnt; var++) {
+  // all the counters are zero after the previous update, so only
+  // the variables that got a clause above can have a non-zero one
+  while(_heapCandidates.isNonEmpty()) {
+    unsigned var = _heapCandidates.pop();
     ASS(!_heap.contains(var));
-    if(_unsClCnt[var]>0) {            
-      _heap.addToEnd(var);      
-    }
+    ASS_G(_unsClCnt[var],0);
+    _heap.addToEnd(var);
   }
   _heap.heapify();    
 }
@@ -208,7 +247,21 @@ void MinimizingSolver::processInnerAssignmentChanges()
 {
   CALL("MinimizingSolver::processInnerAssignmentChanges");
 
-  for(unsigned v=1; v<=_varCnt; v++) {
+  static Stack<unsigned> vars;
+  vars.reset();
+  _innerTracksChanges = _inner->collectChangedVariables(vars);
+  if(!_innerTracksChanges) {
+    for(unsigned v=1; v<=_varCnt; v++) {
+      vars.push(v);
+    }
+  }
+
+  while(vars.isNonEmpty()) {
+    unsigned v = vars.pop();
+    ASS_LE(v,_varCnt);
+    if(_innerTracksChanges) {
+      noteChanged(v);
+    }
     VarAssignment va = _inner->getAssignment(v);
     bool changed;
     switch(va) {
@@ -63,6 +63,7 @@ public:
   virtual Status solve(unsigned conflictCountLimit) override;
   
   virtual VarAssignment getAssignment(unsigned var) override;
+  virtual bool collectChangedVariables(Stack<unsigned>& res) override;
   virtual bool isZeroImplied(unsigned var) override;
   virtual void collectZeroImplied(SATLiteralStack& acc) override { _inner->collectZeroImplied(acc); }
   virtual SATClause* getZeroImpliedCertificate(unsigned var) override { return _inner->getZeroImpliedCertificate(var); }
@@ -96,6 +97,7 @@ private:
   }
   
   void selectVariable(unsigned var);
+  void noteChanged(unsigned var);
 
   bool tryPuttingToAnExistingWatch(SATClause* cl);
   void putIntoIndex(SATClause* cl);
@@ -113,6 +115,24 @@ private:
    */
   bool _assignmentValid;
 
+  /**
+   * True if the inner solver reports its changed variables,
+   * so that we do not need to look at all of them
+   */
+  bool _innerTracksChanges;
+
+  /**
+   * Variables whose reported assignment may have changed since the last
+   * call to collectChangedVariables, and marks for those in the stack
+   */
+  Stack<unsigned> _changedVars;
+  DArray<bool> _changedMarks;
+
+  /**
+   * Variables with _unsClCnt greater than zero, to be put on the heap
+   */
+  Stack<unsigned> _heapCandidates;
+
   /**
    * Clauses of which we yet need to ensure they are satisfied
    *
@@ -36,7 +36,7 @@ using namespace Lib;
 using namespace Minisat;
   
 MinisatInterfacing::MinisatInterfacing(const Shell::Options& opts, bool generateProofs):
-  _status(SATISFIABLE)
+  _status(SATISFIABLE), _reportedAssigns(0)
 {
   CALL("MinisatInterfacing::MinisatInterfacing");
    
@@ -181,6 +181,52 @@ SATSolver::VarAssignment MinisatInterfacing::getAssignment(unsigned var)
   }
 }
 
+/**
+ * From the first call on, Minisat notes the variables whose model value
+ * changed in every solve. The zero implied variables are at the start
+ * of its trail, where they are only ever added.
+ */
+bool MinisatInterfacing::collectChangedVariables(Stack<unsigned>& res)
+{
+  CALL("MinisatInterfacing::collectChangedVariables");
+  ASS_EQ(_status, SATISFIABLE);
+
+  if (!_solver.track_model_changes) {
+    _solver.track_model_changes = true;
+    for (Minisat::Var v = 0; v < _solver.nVars(); v++) {
+      res.push(minisatVar2Vampire(v));
+    }
+    _reportedAssigns = _solver.nAssigns();
+    return true;
+  }
+
+  unsigned firstNew = res.size();
+  _changedMarks.expand(_solver.nVars(), false);
+
+  Minisat::vec<Minisat::Var>& modelChanges = _solver.modelChanges;
+  for (int i = 0; i < modelChanges.size(); i++) {
+    noteChanged(modelChanges[i], res);
+  }
+  modelChanges.clear();
+
+  for (; _reportedAssigns < _solver.nAssigns(); _reportedAssigns++) {
+    noteChanged(Minisat::var(_solver.assignedLit(_reportedAssigns)), res);
+  }
+
+  for (unsigned i = firstNew; i < res.size(); i++) {
+    _changedMarks[vampireVar2Minisat(res[i])] = false;
+  }
+  return true;
+}
+
+void MinisatInterfacing::noteChanged(Minisat::Var mvar, Stack<unsigned>& res)
+{
+  if (!_changedMarks[mvar]) {
+    _changedMarks[mvar] = true;
+    res.push(minisatVar2Vampire(mvar));
+  }
+}
+
 bool MinisatInterfacing::isZeroImplied(unsigned var)
 {
   CALL("MinisatInterfacing::isZeroImplied");
@@ -27,6 +27,8 @@
 #include "SATLiteral.hpp"
 #include "SATClause.hpp"
 
+#include "Lib/DArray.hpp"
+
 #include "Minisat/core/Solver.h"
 
 namespace SAT{
@@ -63,6 +65,8 @@ public:
    */
   virtual VarAssignment getAssignment(unsigned var) override;
 
+  virtual bool collectChangedVariables(Stack<unsigned>& res) override;
+
   /**
    * If status is @c SATISFIABLE, return 0 if the assignment of @c var is
    * implied only by unit propagation (i.e. does not depend on any decisions)
@@ -160,6 +164,12 @@ private:
   Status _status;
   Minisat::vec<Minisat::Lit> _assumptions;  
   Minisat::Solver _solver;
+
+  /** the number of zero implied variables reported by collectChangedVariables */
+  int _reportedAssigns;
+  /** the variables already added to the result of collectChangedVariables */
+  DArray<bool> _changedMarks;
+  void noteChanged(Minisat::Var mvar, Stack<unsigned>& res);
 };
 
 }//end SAT namespace
@@ -44,8 +44,8 @@ using namespace Minisat;
 
 const unsigned MinisatInterfacingNewSimp::VAR_MAX = std::numeric_limits<Minisat::Var>::max() / 2;
   
-MinisatInterfacingNewSimp::MinisatInterfacingNewSimp(const Shell::Options& opts, bool generateProofs):
-  _status(SATISFIABLE)
+MinisatInterfacingNewSimp::MinisatInterfacingNewSimp(const Shell::Options& opts, bool generateProofs, bool incremental):
+  _status(SATISFIABLE), _generateProofs(generateProofs), _incremental(incremental)
 {
   CALL("MinisatInterfacingNewSimp::MinisatInterfacingNewSimp");
    
@@ -79,7 +79,10 @@ void MinisatInterfacingNewSimp::ensureVarCount(unsigned newVarCnt)
   
   try{
     while(_solver.nVars() < (int)newVarCnt) {
-      _solver.newVar();
+      Minisat::Var v = _solver.newVar();
+      if (_incremental) {
+        _solver.setFrozen(v,true);
+      }
     }
   } catch (Minisat::OutOfMemoryException&){
     reportMinisatOutOfMemory();
@@ -88,9 +91,13 @@ void MinisatInterfacingNewSimp::ensureVarCount(unsigned newVarCnt)
 
 unsigned MinisatInterfacingNewSimp::newVar() 
 {
-  CALL("MinisatInterfacingNewSimp::ensureVarCount");
+  CALL("MinisatInterfacingNewSimp::newVar");
   
-  return minisatVar2Vampire(_solver.newVar());
+  Minisat::Var v = _solver.newVar();
+  if (_incremental) {
+    _solver.setFrozen(v,true);
+  }
+  return minisatVar2Vampire(v);
 }
 
 SATSolver::Status MinisatInterfacingNewSimp::solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool)
@@ -136,7 +143,8 @@ void MinisatInterfacingNewSimp::solveModuloAssumptionsAndSetStatus(unsigned conf
     //cout << "Before: vars " << bef << ", non-unit clauses " << _solver.nClauses() << endl;
 
     _solver.setConfBudget(conflictCountLimit); // treating UINT_MAX as \infty
-    lbool res = _solver.solveLimited(_assumptions,true,true);
+    // in the incremental mode the simplifier is kept for the next call
+    lbool res = _solver.solveLimited(_assumptions,true,!_incremental);
 
     //cout << "After: vars " << bef - _solver.eliminated_vars << ", non-unit clauses " << _solver.nClauses() << endl;
   
@@ -164,6 +172,11 @@ void MinisatInterfacingNewSimp::addClause(SATClause* cl)
   
   ASS_EQ(_assumptions.size(),0);
 
+  if (_generateProofs) {
+    // store to later generate the refutation
+    PrimitiveProofRecordingSATSolver::addClause(cl);
+  }
+
   try {
     static vec<Lit> mcl;
     mcl.clear();
@@ -36,7 +36,7 @@
 
 namespace SAT{
 
-class MinisatInterfacingNewSimp : public SATSolverWithAssumptions
+class MinisatInterfacingNewSimp : public PrimitiveProofRecordingSATSolver
 {
 public:
   CLASS_NAME(MinisatInterfacingNewSimp);
@@ -44,7 +44,12 @@ public:
   
   static const unsigned VAR_MAX;
 
-	MinisatInterfacingNewSimp(const Shell::Options& opts, bool generateProofs=false);
+  /**
+   * With @c generateProofs the added clauses are kept as premises of the refutation.
+   * With @c incremental clauses may mention any variable after a call to solve,
+   * so variables are never eliminated and the simplifier stays on between calls.
+   */
+	MinisatInterfacingNewSimp(const Shell::Options& opts, bool generateProofs=false, bool incremental=false);
 
   /**
    * Can be called only when all assumptions are retracted
@@ -126,7 +131,13 @@ public:
   
   Status solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool) override;
 
-  virtual SATClause* getRefutation() override { ASSERTION_VIOLATION; }
+  virtual SATClause* getRefutation() override {
+    ASS(_generateProofs);
+    return PrimitiveProofRecordingSATSolver::getRefutation();
+  }
+  virtual SATClauseList* getRefutationPremiseList() override {
+    return _generateProofs ? PrimitiveProofRecordingSATSolver::getRefutationPremiseList() : SATClauseList::empty();
+  }
 
   static void reportMinisatOutOfMemory();
 
@@ -153,6 +164,8 @@ protected:
   
 private:
   Status _status;
+  bool _generateProofs;
+  bool _incremental;
   Minisat::vec<Minisat::Lit> _assumptions;  
   Minisat::SimpSolver _solver;
 
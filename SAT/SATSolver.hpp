@@ -101,6 +101,17 @@ public:
    */
   virtual VarAssignment getAssignment(unsigned var) = 0;
 
+  /**
+   * If status is @c SATISFIABLE, push into @c res the variables whose
+   * assignment or zero-implied status may have changed since the previous
+   * call (on the first call, all the variables). A variable may be pushed
+   * more than once.
+   *
+   * Return false if the solver does not keep track of the changes. The
+   * caller then has to look at every variable.
+   */
+  virtual bool collectChangedVariables(Stack<unsigned>& res) { return false; }
+
   /**
    * If status is @c SATISFIABLE, return true if the assignment of @c var is
    * implied only by unit propagation (i.e. does not depend on any decisions)
@@ -136,10 +136,14 @@ void TWLSolver::ensureVarCount(unsigned newVarCnt)
   _assignmentLevels.expand(newVarCnt+1);
   _assignmentPremises.expand(newVarCnt+1, 0);
   _lastAssignments.expand(newVarCnt+1, AS_UNDEFINED);
+  _changedMarks.expand(newVarCnt+1, false);
   _propagationScheduled.expand(newVarCnt+1);
 
   _windex.expand((newVarCnt+1)*2);
 
+  for(unsigned var=_varCnt+1; var<=newVarCnt; var++) {
+    noteChanged(var);
+  }
   _varCnt=newVarCnt;
 
   _variableSelector->ensureVarCount(newVarCnt);
@@ -155,9 +159,11 @@ unsigned TWLSolver::newVar()
   _assignmentLevels.expand(_varCnt+1);
   _assignmentPremises.expand(_varCnt+1, 0);
   _lastAssignments.expand(_varCnt+1, AS_UNDEFINED);
+  _changedMarks.expand(_varCnt+1, false);
   _propagationScheduled.expand(_varCnt+1);
 
   _windex.expand((_varCnt+1)*2);
+  noteChanged(_varCnt);
 
   _variableSelector->ensureVarCount(_varCnt);
   
@@ -865,6 +871,16 @@ void TWLSolver::setAssignment(unsigned var, unsigned polarity)
 
   _assignment[var] = static_cast<AsgnVal>(polarity);
   _lastAssignments[var] = static_cast<AsgnVal>(polarity);
+  noteChanged(var);
+}
+
+/** Record that the assignment of @c var changed, for collectChangedVariables */
+void TWLSolver::noteChanged(unsigned var)
+{
+  if(!_changedMarks[var]) {
+    _changedMarks[var] = true;
+    _changedVars.push(var);
+  }
 }
 
 void TWLSolver::makeAssumptionAssignment(SATLiteral lit)
@@ -919,6 +935,7 @@ void TWLSolver::undoAssignment(unsigned var)
 
   _assignment[var] = AS_UNDEFINED;
   _assignmentPremises[var] = 0;
+  noteChanged(var);
 
   _variableSelector->onVariableUnassigned(var);
 }
@@ -1282,6 +1299,19 @@ SATSolver::VarAssignment TWLSolver::getAssignment(unsigned var)
   }
 }
 
+bool TWLSolver::collectChangedVariables(Stack<unsigned>& res)
+{
+  CALL("TWLSolver::collectChangedVariables");
+  ASS(_status == SATISFIABLE || _status == UNKNOWN);
+
+  while(_changedVars.isNonEmpty()) {
+    unsigned var = _changedVars.pop();
+    _changedMarks[var] = false;
+    res.push(var);
+  }
+  return true;
+}
+
 bool TWLSolver::isZeroImplied(unsigned var)
 {
   CALL("TWLSolver::isZeroImplied");
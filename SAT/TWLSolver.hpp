@@ -102,6 +102,7 @@ public:
 
 
   virtual VarAssignment getAssignment(unsigned var) override;
+  virtual bool collectChangedVariables(Stack<unsigned>& res) override;
   virtual bool isZeroImplied(unsigned var) override;
   virtual void collectZeroImplied(SATLiteralStack& acc) override;
   virtual SATClause* getZeroImpliedCertificate(unsigned var) override;
@@ -187,6 +188,7 @@ private:
   void makeChoiceAssignment(unsigned var, unsigned polarity);
   void makeForcedAssignment(SATLiteral lit, SATClause* premise);
   void undoAssignment(unsigned var);
+  void noteChanged(unsigned var);
 
   enum ClauseVisitResult {
     /** Visited clause is a conflict clause */
@@ -302,6 +304,11 @@ private:
   /** truth values that were assigned to each variable most recently */
   DArray<PackedAsgnVal> _lastAssignments;
 
+  /** Variables (un)assigned since the last call to collectChangedVariables */
+  Stack<unsigned> _changedVars;
+  /** true for the variables in _changedVars */
+  DArray<bool> _changedMarks;
+
   /**
    * Stack of learnt clauses
    *
@@ -0,0 +1,325 @@
+/*
+ * File TraceRecordingSolver.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file TraceRecordingSolver.cpp
+ * Implements class TraceRecordingSolver.
+ */
+
+#include <fstream>
+#include <unistd.h>
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Exception.hpp"
+#include "Lib/Int.hpp"
+#include "Lib/Sys/Multiprocessing.hpp"
+
+#include "Shell/Options.hpp"
+
+#include "SATClause.hpp"
+
+#include "TraceRecordingSolver.hpp"
+
+namespace SAT
+{
+
+void SATTrace::writeNumber(ostream& out, unsigned num)
+{
+  CALL("SATTrace::writeNumber");
+
+  while (num >= 0x80) {
+    out.put(static_cast<char>((num & 0x7F) | 0x80));
+    num >>= 7;
+  }
+  out.put(static_cast<char>(num));
+}
+
+/**
+ * Read a number written by writeNumber into @b num.
+ * Return false if the stream ended before the number was complete.
+ */
+bool SATTrace::readNumber(istream& in, unsigned& num)
+{
+  CALL("SATTrace::readNumber");
+
+  num = 0;
+  unsigned shift = 0;
+  int c;
+  while ((c = in.get()) != EOF) {
+    num |= static_cast<unsigned>(c & 0x7F) << shift;
+    if (!(c & 0x80)) {
+      return true;
+    }
+    shift += 7;
+  }
+  return false;
+}
+
+ostream* TraceRecordingSolver::s_out = 0;
+vstring* TraceRecordingSolver::s_fileName = 0;
+unsigned TraceRecordingSolver::s_solverCnt = 0;
+
+TraceRecordingSolver::TraceRecordingSolver(SATSolverWithAssumptions* inner, vstring fileName)
+ : _inner(inner), _id(s_solverCnt++)
+{
+  CALL("TraceRecordingSolver::TraceRecordingSolver");
+
+  if (!s_out) {
+    if (!s_fileName) {
+      start(fileName);
+    }
+    BYPASSING_ALLOCATOR;
+
+    ofstream* out = new ofstream(s_fileName->c_str(), ios::binary | ios::trunc);
+    if (out->fail()) {
+      delete out;
+      USER_ERROR("Cannot open SAT trace file: "+*s_fileName);
+    }
+    *out << SATTrace::magic();
+    s_out = out;
+  }
+  _out = s_out;
+  startRecord(SATTrace::OP_NEW_SOLVER);
+}
+
+/**
+ * Set the name of the trace file. Called before any process is forked,
+ * so that the traces of forked processes go to files of their own.
+ */
+void TraceRecordingSolver::start(vstring fileName)
+{
+  CALL("TraceRecordingSolver::start");
+  ASS(!s_fileName);
+
+  {
+    BYPASSING_ALLOCATOR;
+    s_fileName = new vstring(fileName);
+  }
+  Sys::Multiprocessing::instance()->registerForkHandlers(flushBeforeFork, 0, reopenInChild);
+}
+
+void TraceRecordingSolver::flushBeforeFork()
+{
+  if (s_out) {
+    s_out->flush();
+  }
+}
+
+/**
+ * A forked child writes the solvers it creates into a file named after
+ * its pid. The solvers it inherited stop recording, since the records
+ * of their creation are in the file of the parent.
+ */
+void TraceRecordingSolver::reopenInChild()
+{
+  BYPASSING_ALLOCATOR;
+
+  if (s_out) {
+    // the inherited solvers still point to the stream, so it is closed but not deleted
+    static_cast<ofstream*>(s_out)->close();
+    s_out = 0;
+  }
+  *s_fileName += "." + Int::toString(getpid());
+}
+
+/**
+ * Return @b inner wrapped in a TraceRecordingSolver if the record_sat_trace
+ * option is set, and @b inner itself otherwise.
+ */
+SATSolverWithAssumptions* TraceRecordingSolver::wrapIfRequested(SATSolverWithAssumptions* inner, const Shell::Options& opt)
+{
+  CALL("TraceRecordingSolver::wrapIfRequested");
+
+  vstring fileName = opt.recordSatTrace();
+  if (fileName == "off") {
+    return inner;
+  }
+  return new TraceRecordingSolver(inner, fileName);
+}
+
+void TraceRecordingSolver::startRecord(SATTrace::Operation op)
+{
+  CALL("TraceRecordingSolver::startRecord");
+
+  BYPASSING_ALLOCATOR;
+
+  _out->put(static_cast<char>(op));
+  SATTrace::writeNumber(*_out, _id);
+}
+
+void TraceRecordingSolver::writeClause(SATClause* cl)
+{
+  CALL("TraceRecordingSolver::writeClause");
+
+  BYPASSING_ALLOCATOR;
+
+  unsigned len = cl->length();
+  SATTrace::writeNumber(*_out, len);
+  for (unsigned i = 0; i < len; i++) {
+    SATTrace::writeNumber(*_out, SATTrace::encode((*cl)[i]));
+  }
+}
+
+void TraceRecordingSolver::addClause(SATClause* cl)
+{
+  CALL("TraceRecordingSolver::addClause");
+
+  startRecord(SATTrace::OP_ADD_CLAUSE);
+  writeClause(cl);
+  _inner->addClause(cl);
+}
+
+void TraceRecordingSolver::addClauseIgnoredInPartialModel(SATClause* cl)
+{
+  CALL("TraceRecordingSolver::addClauseIgnoredInPartialModel");
+
+  startRecord(SATTrace::OP_ADD_CLAUSE_IGNORED);
+  writeClause(cl);
+  _inner->addClauseIgnoredInPartialModel(cl);
+}
+
+void TraceRecordingSolver::simplify()
+{
+  CALL("TraceRecordingSolver::simplify");
+
+  startRecord(SATTrace::OP_SIMPLIFY);
+  _inner->simplify();
+}
+
+/**
+ * The answer is written after the inner solver returns and the stream is
+ * flushed, so that a trace cut short by a time limit is still complete up
+ * to the last solve call.
+ */
+SATSolver::Status TraceRecordingSolver::solve(unsigned conflictCountLimit)
+{
+  CALL("TraceRecordingSolver::solve");
+
+  startRecord(SATTrace::OP_SOLVE);
+  Status res = _inner->solve(conflictCountLimit);
+
+  BYPASSING_ALLOCATOR;
+  SATTrace::writeNumber(*_out, conflictCountLimit);
+  _out->put(static_cast<char>(res));
+  _out->flush();
+  return res;
+}
+
+void TraceRecordingSolver::ensureVarCount(unsigned newVarCnt)
+{
+  CALL("TraceRecordingSolver::ensureVarCount");
+
+  startRecord(SATTrace::OP_ENSURE_VAR_COUNT);
+  {
+    BYPASSING_ALLOCATOR;
+    SATTrace::writeNumber(*_out, newVarCnt);
+  }
+  _inner->ensureVarCount(newVarCnt);
+}
+
+unsigned TraceRecordingSolver::newVar()
+{
+  CALL("TraceRecordingSolver::newVar");
+
+  unsigned res = _inner->newVar();
+  startRecord(SATTrace::OP_NEW_VAR);
+
+  BYPASSING_ALLOCATOR;
+  SATTrace::writeNumber(*_out, res);
+  return res;
+}
+
+void TraceRecordingSolver::suggestPolarity(unsigned var, unsigned pol)
+{
+  CALL("TraceRecordingSolver::suggestPolarity");
+
+  startRecord(SATTrace::OP_SUGGEST_POLARITY);
+  {
+    BYPASSING_ALLOCATOR;
+    SATTrace::writeNumber(*_out, var);
+    SATTrace::writeNumber(*_out, pol);
+  }
+  _inner->suggestPolarity(var,pol);
+}
+
+void TraceRecordingSolver::randomizeForNextAssignment(unsigned maxVar)
+{
+  CALL("TraceRecordingSolver::randomizeForNextAssignment");
+
+  startRecord(SATTrace::OP_RANDOMIZE);
+  {
+    BYPASSING_ALLOCATOR;
+    SATTrace::writeNumber(*_out, maxVar);
+  }
+  _inner->randomizeForNextAssignment(maxVar);
+}
+
+void TraceRecordingSolver::addAssumption(SATLiteral lit)
+{
+  CALL("TraceRecordingSolver::addAssumption");
+
+  startRecord(SATTrace::OP_ADD_ASSUMPTION);
+  {
+    BYPASSING_ALLOCATOR;
+    SATTrace::writeNumber(*_out, SATTrace::encode(lit));
+  }
+  _inner->addAssumption(lit);
+}
+
+void TraceRecordingSolver::retractAllAssumptions()
+{
+  CALL("TraceRecordingSolver::retractAllAssumptions");
+
+  startRecord(SATTrace::OP_RETRACT_ASSUMPTIONS);
+  _inner->retractAllAssumptions();
+}
+
+SATSolver::Status TraceRecordingSolver::solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool onlyProperSubusets)
+{
+  CALL("TraceRecordingSolver::solveUnderAssumptions");
+
+  startRecord(SATTrace::OP_SOLVE_UNDER_ASSUMPTIONS);
+  Status res = _inner->solveUnderAssumptions(assumps, conflictCountLimit, onlyProperSubusets);
+
+  BYPASSING_ALLOCATOR;
+  SATTrace::writeNumber(*_out, conflictCountLimit);
+  _out->put(static_cast<char>(onlyProperSubusets));
+  SATTrace::writeNumber(*_out, assumps.size());
+  for (unsigned i = 0; i < assumps.size(); i++) {
+    SATTrace::writeNumber(*_out, SATTrace::encode(assumps[i]));
+  }
+  _out->put(static_cast<char>(res));
+  _out->flush();
+  return res;
+}
+
+const SATLiteralStack& TraceRecordingSolver::explicitlyMinimizedFailedAssumptions(unsigned conflictCountLimit, bool randomize)
+{
+  CALL("TraceRecordingSolver::explicitlyMinimizedFailedAssumptions");
+
+  startRecord(SATTrace::OP_MINIMIZE_FAILED_ASSUMPTIONS);
+  const SATLiteralStack& res = _inner->explicitlyMinimizedFailedAssumptions(conflictCountLimit, randomize);
+
+  BYPASSING_ALLOCATOR;
+  SATTrace::writeNumber(*_out, conflictCountLimit);
+  _out->put(static_cast<char>(randomize));
+  SATTrace::writeNumber(*_out, res.size());
+  _out->flush();
+  return res;
+}
+
+}
@@ -0,0 +1,151 @@
+/*
+ * File TraceRecordingSolver.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file TraceRecordingSolver.hpp
+ * Defines class TraceRecordingSolver and the SAT trace format.
+ *
+ * A trace is the magic string "VSATTRC1" followed by records. Each record is
+ * an operation byte and the id of the solver it was issued to, followed by the
+ * operands of the operation. All numbers are stored as LEB128 varints and
+ * a literal is stored as 2*var+polarity. Since all the solvers of one process
+ * write to the same file, the records of different solvers may interleave.
+ * Forked processes write into the file name suffixed with their pid.
+ */
+
+#ifndef __TraceRecordingSolver__
+#define __TraceRecordingSolver__
+
+#include <iosfwd>
+
+#include "Forwards.hpp"
+
+#include "Lib/ScopedPtr.hpp"
+#include "Lib/Stack.hpp"
+
+#include "SATSolver.hpp"
+
+namespace SAT {
+
+using namespace Lib;
+
+class SATTrace {
+public:
+  enum Operation {
+    /** a new solver with the given id was created; no operands */
+    OP_NEW_SOLVER = 1,
+    /** operand: the new variable count */
+    OP_ENSURE_VAR_COUNT,
+    /** operand: the variable returned by the recorded solver */
+    OP_NEW_VAR,
+    /** operands: the number of literals and the literals */
+    OP_ADD_CLAUSE,
+    /** like OP_ADD_CLAUSE */
+    OP_ADD_CLAUSE_IGNORED,
+    /** no operands */
+    OP_SIMPLIFY,
+    /** operands: the conflict count limit and the status byte returned */
+    OP_SOLVE,
+    /** operand: the literal */
+    OP_ADD_ASSUMPTION,
+    /** no operands */
+    OP_RETRACT_ASSUMPTIONS,
+    /** operands: the conflict count limit, the onlyProperSubusets flag, the assumptions
+     * (as in OP_ADD_CLAUSE) and the status byte returned */
+    OP_SOLVE_UNDER_ASSUMPTIONS,
+    /** operands: the conflict count limit, the randomize flag and the number of failed
+     * assumptions that remained after minimization */
+    OP_MINIMIZE_FAILED_ASSUMPTIONS,
+    /** operands: the variable and the polarity */
+    OP_SUGGEST_POLARITY,
+    /** operand: the maximal variable */
+    OP_RANDOMIZE
+  };
+
+  static const char* magic() { return "VSATTRC1"; }
+
+  static unsigned encode(SATLiteral lit) { return 2*lit.var()+lit.polarity(); }
+  static SATLiteral decode(unsigned code) { return SATLiteral(code/2,code%2); }
+
+  static void writeNumber(ostream& out, unsigned num);
+  static bool readNumber(istream& in, unsigned& num);
+};
+
+/**
+ * Wrapper that passes every call to the inner solver and writes the calls
+ * that change the state of the solver, together with the answers
+ * of the solve calls, into the trace file shared by all the instances.
+ */
+class TraceRecordingSolver : public SATSolverWithAssumptions {
+public:
+  CLASS_NAME(TraceRecordingSolver);
+  USE_ALLOCATOR(TraceRecordingSolver);
+
+  TraceRecordingSolver(SATSolverWithAssumptions* inner, vstring fileName);
+
+  static void start(vstring fileName);
+  static SATSolverWithAssumptions* wrapIfRequested(SATSolverWithAssumptions* inner, const Shell::Options& opt);
+
+  virtual void addClause(SATClause* cl) override;
+  virtual void addClauseIgnoredInPartialModel(SATClause* cl) override;
+  virtual void simplify() override;
+  virtual Status solve(unsigned conflictCountLimit) override;
+
+  virtual VarAssignment getAssignment(unsigned var) override { return _inner->getAssignment(var); }
+  virtual bool collectChangedVariables(Stack<unsigned>& res) override { return _inner->collectChangedVariables(res); }
+  virtual bool isZeroImplied(unsigned var) override { return _inner->isZeroImplied(var); }
+  virtual void collectZeroImplied(SATLiteralStack& acc) override { _inner->collectZeroImplied(acc); }
+  virtual SATClause* getZeroImpliedCertificate(unsigned var) override { return _inner->getZeroImpliedCertificate(var); }
+
+  virtual void ensureVarCount(unsigned newVarCnt) override;
+  virtual unsigned newVar() override;
+  virtual void suggestPolarity(unsigned var, unsigned pol) override;
+  virtual void randomizeForNextAssignment(unsigned maxVar) override;
+
+  virtual SATClause* getRefutation() override { return _inner->getRefutation(); }
+  virtual SATClauseList* getRefutationPremiseList() override { return _inner->getRefutationPremiseList(); }
+  virtual void recordSource(unsigned var, Literal* lit) override { _inner->recordSource(var,lit); }
+
+  virtual void addAssumption(SATLiteral lit) override;
+  virtual void retractAllAssumptions() override;
+  virtual bool hasAssumptions() const override { return _inner->hasAssumptions(); }
+
+  virtual Status solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool onlyProperSubusets) override;
+  virtual const SATLiteralStack& failedAssumptions() override { return _inner->failedAssumptions(); }
+  virtual const SATLiteralStack& explicitlyMinimizedFailedAssumptions(unsigned conflictCountLimit, bool randomize) override;
+
+private:
+  void startRecord(SATTrace::Operation op);
+  void writeClause(SATClause* cl);
+
+  static void flushBeforeFork();
+  static void reopenInChild();
+
+  ScopedPtr<SATSolverWithAssumptions> _inner;
+  unsigned _id;
+  /** the trace of the process that created the solver */
+  ostream* _out;
+
+  /** the trace of this process, opened when its first solver is created */
+  static ostream* s_out;
+  static vstring* s_fileName;
+  static unsigned s_solverCnt;
+};
+
+}
+
+#endif // __TraceRecordingSolver__
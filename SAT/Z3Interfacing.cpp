@@ -53,7 +53,8 @@ using namespace Lib;
 Z3Interfacing::Z3Interfacing(const Shell::Options& opts,SAT2FO& s2f, bool unsatCoresForAssumptions):
   _varCnt(0), sat2fo(s2f),_status(SATISFIABLE), _solver(_context),
   _model((_solver.check(),_solver.get_model())), _assumptions(_context), _unsatCoreForAssumptions(unsatCoresForAssumptions),
-  _showZ3(opts.showZ3()),_unsatCoreForRefutations(opts.z3UnsatCores())
+  _showZ3(opts.showZ3()),_unsatCoreForRefutations(opts.z3UnsatCores()),
+  _exprs(_context), _literalConditions(_context), _sideConditions(0)
 {
   CALL("Z3Interfacing::Z3Interfacing");
   _solver.reset();
@@ -104,6 +105,28 @@ void Z3Interfacing::addClause(SATClause* cl,bool withGuard)
   _solver.add(z3clause);
 }
 
+void Z3Interfacing::push()
+{
+  CALL("Z3Interfacing::push");
+  BYPASSING_ALLOCATOR;
+
+  _solver.push();
+  _pushMarks.push(_namedVars.size());
+}
+
+void Z3Interfacing::pop()
+{
+  CALL("Z3Interfacing::pop");
+  BYPASSING_ALLOCATOR;
+
+  _solver.pop();
+  unsigned mark = _pushMarks.pop();
+  while(_namedVars.size()>mark) {
+    _namedExpressions.remove(_namedVars.pop());
+  }
+  _status = UNKNOWN;
+}
+
 void Z3Interfacing::addAssumption(SATLiteral lit,bool withGuard)
 {
   CALL("Z3Interfacing::addAssumption");
@@ -379,15 +402,24 @@ z3::expr Z3Interfacing::getz3expr(Term* trm,bool isLit,bool&nameExpression,bool
     if(trm->arity()==0){
       if(symb->integerConstant()){
         IntegerConstantType value = symb->integerValue();
-        return _context.int_val(value.toInner());
+        if(value.fitsInner()){
+          return _context.int_val(value.toInner());
+        }
+        return _context.int_val(value.toString().c_str());
       }
       if(symb->realConstant()){
         RealConstantType value = symb->realValue();
-        return _context.real_val(value.numerator().toInner(),value.denominator().toInner());
+        if(value.numerator().fitsInner() && value.denominator().fitsInner()){
+          return _context.real_val(value.numerator().toInner(),value.denominator().toInner());
+        }
+        return _context.real_val(value.toString().c_str());
       }
       if(symb->rationalConstant()){
         RationalConstantType value = symb->rationalValue();
-        return _context.real_val(value.numerator().toInner(),value.denominator().toInner());
+        if(value.numerator().fitsInner() && value.denominator().fitsInner()){
+          return _context.real_val(value.numerator().toInner(),value.denominator().toInner());
+        }
+        return _context.real_val(value.toString().c_str());
       }
       if(!isLit && env.signature->isFoolConstantSymbol(true,trm->functor())){
         return _context.bool_val(true);
@@ -691,6 +723,62 @@ z3::expr Z3Interfacing::getz3expr(Term* trm,bool isLit,bool&nameExpression,bool
     return e;
 }
 
+/**
+ * Return the translation of the ground literal @b lit. The translation is
+ * done once per literal and remembered, together with the side conditions
+ * (guards and division axioms) asserted while translating it. These are
+ * asserted again on each reuse, since they may have been retracted by pop().
+ */
+z3::expr Z3Interfacing::getLiteralExpr(Literal* lit,bool withGuard)
+{
+  CALL("Z3Interfacing::getLiteralExpr");
+  BYPASSING_ALLOCATOR;
+
+  DHMap<Literal*,unsigned>& cache = withGuard ? _guardedLiteralExprs : _literalExprs;
+  unsigned idx;
+  if(cache.find(lit,idx)) {
+    z3::expr cond = _literalConditions[idx];
+    if(!cond.is_true()) {
+      if(_showZ3){
+        env.beginOutput();
+        env.out() << "[Z3] add (side conditions): " << cond << std::endl;
+        env.endOutput();
+      }
+      _solver.add(cond);
+    }
+    return _exprs[idx];
+  }
+
+  z3::expr_vector conds(_context);
+  _sideConditions = &conds;
+  bool nameExpression = true;
+  try{
+    z3::expr e = getz3expr(lit,true,nameExpression,withGuard);
+    _sideConditions = 0;
+    cache.insert(lit,_exprs.size());
+    _exprs.push_back(e);
+    _literalConditions.push_back(conds.empty() ? _context.bool_val(true) : z3::mk_and(conds));
+    return e;
+  }
+  catch(...){
+    _sideConditions = 0;
+    throw;
+  }
+}
+
+/**
+ * Assert @b e, which is a condition the translation of the current literal relies on
+ */
+void Z3Interfacing::addSideCondition(z3::expr e)
+{
+  CALL("Z3Interfacing::addSideCondition");
+
+  _solver.add(e);
+  if(_sideConditions) {
+    _sideConditions->push_back(e);
+  }
+}
+
 z3::expr Z3Interfacing::getRepresentation(SATLiteral slit,bool withGuard)
 {
   CALL("Z3Interfacing::getRepresentation");
@@ -706,10 +794,11 @@ z3::expr Z3Interfacing::getRepresentation(SATLiteral slit,bool withGuard)
     try{
       // TODO everything is being named!!
       bool nameExpression = true;
-      z3::expr e = getz3expr(lit,true,nameExpression,withGuard);
+      z3::expr e = getLiteralExpr(lit,withGuard);
       //cout << "got rep " << e << endl;
 
       if(nameExpression && _namedExpressions.insert(slit.var())) {
+        _namedVars.push(slit.var());
         z3::expr bname = getNameExpr(slit.var()); 
         //cout << "Naming " << e << " as " << bname << endl;
         z3::expr naming = (bname == e);
@@ -795,7 +884,7 @@ void Z3Interfacing::addIntNonZero(z3::expr t)
 
    z3::expr zero = _context.int_val(0);
 
-  _solver.add(t != zero);
+  addSideCondition(t != zero);
 }
 
 void Z3Interfacing::addRealNonZero(z3::expr t)
@@ -809,7 +898,7 @@ void Z3Interfacing::addRealNonZero(z3::expr t)
     env.out() << "[Z3] add (RealNonZero): " << side << std::endl;
     env.endOutput();
   }
-  _solver.add(side);
+  addSideCondition(side);
 }
 
 /**
@@ -854,28 +943,28 @@ void Z3Interfacing::addTruncatedOperations(z3::expr_vector args, Interpretation
 
     // e1 >= 0 & e2 > 0 -> e2 * q(e1,e2) <= e1 & e2 * q(e1,e2) > e1 - e2
     z3::expr one = implies(( (e1 >= 0) && (e2 > 0) ), ( ( (e2*q_e1_e2) <= e1) && ( (e2*q_e1_e2) > (e1-e2) ) ) );
-    _solver.add(one);
+    addSideCondition(one);
 
     // e1 >= 0 & e2 < 0 -> e2 * q(e1,e2) <= e1 & e2 * q(e1,e2) > e1 + e2
     z3::expr two = implies(( (e1 >=0) && (e2 <0) ), ( (e2*q_e1_e2) <= e1) && ( (e2*q_e1_e2) > (e1+e2) ) );
-    _solver.add(two);
+    addSideCondition(two);
 
     // e1 < 0 & e2 > 0 -> e2 * q(e1,e2) >= e1 & e2 * q(e1,e2) < e1 + e2
     z3::expr three = implies( ((e1<0) && (e2>0)), ( ( (e2*q_e1_e2) >= e1 ) && ( (e2*q_e1_e2) < (e1+e2) ) ) );
-    _solver.add(three);
+    addSideCondition(three);
 
     // e1 < 0 & e2 < 0 -> e2 * q(e1,e2) >= e1 & e2 * q(e1,e2) < e1 - e2
     z3::expr four = implies( ((e1<0) && (e2<0)), ( ((e2*q_e1_e2) >= e1) && ( (e2*q_e1_e2) < (e1-e2) ) ) ); 
-    _solver.add(four);
+    addSideCondition(four);
 
     // e2 != 0 -> e2 * q(e1,e2) + r(e1,e2) = e1
     z3::expr five = implies( (e2!=0), ( ((e2*q_e1_e2)+ r_e1_e2) == e1 ) );
-    _solver.add(five);
+    addSideCondition(five);
   }
   else{
     // e2 != 0 -> e2 * q(e1,e2) + r(e1,e2) = e1
     z3::expr five = implies( (e2!=0), ( ((e2*truncate(e1/e2))+ r_e1_e2) == e1 ) );
-    _solver.add(five);
+    addSideCondition(five);
   }
 }
 /**
@@ -916,16 +1005,16 @@ void Z3Interfacing::addFloorOperations(z3::expr_vector args, Interpretation qi,
 
     // e2 != 0 -> e2*q(e1,e2) <= e1 & e2*q(e1,e2) > e1 - e2 
     z3::expr one = implies( (e2!=0), ( ((e2*q_e1_e2) <= e1) && ((e2*q_e1_e2) > (e1-e2) ) ) );
-     _solver.add(one);
+     addSideCondition(one);
 
     // e2 != 0 -> e2 * q(e1,e2) + r(e1,e2) = e1
     z3::expr five = implies( (e2!=0), ( ((e2*q_e1_e2)+ r_e1_e2) == e1 ) );
-    _solver.add(five);
+    addSideCondition(five);
   }
   else{
     // e2 != 0 -> e2 * q(e1,e2) + r(e1,e2) = e1
     z3::expr five = implies( (e2!=0), ( ((e2*to_real(to_int(e1/e2)))+ r_e1_e2) == e1 ) );
-    _solver.add(five);
+    addSideCondition(five);
   }
 
 }
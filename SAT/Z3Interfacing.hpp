@@ -136,8 +136,19 @@ public:
   void reset(){
     sat2fo.reset();
     _solver.reset();
+    _namedExpressions.reset();
+    _namedVars.reset();
+    _pushMarks.reset();
     _status = UNKNOWN; // I set it to unknown as I do not reset
   }
+
+  /**
+   * Open a backtracking point. The clauses added after it, together with
+   * the definitions of the literals first named after it, are retracted by
+   * the matching call to pop(), while the solver keeps everything added before.
+   */
+  void push();
+  void pop();
 private:
   // just to conform to the interface
   unsigned _varCnt;
@@ -173,6 +184,7 @@ private:
   void addFloorOperations(z3::expr_vector, Interpretation qi, Interpretation ti, unsigned srt);
   void addIntNonZero(z3::expr);
   void addRealNonZero(z3::expr);
+  void addSideCondition(z3::expr);
 
 public:
   // not sure why this one is public
@@ -180,6 +192,7 @@ public:
   Term* evaluateInModel(Term* trm);
 private:
   z3::expr getRepresentation(SATLiteral lit,bool withGuard);
+  z3::expr getLiteralExpr(Literal* lit,bool withGuard);
 
   Status _status;
   z3::context _context;
@@ -193,6 +206,19 @@ private:
   bool _unsatCoreForRefutations;
 
   DHSet<unsigned> _namedExpressions;
+  /** elements of _namedExpressions in the order of naming */
+  Stack<unsigned> _namedVars;
+  /** sizes of _namedVars at the open backtracking points */
+  Stack<unsigned> _pushMarks;
+
+  /** indexes into _exprs of the translated literals, without and with guards */
+  DHMap<Literal*,unsigned> _literalExprs;
+  DHMap<Literal*,unsigned> _guardedLiteralExprs;
+  z3::expr_vector _exprs;
+  /** conjunctions of the side conditions of the elements of _exprs */
+  z3::expr_vector _literalConditions;
+  /** where the side conditions of the literal being translated are collected, or 0 */
+  z3::expr_vector* _sideConditions;
 
   z3::expr getNameExpr(unsigned var){
     vstring name = "v"+Lib::Int::toString(var);
@@ -78,6 +78,10 @@ AWPassiveClauseContainer::AWPassiveClauseContainer(bool isOutermost, const Shell
   ASS_GE(_ageRatio, 0);
   ASS_GE(_weightRatio, 0);
   ASS(_ageRatio > 0 || _weightRatio > 0);
+
+  if (_isOutermost && _opt.saturationAlgorithm() == Options::SaturationAlgorithm::LRS) {
+    _histogram.init(HISTOGRAM_SIZE*HISTOGRAM_SIZE, 0);
+  }
 }
 
 AWPassiveClauseContainer::~AWPassiveClauseContainer()
@@ -193,6 +197,7 @@ void AWPassiveClauseContainer::add(Clause* cl)
     _weightQueue.insert(cl);
   }
   _size++;
+  updateHistogram(cl, 1);
 
   if (_isOutermost)
   {
@@ -224,6 +229,7 @@ void AWPassiveClauseContainer::remove(Clause* cl)
 
   if (wasRemoved) {
     _size--;
+    updateHistogram(cl, -1);
   }
 
   if (_isOutermost)
@@ -254,6 +260,32 @@ bool AWPassiveClauseContainer::byWeight(int balance)
   }
 }
 
+/**
+ * The age queue is ordered by age first and the weight queue by weight
+ * first, so it is enough to compare with the first clause of each queue.
+ */
+bool AWPassiveClauseContainer::mayBeSelectedFirst(unsigned weightForClauseSelection, unsigned age)
+{
+  CALL("AWPassiveClauseContainer::mayBeSelectedFirst");
+
+  if (isEmpty()) {
+    return true;
+  }
+  if (_ageRatio) {
+    ClauseQueue::Iterator it(_ageQueue);
+    if (age <= it.next()->age()) {
+      return true;
+    }
+  }
+  if (_weightRatio) {
+    ClauseQueue::Iterator it(_weightQueue);
+    if (weightForClauseSelection <= it.next()->weightForClauseSelection(_opt)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 /**
  * Return the next selected clause and remove it from the queue.
  * @since 31/12/2007 Manchester
@@ -301,6 +333,7 @@ Clause* AWPassiveClauseContainer::popSelected()
     cl = _ageQueue.pop();
     _weightQueue.remove(cl);
   }
+  updateHistogram(cl, -1);
 
   if (_isOutermost) {
     selectedEvent.fire(cl);
@@ -444,51 +477,42 @@ bool AWPassiveClauseContainer::setLimitsFromSimulation()
   ASS(!_simulationCurrAgeCl->hasAux() || _simulationCurrWeightCl->hasAux());
   ASS(_simulationCurrAgeCl->hasAux() || !_simulationCurrWeightCl->hasAux());
 
-  unsigned maxAgeQueueAge;
-  unsigned maxAgeQueueWeight;
-  unsigned maxWeightQueueWeight;
-  unsigned maxWeightQueueAge;
+  // if the simulation got to the end of a queue, we set no limits on that queue
+  unsigned maxAgeQueueAge = UINT_MAX;
+  unsigned maxAgeQueueWeight = UINT_MAX;
+  unsigned maxWeightQueueWeight = UINT_MAX;
+  unsigned maxWeightQueueAge = UINT_MAX;
 
-  // compute limits for age-queue
-  if (_ageRatio != 0)
+  if (_simulationCurrAgeIt.hasNext())
   {
-    if (_simulationCurrAgeIt.hasNext())
-    {
-      // the age-queue is in use and the simulation didn't get to the end of the age-queue => set limits on age-queue
-      maxAgeQueueAge = _simulationCurrAgeCl->age();
-      maxAgeQueueWeight = _simulationCurrAgeCl->weightForClauseSelection(_opt);
-    }
-    else
-    {
-      // the age-queue is in use and the simulation got to the end of the age-queue => set no limits on age-queue
-      maxAgeQueueAge = UINT_MAX;
-      maxAgeQueueWeight = UINT_MAX;
-    }
+    maxAgeQueueAge = _simulationCurrAgeCl->age();
+    maxAgeQueueWeight = _simulationCurrAgeCl->weightForClauseSelection(_opt);
   }
-  else
+  if (_simulationCurrWeightIt.hasNext())
   {
-    // the age-queue is not in use, so no clause will be selected from the age-queue => set tighest possible bound on age-queue
-    maxAgeQueueAge = 0;
-    maxAgeQueueWeight = 0;
+    maxWeightQueueWeight = _simulationCurrWeightCl->weightForClauseSelection(_opt);
+    maxWeightQueueAge = _simulationCurrWeightCl->age();
   }
 
-  // compute limits for weight-queue
-  if (_weightRatio != 0)
+  return setLimitsFromCutoffs(maxAgeQueueAge, maxAgeQueueWeight, maxWeightQueueWeight, maxWeightQueueAge);
+}
+
+/**
+ * Set the limits from the clauses at which the selection from the age-queue
+ * and the weight-queue stops, UINT_MAX meaning that a queue gets exhausted.
+ * Return whether at least one of the limits was tightened.
+ */
+bool AWPassiveClauseContainer::setLimitsFromCutoffs(unsigned maxAgeQueueAge, unsigned maxAgeQueueWeight, unsigned maxWeightQueueWeight, unsigned maxWeightQueueAge)
+{
+  CALL("AWPassiveClauseContainer::setLimitsFromCutoffs");
+
+  if (_ageRatio == 0)
   {
-    if (_simulationCurrWeightIt.hasNext())
-    {
-      // the weight-queue is in use and the simulation didn't get to the end of the weight-queue => set limits on weight-queue
-      maxWeightQueueWeight = _simulationCurrWeightCl->weightForClauseSelection(_opt);
-      maxWeightQueueAge = _simulationCurrWeightCl->age();
-    }
-    else
-    {
-      // the weight-queue is in use and the simulation got to the end of the weight-queue => set no limits on weight-queue
-      maxWeightQueueWeight = UINT_MAX;
-      maxWeightQueueAge = UINT_MAX;
-    }
+    // the age-queue is not in use, so no clause will be selected from the age-queue => set tighest possible bound on age-queue
+    maxAgeQueueAge = 0;
+    maxAgeQueueWeight = 0;
   }
-  else
+  if (_weightRatio == 0)
   {
     // the weight-queue is not in use, so no clause will be selected from the weight-queue => set tighest possible bound on weight-queue
     maxWeightQueueWeight = 0;
@@ -508,6 +532,190 @@ bool AWPassiveClauseContainer::setLimitsFromSimulation()
   return setLimits(maxAgeQueueAge, maxAgeQueueWeight,maxWeightQueueWeight, maxWeightQueueAge);
 }
 
+void AWPassiveClauseContainer::updateHistogram(Clause* cl, int delta)
+{
+  CALL("AWPassiveClauseContainer::updateHistogram");
+
+  if (_histogram.size() == 0) {
+    return;
+  }
+  unsigned age = cl->age();
+  unsigned weight = cl->weightForClauseSelection(_opt);
+  histogramCell(age < HISTOGRAM_SIZE ? age : HISTOGRAM_SIZE-1,
+      weight < HISTOGRAM_SIZE ? weight : HISTOGRAM_SIZE-1) += delta;
+}
+
+/**
+ * Compute the limits the simulation of @b estReachableCnt selections would
+ * set, using only the histogram of the passive clauses by age and weight,
+ * so that the cost does not depend on the number of passive clauses.
+ *
+ * The age cursor walks down the rows and the weight cursor along the columns
+ * of the histogram, always moving the one that is behind its share of the
+ * selections. Clauses in the rows above the age cursor or in the columns left
+ * of the weight cursor are selected, and so are the clauses a cursor has taken
+ * from its current row (column) after it got its whole share. The interleaving
+ * of the two queues is therefore followed by whole rows and columns rather
+ * than clause by clause.
+ *
+ * Return false, if the histogram is not kept or the limits would fall
+ * into its last row or column, where the exact values are not known.
+ */
+bool AWPassiveClauseContainer::setLimitsFromHistogram(long long estReachableCnt, bool& tightened)
+{
+  CALL("AWPassiveClauseContainer::setLimitsFromHistogram");
+
+  // with one of the queues unused the simulation stops immediately
+  if (_histogram.size() == 0 || _size == 0 || !_ageRatio || !_weightRatio) {
+    return false;
+  }
+
+  // split the selections between the queues as popSelected would. The balance
+  // is back at its value after every _ageRatio+_weightRatio selections,
+  // so only the remaining ones have to be simulated.
+  long long period = _ageRatio+_weightRatio;
+  long long ageCnt = (estReachableCnt/period)*_ageRatio;
+  int balance = _balance;
+  for (long long i = estReachableCnt%period; i > 0; i--) {
+    if (byWeight(balance)) {
+      balance -= _ageRatio;
+    } else {
+      balance += _weightRatio;
+      ageCnt++;
+    }
+  }
+  long long weightCnt = estReachableCnt-ageCnt;
+
+  unsigned ageRow = 0;
+  unsigned weightCol = 0;
+  // once a cursor got its share, it stays in its row (column) and has taken
+  // the cells before ageCol (weightRow) and ageTaken (weightTaken) clauses of the next one
+  bool ageDone = false;
+  bool weightDone = false;
+  unsigned ageCol = 0;
+  unsigned ageTaken = 0;
+  unsigned weightRow = 0;
+  unsigned weightTaken = 0;
+  long long ageSel = 0;
+  long long weightSel = 0;
+
+  // the number of clauses of a cell not selected so far
+  auto available = [&](unsigned age, unsigned weight) -> unsigned {
+    if (age < ageRow || weight < weightCol) {
+      return 0;
+    }
+    unsigned res = histogramCell(age, weight);
+    if (ageDone && age == ageRow) {
+      if (weight < ageCol) {
+        return 0;
+      }
+      if (weight == ageCol) {
+        res -= ageTaken;
+      }
+    }
+    if (weightDone && weight == weightCol) {
+      if (age < weightRow) {
+        return 0;
+      }
+      if (age == weightRow) {
+        res -= weightTaken;
+      }
+    }
+    return res;
+  };
+
+  while ((!ageDone && ageRow < HISTOGRAM_SIZE) || (!weightDone && weightCol < HISTOGRAM_SIZE)) {
+    bool moveAge;
+    if (ageDone || ageRow == HISTOGRAM_SIZE) {
+      moveAge = false;
+    } else if (weightDone || weightCol == HISTOGRAM_SIZE) {
+      moveAge = true;
+    } else {
+      moveAge = ageSel*weightCnt <= weightSel*ageCnt;
+    }
+
+    if (moveAge) {
+      unsigned rowAvailable = 0;
+      for (unsigned w = 0; w < HISTOGRAM_SIZE; w++) {
+        rowAvailable += available(ageRow, w);
+      }
+      long long need = ageCnt-ageSel;
+      if (need >= rowAvailable) {
+        ageSel += rowAvailable;
+        ageRow++;
+        continue;
+      }
+      // the cursor stops in this row, find the cell
+      for (ageCol = 0; ; ageCol++) {
+        ASS(ageCol < HISTOGRAM_SIZE);
+        unsigned cellAvailable = available(ageRow, ageCol);
+        if (need < cellAvailable) {
+          ageTaken = need;
+          break;
+        }
+        need -= cellAvailable;
+      }
+      ageSel = ageCnt;
+      ageDone = true;
+    } else {
+      unsigned colAvailable = 0;
+      for (unsigned a = 0; a < HISTOGRAM_SIZE; a++) {
+        colAvailable += available(a, weightCol);
+      }
+      long long need = weightCnt-weightSel;
+      if (need >= colAvailable) {
+        weightSel += colAvailable;
+        weightCol++;
+        continue;
+      }
+      for (weightRow = 0; ; weightRow++) {
+        ASS(weightRow < HISTOGRAM_SIZE);
+        unsigned cellAvailable = available(weightRow, weightCol);
+        if (need < cellAvailable) {
+          weightTaken = need;
+          break;
+        }
+        need -= cellAvailable;
+      }
+      weightSel = weightCnt;
+      weightDone = true;
+    }
+  }
+
+  // the limits come from the first clause not selected in the order of each queue
+  unsigned maxAgeQueueAge = UINT_MAX;
+  unsigned maxAgeQueueWeight = UINT_MAX;
+  unsigned maxWeightQueueWeight = UINT_MAX;
+  unsigned maxWeightQueueAge = UINT_MAX;
+
+  for (unsigned a = ageRow; a < HISTOGRAM_SIZE && maxAgeQueueAge == UINT_MAX; a++) {
+    for (unsigned w = 0; w < HISTOGRAM_SIZE; w++) {
+      if (available(a, w)) {
+        maxAgeQueueAge = a;
+        maxAgeQueueWeight = w;
+        break;
+      }
+    }
+  }
+  for (unsigned w = weightCol; w < HISTOGRAM_SIZE && maxWeightQueueWeight == UINT_MAX; w++) {
+    for (unsigned a = 0; a < HISTOGRAM_SIZE; a++) {
+      if (available(a, w)) {
+        maxWeightQueueWeight = w;
+        maxWeightQueueAge = a;
+        break;
+      }
+    }
+  }
+
+  if (maxAgeQueueAge == HISTOGRAM_SIZE-1 || maxAgeQueueWeight == HISTOGRAM_SIZE-1 ||
+      maxWeightQueueWeight == HISTOGRAM_SIZE-1 || maxWeightQueueAge == HISTOGRAM_SIZE-1) {
+    return false;
+  }
+
+  tightened = setLimitsFromCutoffs(maxAgeQueueAge, maxAgeQueueWeight, maxWeightQueueWeight, maxWeightQueueAge);
+  return true;
+}
+
 bool AWPassiveClauseContainer::childrenPotentiallyFulfilLimits(Clause* cl, unsigned upperBoundNumSelLits) const
 {
   CALL("AWPassiveClauseContainer::childrenPotentiallyFulfilLimits");
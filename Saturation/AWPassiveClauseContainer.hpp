@@ -28,6 +28,7 @@
 #include <memory>
 #include <vector>
 #include "Lib/Comparison.hpp"
+#include "Lib/DArray.hpp"
 #include "Kernel/Clause.hpp"
 #include "Kernel/ClauseQueue.hpp"
 #include "ClauseContainer.hpp"
@@ -92,6 +93,8 @@ public:
 
   unsigned sizeEstimate() const override { return _size; }
 
+  bool mayBeSelectedFirst(unsigned weightForClauseSelection, unsigned age) override;
+
   static Comparison compareWeight(Clause* cl1, Clause* cl2, const Shell::Options& opt);
 
 private:
@@ -121,9 +124,11 @@ public:
   bool setLimitsToMax() override;
   // returns whether at least one of the limits was tightened
   bool setLimitsFromSimulation() override;
+  bool setLimitsFromHistogram(long long estReachableCnt, bool& tightened) override;
 
   void onLimitsUpdated() override;
 private:
+  bool setLimitsFromCutoffs(unsigned ageQueueAge, unsigned ageQueueWeight, unsigned weightQueueWeight, unsigned weightQueueAge);
   bool setLimits(unsigned newAgeSelectionMaxAge, unsigned newAgeSelectionMaxWeight, unsigned newWeightSelectionMaxWeight, unsigned newWeightSelectionMaxAge);
 
   int _simulationBalance;
@@ -137,6 +142,17 @@ private:
   unsigned _weightSelectionMaxWeight;
   unsigned _weightSelectionMaxAge;
 
+  void updateHistogram(Clause* cl, int delta);
+  unsigned& histogramCell(unsigned age, unsigned weight)
+  { return _histogram[age*HISTOGRAM_SIZE+weight]; }
+
+  /** Number of ages and weights counted separately in the histogram,
+   * the last row and column collect all the larger values */
+  static const unsigned HISTOGRAM_SIZE = 128;
+  /** Numbers of the passive clauses by age (row) and weight for clause
+   * selection (column). Kept only by the outermost container of LRS. */
+  DArray<unsigned> _histogram;
+
   /*
    * LRS specific methods and fields for usage of limits
    */
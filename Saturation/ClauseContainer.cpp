@@ -142,8 +142,9 @@ void PassiveClauseContainer::updateLimits(long long estReachableCnt)
     }
     return;
   }
-  // otherwise we run the simulation and set the limits accordingly
-  else
+  // otherwise we read the limits off the histograms of the container,
+  // and if it doesn't keep them, we run the simulation and set the limits accordingly
+  else if (!setLimitsFromHistogram(estReachableCnt, atLeastOneLimitTightened))
   {
     Clause::requestAux();
 
@@ -142,6 +142,10 @@ public:
 
   virtual unsigned sizeEstimate() const = 0;
 
+  // returns whether a clause with the given weight for clause selection and age could be
+  // selected before all the clauses in the container. Containers that cannot tell return true.
+  virtual bool mayBeSelectedFirst(unsigned weightForClauseSelection, unsigned age) { return true; }
+
   /*
    * LRS specific methods for computation of Limits
    */
@@ -155,6 +159,10 @@ public:
   virtual bool setLimitsToMax() = 0;
   // returns whether at least one of the limits was tightened
   virtual bool setLimitsFromSimulation() = 0;
+  // computes the limits for @b estReachableCnt selections without running the simulation.
+  // returns false if the container cannot do that, otherwise sets @b tightened to whether
+  // at least one of the limits was tightened
+  virtual bool setLimitsFromHistogram(long long estReachableCnt, bool& tightened) { return false; }
 
   virtual void onLimitsUpdated() = 0;
 
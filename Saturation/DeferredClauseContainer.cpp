@@ -0,0 +1,130 @@
+
+/*
+ * File DeferredClauseContainer.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file DeferredClauseContainer.cpp
+ * Implements class DeferredClauseContainer.
+ */
+
+#include <climits>
+
+#include "Lib/Environment.hpp"
+#include "Lib/Int.hpp"
+
+#include "Kernel/Clause.hpp"
+
+#include "Shell/Statistics.hpp"
+
+#include "ClauseContainer.hpp"
+
+#include "DeferredClauseContainer.hpp"
+
+namespace Saturation
+{
+
+Comparison DeferredClauseContainer::WeightComparator::compare(ClauseRecipe* r1, ClauseRecipe* r2)
+{
+  Comparison res = Int::compare(r1->weightLowerBound(), r2->weightLowerBound());
+  if (res == EQUAL) {
+    res = Int::compare(r1->age(), r2->age());
+  }
+  return res;
+}
+
+Comparison DeferredClauseContainer::AgeComparator::compare(ClauseRecipe* r1, ClauseRecipe* r2)
+{
+  Comparison res = Int::compare(r1->age(), r2->age());
+  if (res == EQUAL) {
+    res = Int::compare(r1->weightLowerBound(), r2->weightLowerBound());
+  }
+  return res;
+}
+
+DeferredClauseContainer::~DeferredClauseContainer()
+{
+  CALL("DeferredClauseContainer::~DeferredClauseContainer");
+
+  while (!_byWeight.isEmpty()) {
+    release(_byWeight.pop());
+  }
+  while (!_byAge.isEmpty()) {
+    release(_byAge.pop());
+  }
+}
+
+/**
+ * Take ownership of @b recipe.
+ */
+void DeferredClauseContainer::add(ClauseRecipe* recipe)
+{
+  CALL("DeferredClauseContainer::add");
+  ASS_EQ(recipe->_heapCnt, 0);
+
+  recipe->_heapCnt = 2;
+  _byWeight.insert(recipe);
+  _byAge.insert(recipe);
+  env.statistics->deferredClauses++;
+}
+
+/**
+ * Drop @b recipe from one of the queues, deleting it if it is in none anymore.
+ */
+void DeferredClauseContainer::release(ClauseRecipe* recipe)
+{
+  CALL("DeferredClauseContainer::release");
+  ASS_G(recipe->_heapCnt, 0);
+
+  if (--recipe->_heapCnt == 0) {
+    delete recipe;
+  }
+}
+
+template<class Comparator>
+void DeferredClauseContainer::materialiseTop(BinaryHeap<ClauseRecipe*,Comparator>& heap, ClauseStack& acc)
+{
+  CALL("DeferredClauseContainer::materialiseTop");
+
+  ClauseRecipe* recipe = heap.pop();
+  if (!recipe->_materialised) {
+    recipe->_materialised = true;
+    Clause* cl = recipe->materialise();
+    if (cl) {
+      env.statistics->materialisedClauses++;
+      acc.push(cl);
+    }
+  }
+  release(recipe);
+}
+
+/**
+ * Build the clauses of all the recipes that could be selected before
+ * the clauses in @b passive and push them into @b acc.
+ */
+void DeferredClauseContainer::materialise(PassiveClauseContainer& passive, ClauseStack& acc)
+{
+  CALL("DeferredClauseContainer::materialise");
+
+  while (!_byWeight.isEmpty() && passive.mayBeSelectedFirst(_byWeight.top()->weightLowerBound(), UINT_MAX)) {
+    materialiseTop(_byWeight, acc);
+  }
+  while (!_byAge.isEmpty() && passive.mayBeSelectedFirst(UINT_MAX, _byAge.top()->age())) {
+    materialiseTop(_byAge, acc);
+  }
+}
+
+}
@@ -0,0 +1,122 @@
+
+/*
+ * File DeferredClauseContainer.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file DeferredClauseContainer.hpp
+ * Defines classes ClauseRecipe and DeferredClauseContainer.
+ */
+
+#ifndef __DeferredClauseContainer__
+#define __DeferredClauseContainer__
+
+#include "Forwards.hpp"
+
+#include "Lib/BinaryHeap.hpp"
+#include "Lib/Comparison.hpp"
+#include "Lib/Stack.hpp"
+
+namespace Saturation {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * What a generating inference needs to build one of its conclusions
+ * later: the premises, with whatever positions in them the inference
+ * works on, and a lower bound on the weight for clause selection
+ * and the age of the conclusion.
+ *
+ * The substitution is not stored, the inference recomputes it when
+ * the clause is built.
+ */
+class ClauseRecipe
+{
+public:
+  ClauseRecipe(unsigned weightLowerBound, unsigned age)
+   : _weightLowerBound(weightLowerBound), _age(age), _heapCnt(0), _materialised(false) {}
+  virtual ~ClauseRecipe() {}
+
+  /**
+   * Build the clause. Return 0 if it is not needed anymore,
+   * e.g. because one of the premises is no longer active.
+   */
+  virtual Clause* materialise() = 0;
+
+  unsigned weightLowerBound() const { return _weightLowerBound; }
+  unsigned age() const { return _age; }
+
+private:
+  friend class DeferredClauseContainer;
+
+  unsigned _weightLowerBound;
+  unsigned _age;
+  /** in how many queues of the DeferredClauseContainer the recipe is */
+  unsigned _heapCnt;
+  bool _materialised;
+};
+
+/**
+ * Recipes of generated clauses that the Discount saturation algorithm
+ * keeps instead of the clauses themselves.
+ *
+ * Discount uses only the active clauses for simplification, so a passive
+ * clause is needed only when it is selected. A recipe is turned into a
+ * clause when it could be selected before the clauses already in passive,
+ * by weight or by age. Until then, neither the clause nor its literals
+ * exist, so the recipes of the clauses that are never selected cost
+ * only their own small objects.
+ */
+class DeferredClauseContainer
+{
+public:
+  CLASS_NAME(DeferredClauseContainer);
+  USE_ALLOCATOR(DeferredClauseContainer);
+
+  ~DeferredClauseContainer();
+
+  void add(ClauseRecipe* recipe);
+  void materialise(PassiveClauseContainer& passive, ClauseStack& acc);
+
+  /** True if there are no recipes left to materialise. A recipe that
+   * is not materialised yet is in both queues. */
+  bool isEmpty() const { return _byWeight.isEmpty() || _byAge.isEmpty(); }
+
+private:
+  struct WeightComparator
+  {
+    static Comparison compare(ClauseRecipe* r1, ClauseRecipe* r2);
+  };
+  struct AgeComparator
+  {
+    static Comparison compare(ClauseRecipe* r1, ClauseRecipe* r2);
+  };
+  template<class Comparator>
+  void materialiseTop(BinaryHeap<ClauseRecipe*,Comparator>& heap, ClauseStack& acc);
+  void release(ClauseRecipe* recipe);
+
+  /**
+   * Each recipe is in both queues until it is materialised
+   * and popped from the other one.
+   */
+  BinaryHeap<ClauseRecipe*,WeightComparator> _byWeight;
+  BinaryHeap<ClauseRecipe*,AgeComparator> _byAge;
+};
+
+}
+
+#endif // __DeferredClauseContainer__
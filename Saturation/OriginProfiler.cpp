@@ -0,0 +1,201 @@
+
+/*
+ * File OriginProfiler.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file OriginProfiler.cpp
+ * Implements class OriginProfiler.
+ */
+
+#include <fstream>
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/Sort.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Inference.hpp"
+#include "Kernel/Unit.hpp"
+
+#include "OriginProfiler.hpp"
+
+namespace Saturation
+{
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Return the origins of unit @b u, computing (and remembering) the origins
+ * of all its ancestors not seen before.
+ */
+const OriginProfiler::OriginSet* OriginProfiler::getOrigins(Unit* u)
+{
+  CALL("OriginProfiler::getOrigins");
+
+  const OriginSet* res;
+  if (_origins.find(u->number(), res)) {
+    return res;
+  }
+
+  // derivations may be deep (e.g. long preprocessing chains), so we don't recurse
+  ASS(_todo.isEmpty());
+  _todo.push(u);
+  while (_todo.isNonEmpty()) {
+    Unit* v = _todo.top();
+    if (_origins.find(v->number())) {
+      _todo.pop();
+      continue;
+    }
+
+    const Inference& inf = v->inference();
+    bool ready = true;
+    bool hasPremises = false;
+    Inference::Iterator it = inf.iterator();
+    while (inf.hasNext(it)) {
+      Unit* premise = inf.next(it);
+      hasPremises = true;
+      if (!_origins.find(premise->number())) {
+        _todo.push(premise);
+        ready = false;
+      }
+    }
+    if (!ready) {
+      continue;
+    }
+
+    const OriginSet* vOrigins;
+    if (hasPremises) {
+      vOrigins = OriginSet::getEmpty();
+      it = inf.iterator();
+      while (inf.hasNext(it)) {
+        vOrigins = vOrigins->getUnion(_origins.get(inf.next(it)->number()));
+      }
+    }
+    else {
+      vOrigins = OriginSet::getSingleton(v->number());
+      _leaves.insert(v->number(), v->toString());
+    }
+    _origins.insert(v->number(), vOrigins);
+    _todo.pop();
+  }
+  return _origins.get(u->number());
+}
+
+void OriginProfiler::charge(Clause* cl, Event ev)
+{
+  CALL("OriginProfiler::charge");
+
+  const OriginSet* origins = getOrigins(cl);
+  unsigned cnt = origins->size();
+  for (unsigned i = 0; i < cnt; i++) {
+    Cost* cost;
+    _costs.getValuePtr((*origins)[i], cost);
+    switch (ev) {
+    case GENERATED:
+      cost->generated++;
+      break;
+    case REDUCTION:
+      cost->reductions++;
+      break;
+    case ACTIVATION:
+      cost->activations++;
+      break;
+    }
+    cost->share += 1.0f/cnt;
+  }
+}
+
+void OriginProfiler::onNewClause(Clause* cl)
+{
+  CALL("OriginProfiler::onNewClause");
+
+  if (isGeneratingInferenceRule(cl->inference().rule())) {
+    charge(cl, GENERATED);
+  }
+  else {
+    // still propagate the origins while the premises are certainly alive
+    getOrigins(cl);
+  }
+}
+
+void OriginProfiler::onClauseReduction(Clause* cl)
+{
+  CALL("OriginProfiler::onClauseReduction");
+
+  charge(cl, REDUCTION);
+}
+
+void OriginProfiler::onActiveAdded(Clause* cl)
+{
+  CALL("OriginProfiler::onActiveAdded");
+
+  charge(cl, ACTIVATION);
+}
+
+/**
+ * Let the split definition @b def have the origins of the clause @b orig
+ * it was introduced for, rather than being an origin of its own.
+ *
+ * The definition is shared by the later splits that produce the same
+ * component, but only the first clause is taken into account.
+ */
+void OriginProfiler::onSplitDefinition(Unit* def, Clause* orig)
+{
+  CALL("OriginProfiler::onSplitDefinition");
+
+  if (!_origins.find(def->number())) {
+    _origins.insert(def->number(), getOrigins(orig));
+  }
+}
+
+/**
+ * Write the origins ranked by their share of the charged events, one per line.
+ */
+void OriginProfiler::writeReport()
+{
+  CALL("OriginProfiler::writeReport");
+
+  static Stack<pair<float,unsigned> > ranking;
+  ranking.reset();
+  float totalShare = 0;
+  DHMap<unsigned,Cost>::Iterator cit(_costs);
+  while (cit.hasNext()) {
+    unsigned origin;
+    Cost& cost = cit.nextRef(origin);
+    ranking.push(make_pair(-cost.share, origin));
+    totalShare += cost.share;
+  }
+  sort<DefaultComparator>(ranking.begin(), ranking.end());
+
+  BYPASSING_ALLOCATOR;
+
+  ofstream out(_fileName.c_str());
+  if (out.fail()) {
+    USER_ERROR("Cannot open origin profile file: "+_fileName);
+  }
+  out << "% " << ranking.size() << " origins charged with " << totalShare << " events" << endl;
+  out << "% rank\tshare\tgenerated\treductions\tactivations\tunit" << endl;
+  for (unsigned i = 0; i < ranking.size(); i++) {
+    unsigned origin = ranking[i].second;
+    const Cost& cost = _costs.get(origin);
+    out << (i+1) << '\t' << cost.share << '\t' << cost.generated << '\t' << cost.reductions
+        << '\t' << cost.activations << '\t' << _leaves.get(origin) << endl;
+  }
+}
+
+}
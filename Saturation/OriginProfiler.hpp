@@ -0,0 +1,101 @@
+
+/*
+ * File OriginProfiler.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file OriginProfiler.hpp
+ * Defines class OriginProfiler.
+ */
+
+#ifndef __OriginProfiler__
+#define __OriginProfiler__
+
+#include "Forwards.hpp"
+
+#include "Lib/DHMap.hpp"
+#include "Lib/SharedSet.hpp"
+#include "Lib/Stack.hpp"
+
+namespace Saturation {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * The @b OriginProfiler object attributes the work of the saturation
+ * algorithm to the units the derived clauses originate from.
+ *
+ * The origins of a unit are the leaves of its derivation (input units,
+ * theory axioms, ...). They are propagated from the premises when a clause
+ * is first seen and kept as shared sets, so clauses with the same origins
+ * share one set. AVATAR split definitions have no premises, so they take
+ * the origins of the clause whose splitting introduced them. Every generated clause, reduction and activation of a
+ * clause is charged in full to each of its origins, and is also split
+ * evenly among them, which is the share the report is ranked by.
+ */
+class OriginProfiler {
+public:
+  CLASS_NAME(OriginProfiler);
+  USE_ALLOCATOR(OriginProfiler);
+
+  OriginProfiler(vstring fileName) : _fileName(fileName) {}
+
+  void onNewClause(Clause* cl);
+  void onClauseReduction(Clause* cl);
+  void onActiveAdded(Clause* cl);
+  void onSplitDefinition(Unit* def, Clause* orig);
+
+  void writeReport();
+
+private:
+  typedef SharedSet<unsigned> OriginSet;
+
+  struct Cost {
+    Cost() : generated(0), reductions(0), activations(0), share(0) {}
+
+    unsigned generated;
+    unsigned reductions;
+    unsigned activations;
+    float share;
+  };
+
+  enum Event {
+    GENERATED,
+    REDUCTION,
+    ACTIVATION
+  };
+
+  const OriginSet* getOrigins(Unit* u);
+  void charge(Clause* cl, Event ev);
+
+  vstring _fileName;
+
+  /** origins of the units seen so far, by unit number */
+  DHMap<unsigned,const OriginSet*> _origins;
+  /**
+   * the descriptions of the leaf units, by unit number (the units
+   * themselves may be gone by the time the report is written)
+   */
+  DHMap<unsigned,vstring> _leaves;
+  DHMap<unsigned,Cost> _costs;
+
+  Stack<Unit*> _todo;
+};
+
+}
+
+#endif // __OriginProfiler__
@@ -82,8 +82,10 @@
 #include "Splitter.hpp"
 
 #include "ConsequenceFinder.hpp"
+#include "DeferredClauseContainer.hpp"
 #include "LabelFinder.hpp"
 #include "Splitter.hpp"
+#include "OriginProfiler.hpp"
 #include "SymElOutput.hpp"
 #include "SaturationAlgorithm.hpp"
 #include "ManCSPassiveClauseContainer.hpp"
@@ -197,13 +199,11 @@ std::unique_ptr<PassiveClauseContainer> makeLevel4(bool isOutermost, const Optio
  */
 SaturationAlgorithm::SaturationAlgorithm(Problem& prb, const Options& opt)
   : MainLoop(prb, opt),
-    _clauseActivationInProgress(false),
+    _clauseActivationInProgress(false), _deferred(0),
     _fwSimplifiers(0), _bwSimplifiers(0), _splitter(0),
-    _consFinder(0), _labelFinder(0), _symEl(0), _answerLiteralManager(0),
+    _consFinder(0), _labelFinder(0), _symEl(0), _answerLiteralManager(0), _originProfiler(0),
     _instantiation(0),
-#if VZ3
     _theoryInstSimp(0),
-#endif
     _generatedClauseCount(0),
     _activationLimit(0)
 {
@@ -232,6 +232,7 @@ SaturationAlgorithm::SaturationAlgorithm(Problem& prb, const Options& opt)
     _passive = makeLevel4(true, opt, "");
   }
   _active = new ActiveClauseContainer(opt);
+  _selector->attachActiveContainer(_active);
 
   _active->attach(this);
   _passive->attach(this);
@@ -265,6 +266,9 @@ SaturationAlgorithm::~SaturationAlgorithm()
 
   s_instance=0;
 
+  if (_deferred) {
+    delete _deferred;
+  }
   if (_splitter) {
     delete _splitter;
   }
@@ -274,6 +278,10 @@ SaturationAlgorithm::~SaturationAlgorithm()
   if (_symEl) {
     delete _symEl;
   }
+  if (_originProfiler) {
+    _originProfiler->writeReport();
+    delete _originProfiler;
+  }
 
   _active->detach();
   _passive->detach();
@@ -343,6 +351,10 @@ void SaturationAlgorithm::onActiveAdded(Clause* c)
     env.out() << "[SA] active: " << c->toString() << std::endl;
     env.endOutput();             
   }          
+
+  if (_originProfiler) {
+    _originProfiler->onActiveAdded(c);
+  }
 }
 
 /**
@@ -461,6 +473,10 @@ void SaturationAlgorithm::onNewClause(Clause* cl)
   if (_answerLiteralManager) {
     _answerLiteralManager->onNewClause(cl);
   }
+
+  if (_originProfiler) {
+    _originProfiler->onNewClause(cl);
+  }
 }
 
 void SaturationAlgorithm::onNewUsefulPropositionalClause(Clause* c)
@@ -540,6 +556,10 @@ void SaturationAlgorithm::onClauseReduction(Clause* cl, Clause* replacement,
     _splitter->onClauseReduction(cl, pvi( ClauseStack::Iterator(premStack) ), replacement);
   }
 
+  if (_originProfiler) {
+    _originProfiler->onClauseReduction(cl);
+  }
+
   if (replacement) {
     onParenthood(replacement, cl);
     while (premStack.isNonEmpty()) {
@@ -1080,11 +1100,9 @@ bool SaturationAlgorithm::activate(Clause* cl)
 
   bool redundant=false;
   ClauseIterator instances = ClauseIterator::getEmpty();
-#if VZ3
   if(_theoryInstSimp){
     instances = _theoryInstSimp->generateClauses(cl,redundant);
   }
-#endif
   if(redundant){ 
     removeActiveOrPassiveClause(cl);
     return false; 
@@ -1107,18 +1125,7 @@ bool SaturationAlgorithm::activate(Clause* cl)
     ClauseIterator toAdd= pvi(getConcatenatedIterator(instances,_generator->generateClauses(cl)));
 
     while (toAdd.hasNext()) {
-      Clause* genCl=toAdd.next();
-
-      addNewClause(genCl);
-
-      Inference::Iterator iit=genCl->inference().iterator();
-      while (genCl->inference().hasNext(iit)) {
-        Unit* premUnit=genCl->inference().next(iit);
-        ASS(premUnit->isClause());
-        Clause* premCl=static_cast<Clause*>(premUnit);
-
-        onParenthood(genCl, premCl);
-      }
+      addGeneratedClause(toAdd.next());
     }
 
   _clauseActivationInProgress=false;
@@ -1137,6 +1144,25 @@ bool SaturationAlgorithm::activate(Clause* cl)
   return true; 
 }
 
+/**
+ * Add a clause derived by a generating inference
+ */
+void SaturationAlgorithm::addGeneratedClause(Clause* genCl)
+{
+  CALL("SaturationAlgorithm::addGeneratedClause");
+
+  addNewClause(genCl);
+
+  Inference::Iterator iit=genCl->inference().iterator();
+  while (genCl->inference().hasNext(iit)) {
+    Unit* premUnit=genCl->inference().next(iit);
+    ASS(premUnit->isClause());
+    Clause* premCl=static_cast<Clause*>(premUnit);
+
+    onParenthood(genCl, premCl);
+  }
+}
+
 /**
  * Perform the loop that puts clauses from the unprocessed to the passive container.
  */
@@ -1197,6 +1223,32 @@ bool SaturationAlgorithm::handleClauseBeforeActivation(Clause* c)
   return true;
 }
 
+/**
+ * Build the deferred clauses that could be selected before the clauses
+ * in the passive container and pass them through the unprocessed loop.
+ *
+ * If the passive container is still empty afterwards, the remaining
+ * recipes are materialised as well, so the passive container is empty
+ * on return only if no recipes are left.
+ */
+void SaturationAlgorithm::materialiseDeferredClauses()
+{
+  CALL("SaturationAlgorithm::materialiseDeferredClauses");
+  ASS(_deferred);
+
+  ClauseStack materialised;
+  do {
+    _deferred->materialise(*_passive, materialised);
+    if (materialised.isEmpty()) {
+      return;
+    }
+    while (materialised.isNonEmpty()) {
+      addGeneratedClause(materialised.pop());
+    }
+    doUnprocessedLoop();
+  } while (_passive->isEmpty());
+}
+
 /**
  * This function should be called if (and only if) we will use
  * the @c doOneAlgorithmStep() function to run the saturation
@@ -1236,6 +1288,20 @@ void SaturationAlgorithm::doOneAlgorithmStep()
 
   doUnprocessedLoop();
 
+  if (_deferred) {
+    materialiseDeferredClauses();
+  }
+
+  if (_passive->isEmpty() && _theoryInstSimp) {
+    // the instances of a partly filled batch are still to be generated
+    ClauseStack instances;
+    _theoryInstSimp->flushPending(instances);
+    while (instances.isNonEmpty()) {
+      addGeneratedClause(instances.pop());
+    }
+    doUnprocessedLoop();
+  }
+
   if (_passive->isEmpty()) {
     MainLoopResult::TerminationReason termReason =
 	isComplete() ? Statistics::SATISFIABLE : Statistics::REFUTATION_NOT_FOUND;
@@ -1302,14 +1368,12 @@ MainLoopResult SaturationAlgorithm::runImpl()
 
 }
 
-#if VZ3
 void SaturationAlgorithm::setTheoryInstAndSimp(TheoryInstAndSimp* t)
 {
   ASS(t);
   _theoryInstSimp=t;
   _theoryInstSimp->attach(this);
 }
-#endif
 
 /**
  * Assign an generating inference object @b generator to be used
@@ -1410,6 +1474,10 @@ SaturationAlgorithm* SaturationAlgorithm::createFromOptions(Problem& prb, const
     res->_splitter = new Splitter();
   }
 
+  if (opt.deferredClauseWeight() && opt.saturationAlgorithm()==Shell::Options::SaturationAlgorithm::DISCOUNT) {
+    res->_deferred = new DeferredClauseContainer();
+  }
+
   // create generating inference engine
   CompositeGIE* gie=new CompositeGIE();
 
@@ -1455,12 +1523,10 @@ SaturationAlgorithm* SaturationAlgorithm::createFromOptions(Problem& prb, const
       gie->addFront(new InjectivityGIE());
     }
   }
-#if VZ3
   if (opt.theoryInstAndSimp() != Shell::Options::TheoryInstSimp::OFF){
     res->setTheoryInstAndSimp(new TheoryInstAndSimp());
     //gie->addFront(new TheoryInstAndSimp());
   }
-#endif
 
   res->setGeneratingInferenceEngine(gie);
 
@@ -1537,6 +1603,9 @@ SaturationAlgorithm* SaturationAlgorithm::createFromOptions(Problem& prb, const
   if (opt.showSymbolElimination()) {
     res->_symEl=new SymElOutput();
   }
+  if (opt.originProfile()!="off") {
+    res->_originProfiler=new OriginProfiler(opt.originProfile());
+  }
   if (opt.questionAnswering()==Options::QuestionAnsweringMode::ANSWER_LITERAL) {
     res->_answerLiteralManager = AnswerLiteralManager::getInstance();
   }
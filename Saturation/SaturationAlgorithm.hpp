@@ -76,9 +76,7 @@ public:
 
   void setGeneratingInferenceEngine(GeneratingInferenceEngine* generator);
   void setImmediateSimplificationEngine(ImmediateSimplificationEngine* immediateSimplifier);
-#if VZ3
   void setTheoryInstAndSimp(TheoryInstAndSimp* t);
-#endif
 
   void setLabelFinder(LabelFinder* finder){ _labelFinder = finder; }
 
@@ -106,6 +104,8 @@ public:
   ClauseIterator activeClauses();
 
   PassiveClauseContainer* getPassiveClauseContainer() { return _passive.get(); }
+  /** Return the container of the recipes of deferred clauses, or 0 if clauses are not deferred */
+  DeferredClauseContainer* getDeferredClauseContainer() { return _deferred; }
   IndexManager* getIndexManager() { return _imgr.ptr(); }
   AnswerLiteralManager* getAnswerLiteralManager() { return _answerLiteralManager; }
   Ordering& getOrdering() const { return *_ordering; }
@@ -128,11 +128,14 @@ public:
   static void tryUpdateFinalClauseCount();
 
   Splitter* getSplitter() { return _splitter; }
+  /** Return the origin profiler, or 0 if origins are not profiled */
+  OriginProfiler* getOriginProfiler() { return _originProfiler; }
 
 protected:
   virtual void init();
   virtual MainLoopResult runImpl();
   void doUnprocessedLoop();
+  void materialiseDeferredClauses();
   virtual void handleUnsuccessfulActivation(Clause* c);
   virtual bool handleClauseBeforeActivation(Clause* c);
   void addInputSOSClause(Clause* cl);
@@ -165,6 +168,7 @@ private:
   LiteralSelector& getSosLiteralSelector();
 
   void handleEmptyClause(Clause* cl);
+  void addGeneratedClause(Clause* cl);
   Clause* doImmediateSimplification(Clause* cl);
   MainLoopResult saturateImpl();
   SmartPtr<IndexManager> _imgr;
@@ -186,6 +190,7 @@ protected:
   UnprocessedClauseContainer* _unprocessed;
   std::unique_ptr<PassiveClauseContainer> _passive;
   ActiveClauseContainer* _active;
+  DeferredClauseContainer* _deferred;
   ExtensionalityClauseContainer* _extensionality;
 
   ScopedPtr<GeneratingInferenceEngine> _generator;
@@ -206,10 +211,9 @@ protected:
   LabelFinder* _labelFinder;
   SymElOutput* _symEl;
   AnswerLiteralManager* _answerLiteralManager;
+  OriginProfiler* _originProfiler;
   Instantiation* _instantiation;
-#if VZ3
   TheoryInstAndSimp* _theoryInstSimp;
-#endif
 
 
   SubscriptionData _passiveContRemovalSData;
@@ -28,6 +28,7 @@
 #include "Lib/DHSet.hpp"
 #include "Lib/Environment.hpp"
 #include "Lib/IntUnionFind.hpp"
+#include "Lib/Sort.hpp"
 #include "Lib/Metaiterators.hpp"
 #include "Lib/SharedSet.hpp"
 #include "Lib/TimeCounter.hpp"
@@ -52,11 +53,16 @@
 #include "SAT/BufferedSolver.hpp"
 #include "SAT/FallbackSolverWrapper.hpp"
 #include "SAT/MinisatInterfacing.hpp"
+#include "SAT/MinisatInterfacingNewSimp.hpp"
+#include "SAT/TraceRecordingSolver.hpp"
 #include "SAT/Z3Interfacing.hpp"
 
+#include "DP/CombinedDP.hpp"
+#include "DP/LinearArithmeticDP.hpp"
 #include "DP/ShortConflictMetaDP.hpp"
 
 #include "SaturationAlgorithm.hpp"
+#include "OriginProfiler.hpp"
 
 namespace Saturation
 {
@@ -78,15 +84,18 @@ void SplittingBranchSelector::init()
 
   switch(_parent.getOptions().satSolver()){
     case Options::SatSolver::VAMPIRE:  
-      _solver = new TWLSolver(_parent.getOptions(), true);
+      _solver = TraceRecordingSolver::wrapIfRequested(new TWLSolver(_parent.getOptions(), true), _parent.getOptions());
       break;
     case Options::SatSolver::MINISAT:
-      _solver = new MinisatInterfacing(_parent.getOptions(),true);
+      _solver = TraceRecordingSolver::wrapIfRequested(new MinisatInterfacing(_parent.getOptions(),true), _parent.getOptions());
       break;      
+    case Options::SatSolver::MINISAT_SIMP:
+      _solver = TraceRecordingSolver::wrapIfRequested(new MinisatInterfacingNewSimp(_parent.getOptions(),true,true), _parent.getOptions());
+      break;
 #if VZ3
     case Options::SatSolver::Z3:
       { BYPASSING_ALLOCATOR
-        _solver = new Z3Interfacing(_parent.getOptions(),_parent.satNaming());
+        _solver = TraceRecordingSolver::wrapIfRequested(new Z3Interfacing(_parent.getOptions(),_parent.satNaming()), _parent.getOptions());
         if(_parent.getOptions().satFallbackForSMT()){
           // TODO make fallback minimizing?
           SATSolver* fallback = new MinisatInterfacing(_parent.getOptions(),true);
@@ -118,16 +127,22 @@ void SplittingBranchSelector::init()
 
   if(_parent.getOptions().splittingCongruenceClosure() != Options::SplittingCongruenceClosure::OFF) {
     _dp = new DP::SimpleCongruenceClosure(&_parent.getOrdering());
-    if (_parent.getOptions().ccUnsatCores() == Options::CCUnsatCores::SMALL_ONES) {
-      _dp = new ShortConflictMetaDP(_dp.release(), _parent.satNaming(), *_solver);
-    }
-    _ccMultipleCores = (_parent.getOptions().ccUnsatCores() != Options::CCUnsatCores::FIRST);
 
     _ccModel = (_parent.getOptions().splittingCongruenceClosure() == Options::SplittingCongruenceClosure::MODEL);
     if (_ccModel) {
       _dpModel = new DP::SimpleCongruenceClosure(&_parent.getOrdering());
     }
   }
+  if(_parent.getOptions().splittingArithmetic()) {
+    DecisionProcedure* arith = new DP::LinearArithmeticDP();
+    _dp = _dp ? new CombinedDP(_dp.release(), arith) : arith;
+  }
+  if(_dp) {
+    if (_parent.getOptions().ccUnsatCores() == Options::CCUnsatCores::SMALL_ONES) {
+      _dp = new ShortConflictMetaDP(_dp.release(), _parent.satNaming(), *_solver);
+    }
+    _ccMultipleCores = (_parent.getOptions().ccUnsatCores() != Options::CCUnsatCores::FIRST);
+  }
 }
 
 void SplittingBranchSelector::updateVarCnt()
@@ -415,8 +430,21 @@ SATSolver::Status SplittingBranchSelector::processDPConflicts()
       s2f.collectAssignment(*_solver, gndAssignment); 
       // ... moreover, _dp->addLiterals will filter the set anyway
 
-      _dp->reset();
-      _dp->addLiterals(pvi( LiteralStack::ConstIterator(gndAssignment) ));
+      // retract only the part of the previous assignment that changed
+      // and re-add the literals from there on, each at its own level
+      unsigned common = 0;
+      while(common<_dpAssignment.size() && common<gndAssignment.size() &&
+          _dpAssignment[common]==gndAssignment[common]) {
+        common++;
+      }
+      _dp->popLevels(_dpAssignment.size()-common);
+      _dpAssignment.truncate(common);
+      for(unsigned i=common; i<gndAssignment.size(); i++) {
+        Literal* lit = gndAssignment[i];
+        _dp->pushLevel();
+        _dp->addLiterals(pvi( getSingletonIterator(lit) ));
+        _dpAssignment.push(lit);
+      }
       DecisionProcedure::Status dpStatus = _dp->getStatus(_ccMultipleCores);
 
       if(dpStatus!=DecisionProcedure::UNSATISFIABLE) {
@@ -568,6 +596,13 @@ void SplittingBranchSelector::updateSelection(unsigned satVar, SATSolver::VarAss
   }
 }
 
+void SplittingBranchSelector::onNameUsed(SplitLevel name)
+{
+  CALL("SplittingBranchSelector::onNameUsed");
+
+  _varsToRecheck.push(_parent.getLiteralFromName(name).var());
+}
+
 void SplittingBranchSelector::addSatClauseToSolver(SATClause* cl, bool branchRefutation)
 {
   CALL("SplittingBranchSelector::addSatClauseToSolver");
@@ -615,6 +650,34 @@ void SplittingBranchSelector::recomputeModel(SplitLevelStack& addedComps, SplitL
   }
   ASS_EQ(stat,SATSolver::SATISFIABLE);
 
+  static Stack<unsigned> changedVars;
+  changedVars.reset();
+  if(!_ccModel && _solver->collectChangedVariables(changedVars)) {
+    // Only variables whose value changed or whose names came into use
+    // can change the selection. Visit them in the order of a full scan.
+    changedVars.loadFromIterator(Stack<unsigned>::Iterator(_varsToRecheck));
+    _varsToRecheck.reset();
+    sort<DefaultComparator>(changedVars.begin(), changedVars.end());
+    unsigned prev = 0;
+    Stack<unsigned>::BottomFirstIterator cvit(changedVars);
+    while(cvit.hasNext()) {
+      unsigned var = cvit.next();
+      if(var==prev) {
+        continue;
+      }
+      prev = var;
+      ASS_LE(var,maxSatVar);
+      SATSolver::VarAssignment asgn = _solver->getAssignment(var);
+      if (asgn == SATSolver::NOT_KNOWN) {
+        env.statistics->smtDidNotEvaluate=true;
+        throw MainLoop::MainLoopFinishedException(Statistics::REFUTATION_NOT_FOUND);
+      }
+      updateSelection(var, asgn, addedComps, removedComps);
+    }
+    return;
+  }
+  _varsToRecheck.reset();
+
   unsigned _usedcnt=0; // for the statistics below
   for(unsigned i=1; i<=maxSatVar; i++) {
     SATSolver::VarAssignment asgn = getSolverAssimentConsideringCCModel(i);
@@ -710,6 +773,7 @@ void Splitter::init(SaturationAlgorithm* sa)
   _flushQuotient = opts.splittingFlushQuotient();
   _flushThreshold = sa->getGeneratedClauseCount() + _flushPeriod;
   _congruenceClosure = opts.splittingCongruenceClosure();
+  _arithmeticDP = opts.splittingArithmetic();
 #if VZ3
   hasSMTSolver = (opts.satSolver() == Options::SatSolver::Z3);
 #endif
@@ -872,7 +936,7 @@ bool Splitter::shouldAddClauseForNonSplittable(Clause* cl, unsigned& compName, C
 {
   CALL("Splitter::shouldAddClauseForNonSplittable");
   
-  if((_congruenceClosure != Options::SplittingCongruenceClosure::OFF
+  if((_congruenceClosure != Options::SplittingCongruenceClosure::OFF || _arithmeticDP
 #if VZ3
       || hasSMTSolver
 #endif
@@ -1245,6 +1309,9 @@ Clause* Splitter::buildAndInsertComponentClause(SplitLevel name, unsigned size,
     }
     def_u = new FormulaUnit(def_f,def_u_i);
     InferenceStore::instance()->recordIntroducedSplitName(def_u,formula_name);
+    if (orig != nullptr && _sa->getOriginProfiler()) {
+      _sa->getOriginProfiler()->onSplitDefinition(def_u,orig);
+    }
     // cout << "Add def " << def_u->toString() << " for " << name << endl;
     ALWAYS(_defs.insert(posName,def_u));
   }
@@ -1274,6 +1341,7 @@ Clause* Splitter::buildAndInsertComponentClause(SplitLevel name, unsigned size,
   }
 
   _db[name] = new SplitRecord(compCl);
+  _branchSelector.onNameUsed(name);
   compCl->setSplits(SplitSet::getSingleton(name));
   compCl->setComponent(true);
 
@@ -80,6 +80,7 @@ _solver=0;
 
   void updateVarCnt();
   void considerPolarityAdvice(SATLiteral lit);
+  void onNameUsed(SplitLevel name);
 
   void addSatClauseToSolver(SATClause* cl, bool refutation);
   void recomputeModel(SplitLevelStack& addedComps, SplitLevelStack& removedComps, bool randomize = false);
@@ -107,6 +108,8 @@ private:
 
   SATSolverSCP _solver;
   ScopedPtr<DecisionProcedure> _dp;
+  // literals asserted in _dp, each at its own backtracking level
+  LiteralStack _dpAssignment;
   // use a separate copy of the decision procedure for ccModel computations and fill it up only with equalities
   ScopedPtr<SimpleCongruenceClosure> _dpModel;
   
@@ -114,6 +117,12 @@ private:
    * Contains selected component names (splitlevels)
    */
   ArraySet _selected;
+
+  /**
+   * Variables of names that came into use since the last model update.
+   * Their selection has to be rechecked even if their value did not change.
+   */
+  Stack<unsigned> _varsToRecheck;
   
   /**
    * Keeps track of positive ground equalities true in the last ccmodel.
@@ -259,6 +268,7 @@ private:
   float _flushQuotient;
   Options::SplittingDeleteDeactivated _deleteDeactivated;
   Options::SplittingCongruenceClosure _congruenceClosure;
+  bool _arithmeticDP;
 #if VZ3
   bool hasSMTSolver;
 #endif
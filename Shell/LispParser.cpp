@@ -170,6 +170,104 @@ void LispParser::parse(List** expr0)
 
 } // parse()
 
+/**
+ * Read the next top-level expression from the lexer and return it,
+ * or return 0 if the end of the input has been reached.
+ *
+ * Unlike parse(), this allows the input to be processed one top-level
+ * expression at a time, without building the tree for the whole input.
+ */
+LispParser::Expression* LispParser::parseNext()
+{
+  CALL("LispParser::parseNext");
+  ASS_EQ(_balance,0);
+
+  Token t;
+  _lexer.readToken(t);
+  switch (t.tag) {
+  case TT_EOF:
+    return 0;
+  case TT_RPAR:
+    throw Exception("unmatched right parenthesis",t);
+  case TT_NAME:
+  case TT_INTEGER:
+  case TT_REAL:
+    return new Expression(ATOM,t.text);
+  case TT_LPAR:
+    break;
+#if VDEBUG
+  default:
+    ASSERTION_VIOLATION;
+#endif
+  }
+
+  static Stack<List**> stack;
+  stack.reset();
+
+  _balance++;
+  Expression* result = new Expression(LIST);
+  List** expr = &result->list;
+  for (;;) {
+    _lexer.readToken(t);
+    switch (t.tag) {
+    case TT_RPAR:
+      _balance--;
+      if (stack.isEmpty()) {
+        ASS_EQ(_balance,0);
+        return result;
+      }
+      expr = stack.pop();
+      break;
+    case TT_LPAR:
+      _balance++;
+      {
+        Expression* subexpr = new Expression(LIST);
+        List* sub = new List(subexpr);
+        *expr = sub;
+        stack.push(sub->tailPtr());
+        expr = &subexpr->list;
+      }
+      break;
+    case TT_NAME:
+    case TT_INTEGER:
+    case TT_REAL:
+    {
+      Expression* subexpr = new Expression(ATOM,t.text);
+      List* sub = new List(subexpr);
+      *expr = sub;
+      expr = sub->tailPtr();
+      break;
+    }
+    case TT_EOF:
+      throw Exception("unmatched left parenthesis",t);
+#if VDEBUG
+    default:
+      ASSERTION_VIOLATION;
+#endif
+    }
+  }
+} // parseNext()
+
+/**
+ * Delete this expression together with all its subexpressions.
+ */
+void LispParser::Expression::destroy()
+{
+  CALL("LispParser::Expression::destroy");
+
+  static Stack<Expression*> todo;
+  ASS(todo.isEmpty());
+
+  todo.push(this);
+  while (todo.isNonEmpty()) {
+    Expression* exp = todo.pop();
+    while (exp->list) {
+      todo.push(List::pop(exp->list));
+    }
+    delete exp;
+  }
+} // Expression::destroy
+
 /**
  * Return a LISP string corresponding to this expression
  * @since 26/08/2009 Redmond
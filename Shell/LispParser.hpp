@@ -81,6 +81,7 @@ public:
 	list(0)
     {}
     vstring toString(bool outerParentheses=true) const;
+    void destroy();
 
     bool isList() const { return tag==LIST; }
     bool isAtom() const { return tag==ATOM; }
@@ -96,6 +97,7 @@ public:
   explicit LispParser(LispLexer& lexer);
   Expression* parse();
   void parse(List**);
+  Expression* parseNext();
 
   /**
    * Class Exception. Implements parser exceptions.
@@ -71,6 +71,19 @@ void NewCNF::clausify(FormulaUnit* unit,Stack<Clause*>& output)
       return;
     }
 
+    case LITERAL: {
+      // shared literals don't contain fool stuff, so a positive one is
+      // already a unit clause and need not go through generalised clauses
+      Literal* l = f->literal();
+      if (l->shared() && l->isPositive()) {
+        Clause* clause = new(1) Clause(1,FormulaTransformation(InferenceRule::CLAUSIFY,unit));
+        (*clause)[0] = l;
+        output.push(clause);
+        return;
+      }
+      break;
+    }
+
     default:
       break;
   }
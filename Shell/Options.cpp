@@ -28,6 +28,8 @@
  * IMPORTANT --> see .hpp file for instructions on how to add an option
  */
 
+#include <algorithm>
+
 // Visual does not know the round function
 #include <cmath>
 
@@ -40,6 +42,7 @@
 #include "Lib/Environment.hpp"
 #include "Lib/Timer.hpp"
 #include "Lib/Exception.hpp"
+#include "Lib/Hash.hpp"
 #include "Lib/Int.hpp"
 #include "Lib/Random.hpp"
 #include "Lib/Set.hpp"
@@ -348,6 +351,14 @@ void Options::Options::init()
     _lookup.insert(&_timeStatistics);
     _timeStatistics.tag(OptionTag::OUTPUT);
 
+    _samplingProfile = StringOptionValue("sampling_profile","","off");
+    _samplingProfile.description="Sample the running time counters (see time_statistics) and the execution phase "
+      "every millisecond of CPU time and write the samples to the given file as folded stacks, "
+      "the input format of flame graph tools. Forked children append their pid to the file name.";
+    _lookup.insert(&_samplingProfile);
+    _samplingProfile.tag(OptionTag::OUTPUT);
+    _samplingProfile.setExperimental();
+
 //*********************** Input  ***********************
 
     _include = StringOptionValue("include","","");
@@ -355,6 +366,16 @@ void Options::Options::init()
     _lookup.insert(&_include);
     _include.tag(OptionTag::INPUT);
 
+    _problemCache = StringOptionValue("problem_cache","","");
+    _problemCache.description="File in which the clausified axioms of a TPTP problem are cached between runs. If the file exists and was "
+                              "written for the same axioms (including the contents of the included files) and the same input and "
+                              "preprocessing options, the clauses are read from it and only the conjectures are clausified. Otherwise "
+                              "the axioms are clausified on their own and the file is (re)written. Cached clauses appear as input "
+                              "clauses in proofs.";
+    _lookup.insert(&_problemCache);
+    _problemCache.tag(OptionTag::INPUT);
+    _problemCache.setExperimental();
+
     _inputFile= InputFileOptionValue("input_file","","",this);
     _inputFile.description="Problem file to be solved (if not specified, standard input is used)";
     _lookup.insert(&_inputFile);
@@ -707,6 +728,14 @@ void Options::Options::init()
     _lookup.insert(&_showSymbolElimination);
     _showSymbolElimination.tag(OptionTag::DEVELOPMENT);
 
+    _originProfile = StringOptionValue("origin_profile","","off");
+    _originProfile.description = "File to which a report is written at the end of saturation that ranks the input units "
+      "(and theory axioms) by the number of generated clauses, reductions and activations charged to the clauses "
+      "derived from them. Each event is also shared among all the origins of its clause.";
+    _originProfile.tag(OptionTag::OUTPUT);
+    _originProfile.setExperimental();
+    _lookup.insert(&_originProfile);
+
     _showTheoryAxioms = BoolOptionValue("show_theory_axioms","",false);
     _showTheoryAxioms.description="Show the added theory axioms.";
     _lookup.insert(&_showTheoryAxioms);
@@ -842,9 +871,18 @@ void Options::Options::init()
     _fmbEnumerationStrategy.setExperimental();
     _lookup.insert(&_fmbEnumerationStrategy);
 
+    _fmbStatisticsFile = StringOptionValue("fmb_statistics_file","","off");
+    _fmbStatisticsFile.description = "File to which finite model building writes one JSON record per model size tried, "
+      "breaking the attempt down into the number of SAT variables, the clauses produced for ground clauses, instances, "
+      "functional definitions, symmetry axioms and totality definitions, the time spent creating constraints and "
+      "solving, and the memory in use.";
+    _fmbStatisticsFile.tag(OptionTag::OUTPUT);
+    _fmbStatisticsFile.setExperimental();
+    _lookup.insert(&_fmbStatisticsFile);
+
     _selection = SelectionOptionValue("selection","s",10);
     _selection.description=
-    "Selection methods 2,3,4,10,11 are complete by virtue of extending Maximal i.e. they select the best among maximal. Methods 1002,1003,1004,1010,1011 relax this restriction and are therefore not complete.\n"
+    "Selection methods 2,3,4,10,11,12 are complete by virtue of extending Maximal i.e. they select the best among maximal. Methods 1002,1003,1004,1010,1011,1012 relax this restriction and are therefore not complete.\n"
     " 0     - Total (select everything)\n"
     " 1     - Maximal\n"
     " 2     - ColoredFirst, MaximalSize then Lexigraphical\n"
@@ -852,11 +890,13 @@ void Options::Options::init()
     " 4     - ColoredFirst, NoPositiveEquality, LeastTopLevelVariables,\n          LeastVariables, MaximalSize then Lexigraphical\n"
     " 10    - ColoredFirst, NegativeEquality, MaximalSize, Negative then Lexigraphical\n"
     " 11    - Lookahead\n"
+    " 12    - Lookahead estimated from the symbols of the active clauses\n"
     " 1002  - Incomplete version of 2\n"
     " 1003  - Incomplete version of 3\n"
     " 1004  - Incomplete version of 4\n"
     " 1010  - Incomplete version of 10\n"
     " 1011  - Incomplete version of 11\n"
+    " 1012  - Incomplete version of 12\n"
     "Or negated, which means that reversePolarity is true (?)\n";
 
     _lookup.insert(&_selection);
@@ -1009,6 +1049,15 @@ void Options::Options::init()
 	    _literalMaximalityAftercheck.tag(OptionTag::SATURATION);
 	    _literalMaximalityAftercheck.setExperimental();
 
+    _deferredClauseWeight = UnsignedOptionValue("deferred_clause_weight","dcw",0);
+    _deferredClauseWeight.description = "Binary resolvents whose weight is estimated to be at least this are kept as recipes, "
+      "which refer to the premises, and only built when they could be selected. Only used by the discount saturation algorithm. "
+      "0 means never.";
+    _lookup.insert(&_deferredClauseWeight);
+    _deferredClauseWeight.reliesOn(_saturationAlgorithm.is(equal(SaturationAlgorithm::DISCOUNT)));
+    _deferredClauseWeight.tag(OptionTag::SATURATION);
+    _deferredClauseWeight.setExperimental();
+
       _lrsFirstTimeCheck = IntOptionValue("lrs_first_time_check","",5);
       _lrsFirstTimeCheck.description=
       "Percentage of time limit at which the LRS algorithm will for the first time estimate the number of reachable clauses.";
@@ -1032,15 +1081,19 @@ void Options::Options::init()
 
   //*********************** Inferences  ***********************
 
-#if VZ3
-
            _theoryInstAndSimp = ChoiceOptionValue<TheoryInstSimp>("theory_instantiation","thi",
                                                 TheoryInstSimp::OFF,{"off","all","strong","overlap","full","new"});
-           _theoryInstAndSimp.description = ""; 
+           _theoryInstAndSimp.description = "Instantiate clauses so that their theory literals become false. Without Z3, only ground linear arithmetic is solved."; 
            _theoryInstAndSimp.tag(OptionTag::INFERENCES);
            _lookup.insert(&_theoryInstAndSimp);
            _theoryInstAndSimp.setExperimental();
-#endif
+
+           _theoryInstAndSimpBatch = UnsignedOptionValue("theory_instantiation_batch","thib",1);
+           _theoryInstAndSimpBatch.description = "Solve the theory literals of this many activated clauses in one solver query. With 1, each clause is solved when it is activated.";
+           _theoryInstAndSimpBatch.tag(OptionTag::INFERENCES);
+           _lookup.insert(&_theoryInstAndSimpBatch);
+           _theoryInstAndSimpBatch.reliesOn(_theoryInstAndSimp.is(notEqual(TheoryInstSimp::OFF)));
+           _theoryInstAndSimpBatch.setExperimental();
            _unificationWithAbstraction = ChoiceOptionValue<UnificationWithAbstraction>("unification_with_abstraction","uwa",
                                              UnificationWithAbstraction::OFF,
                                              {"off","interpreted_only","one_side_interpreted","one_side_constant","all","ground","fixed"});
@@ -1055,6 +1108,13 @@ void Options::Options::init()
            _lookup.insert(&_useACeval);
            _useACeval.setExperimental();
 
+           _polynomialNormalisation = BoolOptionValue("polynomial_normalisation","pnorm",false);
+           _polynomialNormalisation.description="Before evaluating an arithmetic literal, rewrite its sums and products into a normal form"
+             " with ordered monomials and merged numeral coefficients. The normal form of each term is remembered.";
+           _polynomialNormalisation.tag(OptionTag::INFERENCES);
+           _lookup.insert(&_polynomialNormalisation);
+           _polynomialNormalisation.setExperimental();
+
             _induction = ChoiceOptionValue<Induction>("induction","ind",Induction::NONE,
                                 {"none","struct","math","both"});
             _induction.description = "Apply structural and/or mathematical induction on datatypes and integers";
@@ -1529,6 +1589,16 @@ void Options::Options::init()
     _splittingCongruenceClosure.addHardConstraint(If(equal(SplittingCongruenceClosure::MODEL)).
                                                   then(_splittingMinimizeModel.is(notEqual(SplittingMinimizeModel::SCO))));
     
+    _splittingArithmetic = BoolOptionValue("avatar_arithmetic","aar",false);
+    _splittingArithmetic.description="Use a simplex-based decision procedure for ground linear arithmetic on top of the AVATAR SAT solver. It works alongside congruence closure if that is also enabled.";
+    _lookup.insert(&_splittingArithmetic);
+    _splittingArithmetic.tag(OptionTag::AVATAR);
+    _splittingArithmetic.reliesOn(_splitting.is(equal(true)));
+#if VZ3
+    _splittingArithmetic.reliesOn(_satSolver.is(notEqual(SatSolver::Z3)));
+#endif
+    _splittingArithmetic.setExperimental();
+
     _ccUnsatCores = ChoiceOptionValue<CCUnsatCores>("cc_unsat_cores","ccuc",CCUnsatCores::ALL,
                                                      {"first", "small_ones", "all"});
     _ccUnsatCores.description="";
@@ -1717,12 +1787,14 @@ void Options::Options::init()
 
     _satSolver = ChoiceOptionValue<SatSolver>("sat_solver","sas",SatSolver::MINISAT,
 #if VZ3
-            {"minisat","vampire","z3"});
+            {"minisat","vampire","z3","minisat_simp"});
 #else
-    {"minisat","vampire"});
+    {"minisat","vampire","minisat_simp"});
 #endif
     _satSolver.description=
-    "Select the SAT solver to be used throughout the solver. This will be used in AVATAR (for splitting) when the saturation algorithm is discount,lrs or otter and in instance generation for selection and global subsumption.";
+    "Select the SAT solver to be used throughout the solver. This will be used in AVATAR (for splitting) when the saturation algorithm is discount,lrs or otter and in instance generation for selection and global subsumption.\n"
+    "minisat_simp is minisat with its simplifier (subsumption and self-subsuming resolution) run as inprocessing before every call; "
+    "variables are never eliminated as clauses keep arriving. Finite model building always uses it.";
     _lookup.insert(&_satSolver);
     _satSolver.tag(OptionTag::SAT);
     _satSolver.setRandomChoices(
@@ -1747,6 +1819,14 @@ void Options::Options::init()
     _z3UnsatCores.tag(OptionTag::SAT);
 #endif
 
+    _recordSatTrace = StringOptionValue("record_sat_trace","","off");
+    _recordSatTrace.description = "File to which every call made to a SAT solver (clauses, assumptions, solve requests "
+      "and their answers) is written as a compact binary trace. The trace can be replayed against the available "
+      "backends with the sr module of vutil.";
+    _recordSatTrace.tag(OptionTag::SAT);
+    _recordSatTrace.setExperimental();
+    _lookup.insert(&_recordSatTrace);
+
     _satVarActivityDecay = FloatOptionValue("sat_var_activity_decay","",1.05f);
     _satVarActivityDecay.description="";
     _lookup.insert(&_satVarActivityDecay);
@@ -2617,6 +2697,7 @@ bool Options::SelectionOptionValue::setValue(const vstring& value)
   case 4:
   case 10:
   case 11:
+  case 12:
   case 20:
   case 21:
   case 22:
@@ -2633,12 +2714,14 @@ bool Options::SelectionOptionValue::setValue(const vstring& value)
   case 1004:
   case 1010:
   case 1011:
+  case 1012:
   case -1:
   case -2:
   case -3:
   case -4:
   case -10:
   case -11:
+  case -12:
   case -20: // almost same as 20 (but factoring will be on negative and not positive literals)
   case -21:
   case -22:
@@ -2654,6 +2737,7 @@ bool Options::SelectionOptionValue::setValue(const vstring& value)
   case -1004:
   case -1010:
   case -1011: // almost same as 1011 (but factoring will be on negative and not positive literals)
+  case -1012:
     actualValue = sel;
     return true;
   default:
@@ -3044,6 +3128,11 @@ vstring Options::generateEncodedOptions() const
     forbidden.insert(&_mode);
     forbidden.insert(&_testId); // is this old version of decode?
     forbidden.insert(&_include);
+    forbidden.insert(&_problemCache);
+    forbidden.insert(&_fmbStatisticsFile);
+    forbidden.insert(&_recordSatTrace);
+    forbidden.insert(&_originProfile);
+    forbidden.insert(&_samplingProfile);
     forbidden.insert(&_problemName);
     forbidden.insert(&_inputFile);
     forbidden.insert(&_randomStrategy);
@@ -3072,6 +3161,40 @@ vstring Options::generateEncodedOptions() const
  
 }
 
+/**
+ * Return a digest of the values of all options that influence parsing
+ * and preprocessing, i.e. those tagged INPUT or PREPROCESSING, plus the
+ * few development options read by Preprocess. The input file itself is
+ * left out, as the problem cache identifies the input by its contents.
+ * The options are hashed in the order of their names, so the digest does
+ * not depend on the order in which they are stored.
+ */
+unsigned Options::preprocessingDigest() const
+{
+  CALL("Options::preprocessingDigest");
+
+  Stack<vstring> values;
+  VirtualIterator<AbstractOptionValue*> options = _lookup.values();
+  while(options.hasNext()){
+    AbstractOptionValue* option = options.next();
+    if(option == &_problemCache || option == &_inputFile) continue;
+    OptionTag tag = option->getTag();
+    if(tag != OptionTag::INPUT && tag != OptionTag::PREPROCESSING &&
+       option != &_sineToAge && option != &_sineToPredLevels) {
+      continue;
+    }
+    values.push(option->longName + "=" + option->getStringOfActual());
+  }
+  std::sort(values.begin(), values.end());
+
+  unsigned res = 0;
+  Stack<vstring>::BottomFirstIterator vit(values);
+  while(vit.hasNext()){
+    res = Hash::combineHashes(res, Hash::hash(vit.next()));
+  }
+  return res;
+}
+
 
 /**
  * True if the options are complete.
@@ -140,6 +140,7 @@ public:
     void readFromEncodedOptions (vstring testId);
     void readOptionsString (vstring testId,bool assign=true);
     vstring generateEncodedOptions() const;
+    unsigned preprocessingDigest() const;
 
     // deal with completeness
     bool complete(const Problem&) const;
@@ -514,9 +515,12 @@ public:
   /** Possible values for sat_solver */
   enum class SatSolver : unsigned int {
      MINISAT = 0,
-     VAMPIRE = 1
+     VAMPIRE = 1,
 #if VZ3
-     ,Z3 = 2
+     Z3 = 2,
+     MINISAT_SIMP = 3
+#else
+     MINISAT_SIMP = 2
 #endif
   };
 
@@ -1658,7 +1662,8 @@ OptionValueConstraint<T>* Or(WrappedConstraint<S>* another);
         USE_ALLOCATOR(isLookAheadSelectionConstraint);
         isLookAheadSelectionConstraint() {}
         bool check(OptionValue<int>* value){
-            return value->actualValue == 11 || value->actualValue == 1011 || value->actualValue == -11 || value->actualValue == -1011;
+            return value->actualValue == 11 || value->actualValue == 1011 || value->actualValue == -11 || value->actualValue == -1011 ||
+                   value->actualValue == 12 || value->actualValue == 1012 || value->actualValue == -12 || value->actualValue == -1012;
         }
         vstring msg(OptionValue<int>* value){
             return value->longName+"("+value->getStringOfActual()+") is not lookahead selection"; 
@@ -1854,6 +1859,7 @@ public:
   unsigned fmbDetectSortBoundsTimeLimit() const { return _fmbDetectSortBoundsTimeLimit.actualValue; }
   unsigned fmbSizeWeightRatio() const { return _fmbSizeWeightRatio.actualValue; }
   FMBEnumerationStrategy fmbEnumerationStrategy() const { return _fmbEnumerationStrategy.actualValue; }
+  vstring fmbStatisticsFile() const { return _fmbStatisticsFile.actualValue; }
 
   bool flattenTopLevelConjunctions() const { return _flattenTopLevelConjunctions.actualValue; }
   LTBLearning ltbLearning() const { return _ltbLearning.actualValue; }
@@ -1876,6 +1882,7 @@ public:
   void setInclude(vstring val) { _include.actualValue = val; }
   vstring logFile() const { return _logFile.actualValue; }
   vstring inputFile() const { return _inputFile.actualValue; }
+  vstring problemCache() const { return _problemCache.actualValue; }
   int activationLimit() const { return _activationLimit.actualValue; }
   int randomSeed() const { return _randomSeed.actualValue; }
   bool printClausifierPremises() const { return _printClausifierPremises.actualValue; }
@@ -1895,6 +1902,7 @@ public:
   bool showPreprocessing() const { return showAll() || _showPreprocessing.actualValue; }
   bool showSkolemisations() const { return showAll() || _showSkolemisations.actualValue; }
   bool showSymbolElimination() const { return showAll() || _showSymbolElimination.actualValue; }
+  vstring originProfile() const { return _originProfile.actualValue; }
   bool showTheoryAxioms() const { return showAll() || _showTheoryAxioms.actualValue; }
   bool showFOOL() const { return showAll() || _showFOOL.actualValue; }
   bool showFMBsortInfo() const { return showAll() || _showFMBsortInfo.actualValue; }
@@ -1919,10 +1927,12 @@ public:
   bool z3UnsatCores() const { return _z3UnsatCores.actualValue;}
   bool satFallbackForSMT() const { return _satFallbackForSMT.actualValue; }
   bool smtForGround() const { return _smtForGround.actualValue; }
-  TheoryInstSimp theoryInstAndSimp() const { return _theoryInstAndSimp.actualValue; }
 #endif
+  TheoryInstSimp theoryInstAndSimp() const { return _theoryInstAndSimp.actualValue; }
+  unsigned theoryInstAndSimpBatch() const { return _theoryInstAndSimpBatch.actualValue; }
   UnificationWithAbstraction unificationWithAbstraction() const { return _unificationWithAbstraction.actualValue; }
   bool useACeval() const { return _useACeval.actualValue;}
+  bool polynomialNormalisation() const { return _polynomialNormalisation.actualValue;}
 
   bool unusedPredicateDefinitionRemoval() const { return _unusedPredicateDefinitionRemoval.actualValue; }
   bool blockedClauseElimination() const { return _blockedClauseElimination.actualValue; }
@@ -1930,6 +1940,7 @@ public:
   bool weightIncrement() const { return _weightIncrement.actualValue; }
   // bool useDM() const { return _use_dm.actualValue; }
   SatSolver satSolver() const { return _satSolver.actualValue; }
+  vstring recordSatTrace() const { return _recordSatTrace.actualValue; }
   //void setSatSolver(SatSolver newVal) { _satSolver = newVal; }
   SaturationAlgorithm saturationAlgorithm() const { return _saturationAlgorithm.actualValue; }
   void setSaturationAlgorithm(SaturationAlgorithm newVal) { _saturationAlgorithm.actualValue = newVal; }
@@ -2003,6 +2014,7 @@ public:
 	AgeWeightRatioShape ageWeightRatioShape() const { return _ageWeightRatioShape.actualValue; }
 	int ageWeightRatioShapeFrequency() const { return _ageWeightRatioShapeFrequency.actualValue; }
   bool literalMaximalityAftercheck() const { return _literalMaximalityAftercheck.actualValue; }
+  unsigned deferredClauseWeight() const { return _deferredClauseWeight.actualValue; }
   bool superpositionFromVariables() const { return _superpositionFromVariables.actualValue; }
   EqualityProxy equalityProxy() const { return _equalityProxy.actualValue; }
   RuleActivity equalityResolutionWithDeletion() const { return _equalityResolutionWithDeletion.actualValue; }
@@ -2047,6 +2059,7 @@ public:
   RuleActivity generalSplitting() const { return _generalSplitting.actualValue; }
   vstring namePrefix() const { return _namePrefix.actualValue; }
   bool timeStatistics() const { return _timeStatistics.actualValue; }
+  vstring samplingProfile() const { return _samplingProfile.actualValue; }
   bool splitting() const { return _splitting.actualValue; }
   void setSplitting(bool value){ _splitting.actualValue=value; }
   bool nonliteralsInClauseWeight() const { return _nonliteralsInClauseWeight.actualValue; }
@@ -2121,6 +2134,7 @@ public:
   float splittingFlushQuotient() const { return _splittingFlushQuotient.actualValue; }
   bool splittingEagerRemoval() const { return _splittingEagerRemoval.actualValue; }
   SplittingCongruenceClosure splittingCongruenceClosure() const { return _splittingCongruenceClosure.actualValue; }
+  bool splittingArithmetic() const { return _splittingArithmetic.actualValue; }
   CCUnsatCores ccUnsatCores() const { return _ccUnsatCores.actualValue; }
 
   void setProof(Proof p) { _proof.actualValue = p; }
@@ -2275,6 +2289,7 @@ private:
   StringOptionValue _positiveLiteralSplitQueueCutoffs;
   BoolOptionValue _positiveLiteralSplitQueueLayeredArrangement;
   BoolOptionValue _literalMaximalityAftercheck;
+  UnsignedOptionValue _deferredClauseWeight;
   BoolOptionValue _arityCheck;
   
   BoolOptionValue _backjumpTargetIsDecisionPoint;
@@ -2323,6 +2338,7 @@ private:
   UnsignedOptionValue _fmbDetectSortBoundsTimeLimit;
   UnsignedOptionValue _fmbSizeWeightRatio;
   ChoiceOptionValue<FMBEnumerationStrategy> _fmbEnumerationStrategy;
+  StringOptionValue _fmbStatisticsFile;
 
   BoolOptionValue _flattenTopLevelConjunctions;
   StringOptionValue _forbiddenOptions;
@@ -2352,6 +2368,7 @@ private:
   /** if true, then calling set() on non-existing options will not result in a user error */
   ChoiceOptionValue<IgnoreMissing> _ignoreMissing;
   StringOptionValue _include;
+  StringOptionValue _problemCache;
   /** if this option is true, Vampire will add the numeral weight of a clause
    * to its weight. The weight is defined as the sum of binary sizes of all
    * integers occurring in this clause. This option has not been tested and
@@ -2442,6 +2459,7 @@ private:
   FloatOptionValue _satVarActivityDecay;
   ChoiceOptionValue<SatVarSelector> _satVarSelector;
   ChoiceOptionValue<SatSolver> _satSolver;
+  StringOptionValue _recordSatTrace;
   ChoiceOptionValue<SaturationAlgorithm> _saturationAlgorithm;
   BoolOptionValue _selectUnusedVariablesFirst;
   BoolOptionValue _showAll;
@@ -2465,6 +2483,7 @@ private:
   BoolOptionValue _showPreprocessing;
   BoolOptionValue _showSkolemisations;
   BoolOptionValue _showSymbolElimination;
+  StringOptionValue _originProfile;
   BoolOptionValue _showTheoryAxioms;
   BoolOptionValue _showFOOL;
   BoolOptionValue _showFMBsortInfo;
@@ -2474,11 +2493,13 @@ private:
   BoolOptionValue _z3UnsatCores;
   BoolOptionValue _satFallbackForSMT;
   BoolOptionValue _smtForGround;
-  ChoiceOptionValue<TheoryInstSimp> _theoryInstAndSimp;
 #endif
+  ChoiceOptionValue<TheoryInstSimp> _theoryInstAndSimp;
+  UnsignedOptionValue _theoryInstAndSimpBatch;
   ChoiceOptionValue<UnificationWithAbstraction> _unificationWithAbstraction; 
   BoolOptionValue _fixUWA;
   BoolOptionValue _useACeval;
+  BoolOptionValue _polynomialNormalisation;
   TimeLimitOptionValue _simulatedTimeLimit;
   UnsignedOptionValue _sineDepth;
   UnsignedOptionValue _sineGeneralityThreshold;
@@ -2494,6 +2515,7 @@ private:
   BoolOptionValue _splitAtActivation;
   ChoiceOptionValue<SplittingAddComplementary> _splittingAddComplementary;
   ChoiceOptionValue<SplittingCongruenceClosure> _splittingCongruenceClosure;
+  BoolOptionValue _splittingArithmetic;
   ChoiceOptionValue<CCUnsatCores> _ccUnsatCores;
   BoolOptionValue _splittingEagerRemoval;
   UnsignedOptionValue _splittingFlushPeriod;
@@ -2523,6 +2545,7 @@ private:
   /** Time limit in deciseconds */
   TimeLimitOptionValue _timeLimitInDeciseconds;
   BoolOptionValue _timeStatistics;
+  StringOptionValue _samplingProfile;
 
   ChoiceOptionValue<URResolution> _unitResultingResolution;
   BoolOptionValue _unusedPredicateDefinitionRemoval;
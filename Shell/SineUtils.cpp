@@ -299,16 +299,47 @@ void SineSelector::init()
 }
 
 /**
- * Connect unit @b u with symbols it defines
+ * Extract symbols of each unit in @b units and compute the generality
+ * function from them, so that the units need not be traversed again.
  */
-void SineSelector::updateDefRelation(Unit* u)
+void SineSelector::extractUnitSymbols(UnitList* units)
+{
+  CALL("SineSelector::extractUnitSymbols");
+
+  _units.reset();
+  _unitSymStart.reset();
+  _unitSyms.reset();
+
+  _gen.init(_symExtr.getSymIdBound(),0);
+
+  UnitList::Iterator uit(units);
+  while (uit.hasNext()) {
+    Unit* u=uit.next();
+    _units.push(u);
+    _unitSymStart.push(_unitSyms.size());
+    SymIdIterator sit=_symExtr.extractSymIds(u);
+    while (sit.hasNext()) {
+      SymId sid=sit.next();
+      _unitSyms.push(sid);
+      _gen[sid]++;
+    }
+  }
+  _unitSymStart.push(_unitSyms.size());
+}
+
+/**
+ * Connect unit with index @b unitIdx with symbols it defines
+ */
+void SineSelector::updateDefRelation(unsigned unitIdx)
 {
   CALL("SineSelector::updateDefRelation");
 
-  SymIdIterator sit=_symExtr.extractSymIds(u);
+  unsigned symStart=_unitSymStart[unitIdx];
+  unsigned symEnd=_unitSymStart[unitIdx+1];
 
-  if (!sit.hasNext()) {
-    if(_justForSineLevels){
+  if (symStart==symEnd) {
+    Unit* u=_units[unitIdx];
+    if(_justForSineLevels) {
       u->inference().setSineLevel(0);
       //cout << "set level for a non-symboler " << u->toString() << " as " << "(0)" << endl;
     }
@@ -319,22 +350,22 @@ void SineSelector::updateDefRelation(Unit* u)
   static Stack<SymId> equalGenerality;
   equalGenerality.reset();
 
-  SymId leastGenSym=sit.next();
+  SymId leastGenSym=_unitSyms[symStart];
   unsigned leastGenVal=_gen[leastGenSym];
 
   //it a symbol fits under _genThreshold, add it immediately [into the relation]
   if (leastGenVal<=_genThreshold) {
-    UnitList::push(u,_def[leastGenSym]);
+    _defPairs.push(make_pair(leastGenSym,unitIdx));
   }
 
-  while (sit.hasNext()) {
-    SymId sym=sit.next();
+  for (unsigned i=symStart+1;i<symEnd;i++) {
+    SymId sym=_unitSyms[i];
     unsigned val=_gen[sym];
     ASS_G(val,0);
 
     //it a symbol fits under _genThreshold, add it immediately [into the relation]
     if (val<=_genThreshold) {
-      UnitList::push(u,_def[sym]);
+      _defPairs.push(make_pair(sym,unitIdx));
     }
 
     if (val<leastGenVal) {
@@ -350,9 +381,9 @@ void SineSelector::updateDefRelation(Unit* u)
   if (_strict) {
     //only if the least general symbol is over _genThreshold; otherwise it is already added
     if (leastGenVal>_genThreshold) {
-      UnitList::push(u,_def[leastGenSym]);
+      _defPairs.push(make_pair(leastGenSym,unitIdx));
       while (equalGenerality.isNonEmpty()) {
-        UnitList::push(u,_def[equalGenerality.pop()]);
+        _defPairs.push(make_pair(equalGenerality.pop(),unitIdx));
       }
     }
   }
@@ -364,13 +395,12 @@ void SineSelector::updateDefRelation(Unit* u)
 
     //if the generalityLimit is under _genThreshold, all suitable symbols are already added
     if (generalityLimit>_genThreshold) {
-      sit=_symExtr.extractSymIds(u);
-      while (sit.hasNext()) {
-	SymId sym=sit.next();
+      for (unsigned i=symStart;i<symEnd;i++) {
+	SymId sym=_unitSyms[i];
 	unsigned val=_gen[sym];
 	//only if the symbol is over _genThreshold; otherwise it is already added
 	if (val>_genThreshold && val<=generalityLimit) {
-	  UnitList::push(u,_def[sym]);
+	  _defPairs.push(make_pair(sym,unitIdx));
 	}
       }
     }
@@ -378,6 +408,35 @@ void SineSelector::updateDefRelation(Unit* u)
 
 }
 
+/**
+ * Turn the pairs collected by updateDefRelation() into the compressed
+ * D-relation. Units triggered by a symbol keep the order in which they
+ * were connected with it.
+ */
+void SineSelector::buildDefRelation(SymId symIdBound)
+{
+  CALL("SineSelector::buildDefRelation");
+
+  _defStart.init(symIdBound+1,0);
+  Stack<pair<SymId,unsigned> >::Iterator pit(_defPairs);
+  while (pit.hasNext()) {
+    _defStart[pit.next().first+1]++;
+  }
+  for (unsigned s=0;s<symIdBound;s++) {
+    _defStart[s+1]+=_defStart[s];
+  }
+
+  DArray<unsigned> fill;
+  fill.initFromArray(symIdBound,_defStart);
+  _defUnits.ensure(_defPairs.size());
+  Stack<pair<SymId,unsigned> >::Iterator pit2(_defPairs);
+  while (pit2.hasNext()) {
+    pair<SymId,unsigned> p=pit2.next();
+    _defUnits[fill[p.first]++]=p.second;
+  }
+  _defPairs.reset();
+}
+
 void SineSelector::perform(Problem& prb)
 {
   CALL("SineSelector::perform");
@@ -394,30 +453,32 @@ bool SineSelector::perform(UnitList*& units)
 
   TimeCounter tc(TC_SINE_SELECTION);
 
-  initGeneralityFunction(units);
+  extractUnitSymbols(units);
 
   SymId symIdBound=_symExtr.getSymIdBound();
+  unsigned unitCnt=_units.size();
+
+  static const unsigned DEPTH_MARK=UINT_MAX;
 
-  Set<Unit*> selected;
+  DArray<bool> selected;
+  selected.init(unitCnt,false);
   Stack<Unit*> selectedStack; //on this stack there are Units in the order they were selected
-  Deque<Unit*> newlySelected;
+  Deque<unsigned> newlySelected;
 
   //build the D-relation and select the non-axiom formulas
-  _def.init(symIdBound,0);
   unsigned numberUnitsLeftOut = 0;
-  UnitList::Iterator uit2(units);
-  while (uit2.hasNext()) {
+  for (unsigned idx=0;idx<unitCnt;idx++) {
     numberUnitsLeftOut++;
-    Unit* u=uit2.next();
+    Unit* u=_units[idx];
     bool performSelection= _onIncluded ? u->included() : ((u->inputType()==UnitInputType::AXIOM)
                             || (env.options->guessTheGoal() != Options::GoalGuess::OFF && u->inputType()==UnitInputType::ASSUMPTION));
     if (performSelection) { // register the unit for later
-      updateDefRelation(u);
+      updateDefRelation(idx);
     }
     else { // goal units are immediately taken (well, non-axiom, to by more precise. Includes ASSUMPTION, which cl->isGoal() does not take into account)
-      selected.insert(u);
+      selected[idx]=true;
       selectedStack.push(u);
-      newlySelected.push_back(u);
+      newlySelected.push_back(idx);
 
       if(_justForSineLevels) {
         u->inference().setSineLevel(0);
@@ -425,17 +486,22 @@ bool SineSelector::perform(UnitList*& units)
       }
     }
   }
+  buildDefRelation(symIdBound);
+
+  //symbols whose defining units have all been selected already
+  DArray<bool> symDone;
+  symDone.init(symIdBound,false);
 
   unsigned depth=0;
-  newlySelected.push_back(0);
+  newlySelected.push_back(DEPTH_MARK);
 
   // cout << "env.maxClausePriority starts as" << env.maxClausePriority << endl;
 
   //select required axiom formulas
   while (newlySelected.isNonEmpty()) {
-    Unit* u=newlySelected.pop_front();
+    unsigned idx=newlySelected.pop_front();
 
-    if (!u) {
+    if (idx==DEPTH_MARK) {
       //next selected formulas will be one step further from the original formulas
       depth++;
       
@@ -452,14 +518,14 @@ bool SineSelector::perform(UnitList*& units)
 
       if (newlySelected.isNonEmpty()) {
 	//we must push another mark if we're not done yet
-	newlySelected.push_back(0);
+	newlySelected.push_back(DEPTH_MARK);
       }
       continue;
     }
 
-    SymIdIterator sit=_symExtr.extractSymIds(u);
-    while (sit.hasNext()) {
-      SymId sym=sit.next();
+    unsigned symEnd=_unitSymStart[idx+1];
+    for (unsigned i=_unitSymStart[idx];i<symEnd;i++) {
+      SymId sym=_unitSyms[i];
 
       if (env.predicateSineLevels) {
         bool pred;
@@ -471,15 +537,19 @@ bool SineSelector::perform(UnitList*& units)
         }
       }
 
-      UnitList::Iterator defUnits(_def[sym]);
-      while (defUnits.hasNext()) {
-        Unit* du=defUnits.next();
-        if (selected.contains(du)) {
+      if (symDone[sym]) {
+        continue;
+      }
+      //units are taken most recently connected first
+      for (unsigned j=_defStart[sym+1];j-->_defStart[sym];) {
+        unsigned didx=_defUnits[j];
+        if (selected[didx]) {
           continue;
         }
-        selected.insert(du);
+        selected[didx]=true;
+        Unit* du=_units[didx];
         selectedStack.push(du);
-        newlySelected.push_back(du);
+        newlySelected.push_back(didx);
 
         if(_justForSineLevels){
           du->inference().setSineLevel(env.maxSineLevel);
@@ -487,9 +557,8 @@ bool SineSelector::perform(UnitList*& units)
         }
       }
       //all defining units for the symbol sym were selected,
-      //so we can remove them from the relation
-      UnitList::destroy(_def[sym]);
-      _def[sym]=0;
+      //so we need not look at them again
+      symDone[sym]=true;
     }
   }
 
@@ -81,16 +81,12 @@ public:
   bool perform(UnitList*& units); // returns true iff removed something
   void perform(Problem& prb);
 
-  ~SineSelector() {
-    DArray<UnitList*>::Iterator it(_def);
-    while (it.hasNext()) {
-      UnitList::destroy(it.next());
-    }
-  }
 private:
   void init();
 
-  void updateDefRelation(Unit* u);
+  void extractUnitSymbols(UnitList* units);
+  void updateDefRelation(unsigned unitIdx);
+  void buildDefRelation(SymId symIdBound);
 
   bool _onIncluded;
   bool _strict;
@@ -100,8 +96,24 @@ private:
 
   bool _justForSineLevels;
 
-  /** Stored the D-relation */
-  DArray<UnitList*> _def;
+  /** The units of the problem, so that they can be referred to by index */
+  Stack<Unit*> _units;
+  /**
+   * Symbols of the units, extracted only once per unit. The symbols of the
+   * i-th unit are stored in _unitSyms at positions _unitSymStart[i]
+   * to _unitSymStart[i+1]-1, in the order yielded by extractSymIds().
+   */
+  Stack<unsigned> _unitSymStart;
+  Stack<SymId> _unitSyms;
+
+  /** Pairs (symbol, unit index) of the D-relation in the order they were found */
+  Stack<pair<SymId,unsigned> > _defPairs;
+  /**
+   * The D-relation in the compressed sparse row format: units triggered by
+   * symbol s are _defUnits[_defStart[s]] to _defUnits[_defStart[s+1]-1]
+   */
+  DArray<unsigned> _defStart;
+  DArray<unsigned> _defUnits;
 
   /**
    * Stored formulas that don't contain any symbols
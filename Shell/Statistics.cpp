@@ -29,6 +29,7 @@
 
 #include "Lib/Allocator.hpp"
 #include "Lib/Environment.hpp"
+#include "Lib/SamplingProfiler.hpp"
 #include "Lib/TimeCounter.hpp"
 #include "Lib/Timer.hpp"
 
@@ -118,6 +119,10 @@ Statistics::Statistics()
     activeClauses(0),
     extensionalityClauses(0),
     discardedNonRedundantClauses(0),
+    discardedBeforeConstruction(0),
+    literalsNotInstantiated(0),
+    deferredClauses(0),
+    materialisedClauses(0),
     inferencesBlockedForOrderingAftercheck(0),
     smtReturnedUnknown(false),
     smtDidNotEvaluate(false),
@@ -147,9 +152,12 @@ Statistics::Statistics()
     instGenGeneratedClauses(0),
     instGenRedundantClauses(0),
     instGenKeptClauses(0),
+    instGenDuplicateGroundClauses(0),
     instGenIterations(0),
 
     maxBFNTModelSize(0),
+    fmbSizesTried(0),
+    fmbTimeToModel(0),
 
     satPureVarsEliminated(0),
     terminationReason(UNKNOWN),
@@ -181,6 +189,9 @@ void Statistics::explainRefutationNotFound(ostream& out)
 
 void Statistics::print(ostream& out)
 {
+  // this is where every run ends up, whether it finished or ran out of time
+  SamplingProfiler::writeReport();
+
   if (env.options->statistics()==Options::Statistics::NONE) {
     return;
   }
@@ -262,7 +273,7 @@ void Statistics::print(ostream& out)
 
   HEADING("Saturation",activeClauses+passiveClauses+extensionalityClauses+
       generatedClauses+finalActiveClauses+finalPassiveClauses+finalExtensionalityClauses+
-      discardedNonRedundantClauses+inferencesSkippedDueToColors+inferencesBlockedForOrderingAftercheck);
+      discardedNonRedundantClauses+deferredClauses+inferencesSkippedDueToColors+inferencesBlockedForOrderingAftercheck);
   COND_OUT("Initial clauses", initialClauses);
   COND_OUT("Generated clauses", generatedClauses);
   COND_OUT("Active clauses", activeClauses);
@@ -273,6 +284,10 @@ void Statistics::print(ostream& out)
   COND_OUT("Final passive clauses", finalPassiveClauses);
   COND_OUT("Final extensionality clauses", finalExtensionalityClauses);
   COND_OUT("Discarded non-redundant clauses", discardedNonRedundantClauses);
+  COND_OUT("Discarded before construction", discardedBeforeConstruction);
+  COND_OUT("Literal instantiations avoided", literalsNotInstantiated);
+  COND_OUT("Deferred clauses", deferredClauses);
+  COND_OUT("Materialised deferred clauses", materialisedClauses);
   COND_OUT("Inferences skipped due to colors", inferencesSkippedDueToColors);
   COND_OUT("Inferences blocked due to ordering aftercheck", inferencesBlockedForOrderingAftercheck);
   SEPARATOR;
@@ -358,16 +373,18 @@ void Statistics::print(ostream& out)
   SEPARATOR;
 
   HEADING("Instance Generation",instGenGeneratedClauses+instGenRedundantClauses+
-       instGenKeptClauses+instGenIterations);
+       instGenKeptClauses+instGenDuplicateGroundClauses+instGenIterations);
   COND_OUT("InstGen generated clauses", instGenGeneratedClauses);
   COND_OUT("InstGen redundant clauses", instGenRedundantClauses);
   COND_OUT("InstGen kept clauses", instGenKeptClauses);
+  COND_OUT("InstGen duplicate ground clauses", instGenDuplicateGroundClauses);
   COND_OUT("InstGen iterations", instGenIterations);
   SEPARATOR;
 
-  //TODO record statistics for FMB
-  HEADING("Model Building",maxBFNTModelSize);
+  HEADING("Model Building",maxBFNTModelSize+fmbSizesTried);
   COND_OUT("Max BFNT model size", maxBFNTModelSize);
+  COND_OUT("FMB model sizes tried", fmbSizesTried);
+  COND_OUT("FMB time to model (ms)", fmbTimeToModel);
   SEPARATOR;
 
 
@@ -201,6 +201,14 @@ public:
   unsigned extensionalityClauses;
 
   unsigned discardedNonRedundantClauses;
+  /** generated clauses discarded by the weight limit before being allocated */
+  unsigned discardedBeforeConstruction;
+  /** literals of discarded clauses that did not have to be instantiated */
+  unsigned literalsNotInstantiated;
+  /** generated clauses kept as recipes instead of being built */
+  unsigned deferredClauses;
+  /** deferred clauses that were eventually built */
+  unsigned materialisedClauses;
 
   unsigned inferencesBlockedForOrderingAftercheck;
 
@@ -244,9 +252,14 @@ public:
   unsigned instGenGeneratedClauses;
   unsigned instGenRedundantClauses;
   unsigned instGenKeptClauses;
+  unsigned instGenDuplicateGroundClauses;
   unsigned instGenIterations;
 
   unsigned maxBFNTModelSize;
+  /** Number of sort size assignments tried by the finite model builder */
+  unsigned fmbSizesTried;
+  /** Milliseconds from the start of finite model building until a model was found */
+  unsigned fmbTimeToModel;
 
   /** Number of pure variables eliminated by SAT solver */
   unsigned satPureVarsEliminated;
@@ -412,7 +425,6 @@ public:
 
   ExecutionPhase phase;
 
-private:
   static const char* phaseToString(ExecutionPhase p);
 }; // class Statistics
 
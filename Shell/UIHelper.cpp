@@ -21,6 +21,8 @@
  * Implements class UIHelper.
  */
 
+#include <algorithm>
+#include <cctype>
 #include <fstream>
 
 #include <stdlib.h>
@@ -31,6 +33,9 @@
 #include "Forwards.hpp"
 
 #include "Lib/Environment.hpp"
+#include "Lib/Hash.hpp"
+#include "Lib/Int.hpp"
+#include "Lib/Set.hpp"
 #include "Lib/TimeCounter.hpp"
 #include "Lib/VString.hpp"
 #include "Lib/Timer.hpp"
@@ -38,6 +43,7 @@
 #include "Kernel/InferenceStore.hpp"
 #include "Kernel/Problem.hpp"
 #include "Kernel/FormulaUnit.hpp"
+#include "Kernel/Signature.hpp"
 
 #include "Parse/SMTLIB2.hpp"
 #include "Parse/TPTP.hpp"
@@ -51,6 +57,7 @@
 #include "LispLexer.hpp"
 #include "LispParser.hpp"
 #include "Options.hpp"
+#include "Preprocess.hpp"
 #include "SimplifyProver.hpp"
 #include "Statistics.hpp"
 #include "TPTPPrinter.hpp"
@@ -304,6 +311,563 @@ Problem* UIHelper::getInputProblem(const Options& opts)
   return res;
 }
 
+/**
+ * Read the contents of the file @b fileName into @b text. Return false
+ * if the file cannot be read.
+ */
+static bool readFileContents(const vstring& fileName, vstring& text)
+{
+  CALL("readFileContents");
+
+  BYPASSING_ALLOCATOR;
+
+  ifstream in(fileName.c_str(), ios::binary);
+  if (in.fail()) {
+    return false;
+  }
+  char buf[1<<16];
+  while (in) {
+    in.read(buf, sizeof(buf));
+    text.append(buf, in.gcount());
+  }
+  return true;
+}
+
+static vstring trimmed(const vstring& str)
+{
+  size_t start = str.find_first_not_of(" \t\r\n");
+  if (start == vstring::npos) {
+    return "";
+  }
+  size_t end = str.find_last_not_of(" \t\r\n");
+  return str.substr(start, end + 1 - start);
+}
+
+/**
+ * A top-level statement of a TPTP text, such as fof(...). or include(...).
+ */
+struct TPTPStatement {
+  /** offset of the statement in the text */
+  size_t start;
+  /** the text of the statement, from its keyword to the final dot */
+  vstring text;
+  vstring keyword;
+  /** the first two arguments of the statement, without surrounding spaces */
+  vstring args[2];
+};
+
+/**
+ * Split the TPTP text @b text into its top-level statements, skipping the
+ * comments between them. The statements are not parsed, only their brackets,
+ * quotes and comments are followed. Return false if the text does not
+ * consist of complete statements.
+ */
+static bool splitTPTPStatements(const vstring& text, Stack<TPTPStatement>& statements)
+{
+  CALL("splitTPTPStatements");
+
+  size_t len = text.size();
+  size_t i = 0;
+  for (;;) {
+    // skip the spaces and comments before the next statement
+    for (;;) {
+      while (i < len && isspace(text[i])) {
+        i++;
+      }
+      if (i < len && text[i] == '%') {
+        i = text.find('\n', i);
+        if (i == vstring::npos) {
+          i = len;
+        }
+      }
+      else if (i + 1 < len && text[i] == '/' && text[i+1] == '*') {
+        i = text.find("*/", i + 2);
+        if (i == vstring::npos) {
+          return false;
+        }
+        i += 2;
+      }
+      else {
+        break;
+      }
+    }
+    if (i == len) {
+      return true;
+    }
+
+    TPTPStatement st;
+    st.start = i;
+    while (i < len && (isalnum(text[i]) || text[i] == '_')) {
+      i++;
+    }
+    st.keyword = text.substr(st.start, i - st.start);
+    if (st.keyword.empty()) {
+      return false;
+    }
+
+    unsigned depth = 0;
+    unsigned arg = 0;
+    size_t argStart = 0;
+    for (;;) {
+      if (i == len) {
+        return false;
+      }
+      char c = text[i++];
+      if (c == '\'' || c == '"') {
+        while (i < len && text[i] != c) {
+          i += (text[i] == '\\') ? 2 : 1;
+        }
+        if (i >= len) {
+          return false;
+        }
+        i++;
+      }
+      else if (c == '%') {
+        i = text.find('\n', i);
+        if (i == vstring::npos) {
+          return false;
+        }
+      }
+      else if (c == '/' && i < len && text[i] == '*') {
+        i = text.find("*/", i + 1);
+        if (i == vstring::npos) {
+          return false;
+        }
+        i += 2;
+      }
+      else if (c == '(' || c == '[') {
+        if (depth++ == 0) {
+          argStart = i;
+        }
+      }
+      else if (c == ')' || c == ']') {
+        if (depth == 0) {
+          return false;
+        }
+        if (--depth == 0 && arg < 2) {
+          st.args[arg++] = trimmed(text.substr(argStart, i - 1 - argStart));
+        }
+      }
+      else if (c == ',' && depth == 1 && arg < 2) {
+        st.args[arg++] = trimmed(text.substr(argStart, i - 1 - argStart));
+        argStart = i;
+      }
+      else if (c == '.' && depth == 0) {
+        break;
+      }
+    }
+    st.text = text.substr(st.start, i - st.start);
+    statements.push(st);
+  }
+}
+
+/**
+ * True if the statement @b st belongs to the conjecture of the problem
+ * rather than to its axioms.
+ */
+static bool isGoalStatement(const TPTPStatement& st)
+{
+  return st.keyword != "include" &&
+      (st.args[1] == "conjecture" || st.args[1] == "negated_conjecture" || st.args[1] == "question");
+}
+
+/**
+ * Combine into @b hash the contents of the file included by the include
+ * statement @b st and, recursively, of the files it includes.
+ * Return false if some of the files cannot be read.
+ */
+static bool hashIncludedFile(const TPTPStatement& st, Set<vstring>& seen, unsigned& hash)
+{
+  CALL("hashIncludedFile");
+
+  vstring relativeName = st.args[0];
+  if (relativeName.size() >= 2 && relativeName[0] == '\'') {
+    relativeName = relativeName.substr(1, relativeName.size() - 2);
+  }
+  vstring fileName = env.options->includeFileName(relativeName);
+  if (seen.contains(fileName)) {
+    return true;
+  }
+  seen.insert(fileName);
+
+  vstring text;
+  if (!readFileContents(fileName, text)) {
+    return false;
+  }
+  hash = Hash::combineHashes(hash, Hash::hash(text));
+
+  Stack<TPTPStatement> statements;
+  if (!splitTPTPStatements(text, statements)) {
+    return false;
+  }
+  Stack<TPTPStatement>::BottomFirstIterator it(statements);
+  while (it.hasNext()) {
+    const TPTPStatement& nested = it.next();
+    if (nested.keyword == "include" && !hashIncludedFile(nested, seen, hash)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Split the TPTP input file into the text of its axioms (including the
+ * type declarations and include statements) and the text of its
+ * conjectures, and compute into @b hash a hash of the axiom part that
+ * covers the contents of the included files. Both texts keep the line
+ * breaks of the whole file, so that parse errors report the original
+ * line numbers. Return false if the input cannot be split this way, e.g.
+ * when it is read from the standard input.
+ */
+static bool splitProblemInput(const Options& opts, vstring& axiomText, vstring& goalText, unsigned& hash)
+{
+  CALL("splitProblemInput");
+
+  vstring inputFile = opts.inputFile();
+  vstring text;
+  if (inputFile=="" || !readFileContents(inputFile, text)) {
+    // we cannot read the standard input twice
+    return false;
+  }
+  Stack<TPTPStatement> statements;
+  if (!splitTPTPStatements(text, statements)) {
+    return false;
+  }
+
+  hash = 0;
+  Set<vstring> seen;
+  size_t pos = 0;
+  Stack<TPTPStatement>::BottomFirstIterator it(statements);
+  while (it.hasNext()) {
+    const TPTPStatement& st = it.next();
+    vstring lineBreaks(count(text.begin() + pos, text.begin() + st.start, '\n'), '\n');
+    axiomText += lineBreaks;
+    goalText += lineBreaks;
+    pos = st.start + st.text.size();
+
+    bool goal = isGoalStatement(st);
+    (goal ? goalText : axiomText) += st.text;
+    (goal ? axiomText : goalText).append(count(st.text.begin(), st.text.end(), '\n'), '\n');
+    if (goal) {
+      continue;
+    }
+    hash = Hash::combineHashes(hash, Hash::hash(st.text));
+    if (st.keyword == "include" && !hashIncludedFile(st, seen, hash)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Parse the TPTP text @b text and return its units.
+ */
+static UnitList* parseTPTPText(const vstring& text, bool& haveConjecture)
+{
+  CALL("parseTPTPText");
+
+  vistringstream input(text);
+  Parse::TPTP parser(input);
+  try {
+    parser.parse();
+  }
+  catch (UserErrorException& exception) {
+    vstring msg = exception.msg();
+    throw Parse::TPTP::ParseErrorException(msg,parser.lineNumber());
+  }
+  haveConjecture = parser.containsConjecture();
+  return parser.units();
+}
+
+/** Flags of introduced symbols, which the problem cache stores besides the clauses */
+enum CachedSymbolFlag {
+  CACHED_INTRODUCED = 1,
+  CACHED_SKIP = 2,
+  CACHED_SKOLEM = 4
+};
+
+struct CachedSymbol {
+  bool function;
+  unsigned arity;
+  unsigned flags;
+  vstring name;
+};
+
+/** Start of the last line of a problem cache file, which is followed by the hash of the rest */
+static const char* CACHE_END_MARK = "% end of problem cache ";
+
+/**
+ * True if @b name occurs in @b text as a whole word, i.e. not as a part of
+ * a longer name. Occurrences in comments and quotes are counted as well.
+ */
+static bool occursAsWord(const vstring& text, const vstring& name)
+{
+  CALL("occursAsWord");
+
+  size_t pos = text.find(name);
+  while (pos != vstring::npos) {
+    size_t end = pos + name.size();
+    if ((pos == 0 || !(isalnum(text[pos-1]) || text[pos-1] == '_')) &&
+        (end == text.size() || !(isalnum(text[end]) || text[end] == '_'))) {
+      return true;
+    }
+    pos = text.find(name, pos + 1);
+  }
+  return false;
+}
+
+/**
+ * Load the clauses stored in the problem cache file @b fileName into
+ * @b units. Return false if the file does not start with the line @b key,
+ * if it is truncated or corrupted (its last line holds a hash of the rest),
+ * or if one of the symbols it introduces is named in the goal text
+ * @b goalText, so that the goal would refer to the introduced symbol.
+ * All of this is checked before the signature is touched.
+ */
+static bool loadCachedAxioms(const vstring& fileName, const vstring& key, const vstring& goalText,
+    UnitList*& units, bool& incomplete)
+{
+  CALL("loadCachedAxioms");
+
+  vstring text;
+  if (!readFileContents(fileName, text)) {
+    return false;
+  }
+  size_t endPos = text.rfind(CACHE_END_MARK);
+  if (endPos == vstring::npos) {
+    return false;
+  }
+  vstring body = text.substr(0, endPos);
+  if (text.substr(endPos) != CACHE_END_MARK + Int::toString(Hash::hash(body)) + "\n") {
+    return false;
+  }
+
+  vistringstream input(body);
+  vstring header;
+  int incompleteFlag;
+  unsigned symbolCnt;
+  if (!getline(input, header) || header != key || !(input >> incompleteFlag >> symbolCnt)) {
+    return false;
+  }
+  Stack<CachedSymbol> symbols;
+  for (unsigned i = 0; i < symbolCnt; i++) {
+    CachedSymbol cs;
+    char kind;
+    input >> kind >> cs.arity >> cs.flags;
+    getline(input, cs.name);
+    if (input.fail()) {
+      return false;
+    }
+    cs.function = kind == 'f';
+    cs.name = trimmed(cs.name);
+    if (occursAsWord(goalText, cs.name)) {
+      return false;
+    }
+    symbols.push(cs);
+  }
+
+  env.statistics->phase = Statistics::PARSING;
+  Parse::TPTP parser(input);
+  try {
+    parser.parse();
+  }
+  catch (UserErrorException& exception) {
+    vstring msg = exception.msg();
+    throw Parse::TPTP::ParseErrorException(msg,parser.lineNumber());
+  }
+  units = parser.units();
+  incomplete = incompleteFlag;
+
+  // the symbols were created by the parser as ordinary ones
+  Stack<CachedSymbol>::BottomFirstIterator sit(symbols);
+  while (sit.hasNext()) {
+    const CachedSymbol& cs = sit.next();
+    Signature::Symbol* sym;
+    if (cs.function) {
+      if (!env.signature->functionExists(cs.name, cs.arity)) {
+        continue;
+      }
+      sym = env.signature->getFunction(env.signature->getFunctionNumber(cs.name, cs.arity));
+    }
+    else {
+      if (!env.signature->predicateExists(cs.name, cs.arity)) {
+        continue;
+      }
+      sym = env.signature->getPredicate(env.signature->getPredicateNumber(cs.name, cs.arity));
+    }
+    if (cs.flags & CACHED_INTRODUCED) {
+      sym->markIntroduced();
+    }
+    if (cs.flags & CACHED_SKIP) {
+      sym->markSkip();
+    }
+    if (cs.flags & CACHED_SKOLEM) {
+      sym->markSkolem();
+    }
+  }
+  return true;
+}
+
+static unsigned cachedSymbolFlags(Signature::Symbol* sym)
+{
+  return (sym->introduced() ? CACHED_INTRODUCED : 0) | (sym->skip() ? CACHED_SKIP : 0) |
+      (sym->skolem() ? CACHED_SKOLEM : 0);
+}
+
+/**
+ * Write the clauses @b units into the problem cache file @b fileName,
+ * after the line @b key. Only warn if the file cannot be written, as
+ * the run itself does not depend on it.
+ */
+static void saveCachedAxioms(const vstring& fileName, const vstring& key, UnitList* units, bool incomplete)
+{
+  CALL("saveCachedAxioms");
+
+  Signature& sig = *env.signature;
+  Stack<vstring> symbolLines;
+  for (unsigned i = 0; i < sig.functions(); i++) {
+    Signature::Symbol* sym = sig.getFunction(i);
+    if (cachedSymbolFlags(sym)) {
+      symbolLines.push("f " + Int::toString(sym->arity()) + " " + Int::toString(cachedSymbolFlags(sym)) + " " + sym->name());
+    }
+  }
+  for (unsigned i = 0; i < sig.predicates(); i++) {
+    Signature::Symbol* sym = sig.getPredicate(i);
+    if (cachedSymbolFlags(sym)) {
+      symbolLines.push("p " + Int::toString(sym->arity()) + " " + Int::toString(cachedSymbolFlags(sym)) + " " + sym->name());
+    }
+  }
+
+  BYPASSING_ALLOCATOR;
+
+  ofstream out(fileName.c_str());
+  if (out.fail()) {
+    if (outputAllowed()) {
+      env.beginOutput();
+      addCommentSignForSZS(env.out());
+      env.out() << "WARNING: cannot write problem cache file " << fileName << endl;
+      env.endOutput();
+    }
+    return;
+  }
+  vostringstream body;
+  body << key << endl << incomplete << " " << symbolLines.size() << endl;
+  for (unsigned i = 0; i < symbolLines.size(); i++) {
+    body << symbolLines[i] << endl;
+  }
+  UIHelper::outputSortDeclarations(body);
+  UIHelper::outputSymbolDeclarations(body);
+  UnitList::Iterator uit(units);
+  while (uit.hasNext()) {
+    body << TPTPPrinter::toString(uit.next()) << "\n";
+  }
+  vstring text = body.str();
+  out << text << CACHE_END_MARK << Hash::hash(text) << endl;
+}
+
+/**
+ * Return the input problem with its axioms already clausified, using the
+ * problem cache file given by the problem_cache option, or 0 if the input
+ * cannot be cached.
+ *
+ * The axioms are the part of the input that is not a conjecture, and the
+ * cache is keyed on them (including the contents of the included files)
+ * and on the options that affect their clausification, so that a cache
+ * written for one conjecture can be used for others over the same axioms.
+ * On a cache miss (including a cache file that is damaged, or that
+ * introduces a symbol the conjectures name), the axioms are parsed and
+ * preprocessed up to and including clausification on their own, and the
+ * cache is (re)written.
+ * The steps of preprocessing that depend on the whole problem (e.g. SInE
+ * selection, definition elimination or the equality proxy) are skipped
+ * there and left to the preprocessing of the returned problem, which
+ * consists of the clausified axioms and the unprocessed conjectures.
+ *
+ * The clauses are stored in TPTP, so they come back as input clauses
+ * without their inference records, and the flags of the introduced
+ * symbols (Skolem functions and names) are stored separately. Only TPTP
+ * input is supported.
+ */
+Problem* UIHelper::getCachedInputProblem(const Options& opts)
+{
+  CALL("UIHelper::getCachedInputProblem");
+
+  if (opts.inputSyntax() != Options::InputSyntax::TPTP) {
+    return 0;
+  }
+
+  vstring axiomText, goalText;
+  unsigned hash;
+  {
+    TimeCounter tc(TC_PARSING);
+    if (!splitProblemInput(opts, axiomText, goalText, hash)) {
+      return 0;
+    }
+  }
+
+  // the axioms are preprocessed only up to the steps that can be done on them alone
+  Options axiomOpts(opts);
+  axiomOpts.set("sine_selection", "off");
+  axiomOpts.set("sine_to_age", "off");
+  axiomOpts.set("sine_to_pred_levels", "off");
+  axiomOpts.set("sine_level_split_queue", "off");
+  axiomOpts.set("guess_the_goal", "off");
+  axiomOpts.set("question_answering", "off");
+  axiomOpts.set("theory_axioms", "off");
+  axiomOpts.set("unused_predicate_definition_removal", "off");
+  axiomOpts.set("function_definition_elimination", "none");
+  axiomOpts.set("inequality_splitting", "0");
+  axiomOpts.set("equality_resolution_with_deletion", "off");
+  axiomOpts.set("general_splitting", "off");
+  axiomOpts.set("equality_proxy", "off");
+  axiomOpts.set("theory_flattening", "off");
+  axiomOpts.set("blocked_clause_elimination", "off");
+
+  vstring key = "% vampire problem cache v3 " + Int::toString(hash) + " " +
+      Int::toString(axiomOpts.preprocessingDigest());
+
+  UnitList* axioms;
+  UnitList* goals;
+  bool incomplete;
+  bool haveConjecture;
+  if (loadCachedAxioms(opts.problemCache(), key, goalText, axioms, incomplete)) {
+    TimeCounter tc(TC_PARSING);
+    env.statistics->phase = Statistics::PARSING;
+    goals = parseTPTPText(goalText, haveConjecture);
+  }
+  else {
+    // the goals are parsed before preprocessing, so that the symbols it introduces avoid their names
+    {
+      TimeCounter tc(TC_PARSING);
+      env.statistics->phase = Statistics::PARSING;
+      axioms = parseTPTPText(axiomText, haveConjecture);
+      goals = parseTPTPText(goalText, haveConjecture);
+    }
+    Problem axiomPrb(axioms);
+    {
+      TimeCounter tc(TC_PREPROCESSING);
+      // parts of preprocessing read the global options rather than those passed to it
+      Options savedOpts(*env.options);
+      *env.options = axiomOpts;
+      Preprocess(axiomOpts).preprocess(axiomPrb);
+      *env.options = savedOpts;
+    }
+    axioms = axiomPrb.units();
+    incomplete = axiomPrb.hadIncompleteTransformation();
+    if (!axiomPrb.hasFormulas()) {
+      saveCachedAxioms(opts.problemCache(), key, axioms, incomplete);
+    }
+  }
+  s_haveConjecture = haveConjecture;
+
+  Problem* res = new Problem(UnitList::concat(axioms, goals));
+  if (incomplete) {
+    res->reportIncompleteTransformation();
+  }
+  env.statistics->phase = Statistics::UNKNOWN_PHASE;
+  return res;
+} // UIHelper::getCachedInputProblem
+
 /*
 static void printInterpolationProofTask(ostream& out, Formula* intp, Color avoid_color, bool negate)
 {
@@ -0,0 +1,124 @@
+
+/*
+ * File tIntegerConstantType.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+
+
+#include "Test/UnitTesting.hpp"
+#include "Kernel/Theory.hpp"
+
+#define UNIT_ID integerConstantType
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+
+TEST_FUN(overflowToBig)
+{
+  IntegerConstantType cMAX(INT_MAX);
+  IntegerConstantType cMIN(INT_MIN);
+  IntegerConstantType c1(1);
+
+  IntegerConstantType big = cMAX+c1;
+  ASS(!big.fitsInner());
+  ASS_EQ(big.toString(),"2147483648");
+  ASS_EQ(big,IntegerConstantType("2147483648"));
+  ASS((big-c1).fitsInner());
+  ASS_EQ(big-c1,cMAX);
+
+  ASS_EQ((-cMIN).toString(),"2147483648");
+  ASS_EQ(cMIN/IntegerConstantType(-1),big);
+  ASS_EQ(cMIN%IntegerConstantType(-1),IntegerConstantType(0));
+
+  IntegerConstantType sq = big*big;
+  ASS_EQ(sq.toString(),"4611686018427387904");
+  ASS_EQ((sq*sq).toString(),"21267647932558653966460912964485513216");
+  ASS_EQ((sq*sq)/sq,sq);
+  ASS_EQ(sq/big,big);
+  ASS_EQ(sq/(big+c1),IntegerConstantType("2147483647"));
+  ASS_EQ(sq%(big+c1),IntegerConstantType(1));
+  ASS_EQ((-sq)%(big+c1),IntegerConstantType(-1));
+  ASS_EQ(sq.log2Abs(),62u);
+}
+
+TEST_FUN(bigComparison)
+{
+  IntegerConstantType a("-123456789012345678901234567890");
+  IntegerConstantType b("123456789012345678901234567890");
+  IntegerConstantType c("123456789012345678901234567891");
+
+  ASS(a.isNegative());
+  ASS(a<b);
+  ASS(b<c);
+  ASS(a<IntegerConstantType(0));
+  ASS_EQ(a+b,IntegerConstantType(0));
+  ASS((a+b).fitsInner());
+  ASS_EQ(c-b,IntegerConstantType(1));
+  ASS_EQ(-a,b);
+
+  ASS_EQ(IntegerConstantType::comparePrecedence(a,b),GREATER);
+  ASS_EQ(IntegerConstantType::comparePrecedence(c,a),GREATER);
+  ASS_EQ(IntegerConstantType::comparePrecedence(IntegerConstantType(INT_MAX),b),LESS);
+}
+
+TEST_FUN(quotients)
+{
+  IntegerConstantType big("100000000000000000000");
+  IntegerConstantType three(3);
+
+  ASS_EQ(big.quotientT(three).toString(),"33333333333333333333");
+  ASS_EQ((-big).quotientT(three).toString(),"-33333333333333333333");
+  ASS_EQ((-big).quotientF(three).toString(),"-33333333333333333334");
+  ASS_EQ((-big).quotientE(three).toString(),"-33333333333333333334");
+  ASS_EQ((-big).quotientE(-three).toString(),"33333333333333333334");
+
+  ASS_EQ(IntegerConstantType(-7).quotientE(IntegerConstantType(2)),IntegerConstantType(-4));
+  ASS_EQ(IntegerConstantType(-7).quotientE(IntegerConstantType(-2)),IntegerConstantType(4));
+  ASS_EQ(IntegerConstantType(-7).quotientF(IntegerConstantType(2)),IntegerConstantType(-4));
+  ASS_EQ(IntegerConstantType(-7).quotientT(IntegerConstantType(2)),IntegerConstantType(-3));
+  ASS_EQ(IntegerConstantType(7).quotientF(IntegerConstantType(-2)),IntegerConstantType(-4));
+
+  ASS(three.divides(big*three));
+  ASS(!three.divides(big));
+  ASS(IntegerConstantType(-4).divides(IntegerConstantType(8)));
+}
+
+TEST_FUN(bigRationals)
+{
+  IntegerConstantType big("100000000000000000000");
+  RationalConstantType r(big*IntegerConstantType(6), big*IntegerConstantType(-4));
+
+  ASS_EQ(r.toString(),"-3/2");
+  ASS_EQ(RationalConstantType(big,IntegerConstantType(1)).toString(),"100000000000000000000/1");
+}
+
+TEST_FUN(realExponentNotation)
+{
+  ASS_EQ(RealConstantType("1.1E-5").toString(),"11/1000000");
+  ASS_EQ(RealConstantType("1.1E-5"),RealConstantType("0.000011"));
+  ASS_EQ(RealConstantType("-2.5e+3").toString(),"-2500/1");
+  ASS_EQ(RealConstantType("3e2"),RealConstantType("300.0"));
+
+  bool thrown = false;
+  try {
+    RealConstantType("1.0E100000");
+  } catch(ArithmeticException) {
+    thrown = true;
+  }
+  ASS(thrown);
+}
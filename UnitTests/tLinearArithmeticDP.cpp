@@ -0,0 +1,137 @@
+
+/*
+ * File tLinearArithmeticDP.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+
+#include "Lib/Environment.hpp"
+
+#include "Kernel/Signature.hpp"
+#include "Kernel/Sorts.hpp"
+#include "Kernel/Term.hpp"
+#include "Kernel/Theory.hpp"
+
+#include "DP/LinearArithmeticDP.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID linearArithmeticDP
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace DP;
+
+static TermList intConst(const char* name)
+{
+  unsigned fn = env.signature->addFunction(name,0);
+  env.signature->getFunction(fn)->setType(OperatorType::getConstantsType(Sorts::SRT_INTEGER));
+  return TermList(Term::createConstant(fn));
+}
+
+static TermList num(int n)
+{
+  return TermList(theory->representConstant(IntegerConstantType(n)));
+}
+
+static TermList intPlus(TermList t1, TermList t2)
+{
+  return TermList(Term::create2(env.signature->getInterpretingSymbol(Theory::INT_PLUS), t1, t2));
+}
+
+static TermList intTimes(int n, TermList t)
+{
+  return TermList(Term::create2(env.signature->getInterpretingSymbol(Theory::INT_MULTIPLY), num(n), t));
+}
+
+static Literal* intLess(bool polarity, TermList t1, TermList t2)
+{
+  return Literal::create2(env.signature->getInterpretingSymbol(Theory::INT_LESS), polarity, t1, t2);
+}
+
+static void add(LinearArithmeticDP& dp, Literal* lit)
+{
+  dp.pushLevel();
+  dp.addLiterals(pvi( getSingletonIterator(lit) ), false);
+}
+
+TEST_FUN(linArithBounds)
+{
+  LinearArithmeticDP dp;
+  TermList a = intConst("lad_a");
+
+  Literal* l1 = intLess(true, a, num(3));
+  Literal* l2 = intLess(false, a, num(3));
+  add(dp, l1);
+  ASS_NEQ(dp.getStatus(false), DecisionProcedure::UNSATISFIABLE);
+  add(dp, l2);
+  ASS_EQ(dp.getStatus(false), DecisionProcedure::UNSATISFIABLE);
+  ASS_EQ(dp.getUnsatCoreCount(), 1u);
+
+  LiteralStack core;
+  dp.getUnsatCore(core, 0);
+  ASS_EQ(core.size(), 2u);
+
+  dp.popLevels(1);
+  ASS_NEQ(dp.getStatus(false), DecisionProcedure::UNSATISFIABLE);
+}
+
+TEST_FUN(linArithSimplex)
+{
+  LinearArithmeticDP dp;
+  TermList a = intConst("lad_b");
+  TermList b = intConst("lad_c");
+  TermList c = intConst("lad_d");
+
+  // a+b<2, 1<a, 0<b, and an unrelated bound on c
+  Literal* l1 = intLess(true, intPlus(a, b), num(2));
+  Literal* l2 = intLess(true, num(1), a);
+  Literal* l3 = intLess(true, c, num(7));
+  Literal* l4 = intLess(true, num(0), b);
+  add(dp, l1);
+  add(dp, l2);
+  add(dp, l3);
+  ASS_NEQ(dp.getStatus(false), DecisionProcedure::UNSATISFIABLE);
+  add(dp, l4);
+  ASS_EQ(dp.getStatus(false), DecisionProcedure::UNSATISFIABLE);
+
+  LiteralStack core;
+  dp.getUnsatCore(core, 0);
+  ASS_EQ(core.size(), 3u);
+  ASS(!core.find(l3));
+
+  // 2*(a+b) = 2*a+2*b shares the slack variable of a+b, and 2*a+2*b=3 has no integer solution
+  dp.popLevels(4);
+  add(dp, Literal::createEquality(true, intPlus(intTimes(2, a), intTimes(2, b)), num(3), Sorts::SRT_INTEGER));
+  ASS_EQ(dp.getStatus(false), DecisionProcedure::UNSATISFIABLE);
+}
+
+TEST_FUN(linArithDisequality)
+{
+  LinearArithmeticDP dp;
+  TermList a = intConst("lad_e");
+
+  add(dp, intLess(false, a, num(5)));
+  add(dp, Literal::createEquality(false, a, num(5), Sorts::SRT_INTEGER));
+  ASS_EQ(dp.getStatus(false), DecisionProcedure::UNKNOWN);
+  add(dp, intLess(true, a, num(6)));
+  ASS_EQ(dp.getStatus(false), DecisionProcedure::UNSATISFIABLE);
+
+  LiteralStack core;
+  dp.getUnsatCore(core, 0);
+  ASS_EQ(core.size(), 3u);
+}
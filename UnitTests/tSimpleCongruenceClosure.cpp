@@ -0,0 +1,133 @@
+
+/*
+ * File tSimpleCongruenceClosure.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+
+#include "Lib/Environment.hpp"
+
+#include "Kernel/Signature.hpp"
+#include "Kernel/Sorts.hpp"
+#include "Kernel/Term.hpp"
+
+#include "DP/SimpleCongruenceClosure.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID simpleCongruenceClosure
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace DP;
+
+static TermList constant(const char* name)
+{
+  return TermList(Term::createConstant(env.signature->addFunction(name,0)));
+}
+
+static TermList apply(const char* name, TermList arg)
+{
+  return TermList(Term::create1(env.signature->addFunction(name,1), arg));
+}
+
+static Literal* eq(bool polarity, TermList t1, TermList t2)
+{
+  return Literal::createEquality(polarity, t1, t2, Sorts::SRT_DEFAULT);
+}
+
+static void add(DecisionProcedure& dp, Literal* lit)
+{
+  dp.addLiterals(pvi( getSingletonIterator(lit) ), false);
+}
+
+/**
+ * Return the status of a fresh closure given the literals @b lits.
+ */
+static DecisionProcedure::Status freshStatus(const LiteralStack& lits)
+{
+  SimpleCongruenceClosure fresh(0);
+  fresh.addLiterals(pvi( LiteralStack::ConstIterator(lits) ), false);
+  return fresh.getStatus(false);
+}
+
+/**
+ * Check that @b dp, which has been given the literals @b lits, has the
+ * status of a fresh closure given them, and that its core is unsatisfiable
+ * on its own.
+ */
+static void checkAgainstFresh(SimpleCongruenceClosure& dp, const LiteralStack& lits)
+{
+  DecisionProcedure::Status status = dp.getStatus(false);
+  ASS_EQ(status, freshStatus(lits));
+  if (status != DecisionProcedure::UNSATISFIABLE) {
+    return;
+  }
+  LiteralStack core;
+  dp.getUnsatCore(core, 0);
+  LiteralStack::Iterator cit(core);
+  while (cit.hasNext()) {
+    ASS(lits.find(cit.next()));
+  }
+  ASS_EQ(freshStatus(core), DecisionProcedure::UNSATISFIABLE);
+}
+
+TEST_FUN(sccPushPopMatchesFresh)
+{
+  SimpleCongruenceClosure dp(0);
+  TermList a = constant("scc_a");
+  TermList b = constant("scc_b");
+  TermList c = constant("scc_c");
+  TermList d = constant("scc_d");
+
+  LiteralStack lits;
+  lits.push(eq(true, a, b));
+  add(dp, lits.top());
+  checkAgainstFresh(dp, lits);
+
+  // a level whose equalities make the closure unsatisfiable
+  dp.pushLevel();
+  lits.push(eq(true, b, c));
+  add(dp, lits.top());
+  lits.push(eq(false, apply("scc_f", a), apply("scc_f", c)));
+  add(dp, lits.top());
+  checkAgainstFresh(dp, lits);
+  ASS_EQ(dp.getStatus(false), DecisionProcedure::UNSATISFIABLE);
+
+  dp.popLevels(1);
+  lits.truncate(1);
+  checkAgainstFresh(dp, lits);
+  ASS_NEQ(dp.getStatus(false), DecisionProcedure::UNSATISFIABLE);
+
+  // different equalities over the same terms after the pop
+  dp.pushLevel();
+  lits.push(eq(false, apply("scc_f", a), apply("scc_f", d)));
+  add(dp, lits.top());
+  lits.push(eq(true, c, d));
+  add(dp, lits.top());
+  checkAgainstFresh(dp, lits);
+
+  dp.pushLevel();
+  lits.push(eq(true, b, c));
+  add(dp, lits.top());
+  checkAgainstFresh(dp, lits);
+  ASS_EQ(dp.getStatus(false), DecisionProcedure::UNSATISFIABLE);
+
+  dp.popLevels(2);
+  lits.truncate(1);
+  checkAgainstFresh(dp, lits);
+}
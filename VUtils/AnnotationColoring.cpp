@@ -93,10 +93,10 @@ int AnnotationColoring::perform(int argc, char** argv)
 
     bool isAxiom;
     if(conjectureColoring) {
-      isAxiom = u->inputType()!=Unit::CONJECTURE;
+      isAxiom = u->inputType()!=UnitInputType::CONJECTURE;
     }
     else {
-      isAxiom = u->inputType()==Unit::AXIOM;
+      isAxiom = u->inputType()==UnitInputType::AXIOM;
     }
 
     SymIdSet& localSet = isAxiom ? axiomSymbols : conjectureSymbols;
@@ -30,6 +30,7 @@
 #include "Lib/Stack.hpp"
 
 #include "Kernel/Clause.hpp"
+#include "Kernel/Ordering.hpp"
 #include "Kernel/Problem.hpp"
 
 #include "Shell/Options.hpp"
@@ -69,7 +70,8 @@ int DPTester::perform(int argc, char** argv)
     cout << (*lit) << endl;
   }
 
-  ScopedPtr<DecisionProcedure> dp(new SimpleCongruenceClosure());
+  ScopedPtr<Ordering> ord(Ordering::create(*prb, *env.options));
+  ScopedPtr<DecisionProcedure> dp(new SimpleCongruenceClosure(ord.ptr()));
 
   dp->addLiterals(pvi(LiteralStack::Iterator(lits)));
 
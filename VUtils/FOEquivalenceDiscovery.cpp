@@ -58,7 +58,7 @@ int FOEquivalenceDiscovery::perform(int argc, char** argv)
   vstring fname = argv[2];
 
   Options opts;
-  opts.setTheoryAxioms(false);
+  opts.set("theory_axioms","off");
   opts.setInputFile(fname);
 
   ScopedPtr<Problem> prb(UIHelper::getInputProblem(opts));
@@ -81,7 +81,7 @@ int FOEquivalenceDiscovery::perform(int argc, char** argv)
   unsigned sz = preds.size();
   for(unsigned i=0; i<sz; i++) {
     Signature::Symbol* sym1 = env.signature->getPredicate(preds[i]);
-    PredicateType* t1 = sym1->predType();
+    OperatorType* t1 = sym1->predType();
     unsigned ar1 = sym1->arity();
     vstring n1 = sym1->name();
     vstring args = getArgStr(ar1);
@@ -90,8 +90,8 @@ int FOEquivalenceDiscovery::perform(int argc, char** argv)
 
     for(unsigned j=i+1; j<sz; j++) {
       Signature::Symbol* sym2 = env.signature->getPredicate(preds[j]);
-      PredicateType* t2 = sym2->predType();
-      if(*t1!=*t2) {
+      OperatorType* t2 = sym2->predType();
+      if(t1!=t2) {
 	continue;
       }
 
@@ -21,13 +21,22 @@
  * Implements class SATReplayer.
  */
 
+#include <chrono>
 #include <fstream>
 
+#include "Lib/DHMap.hpp"
 #include "Lib/Environment.hpp"
+#include "Lib/Int.hpp"
+#include "Lib/Sort.hpp"
+#include "Lib/Stack.hpp"
 
+#include "SAT/MinisatInterfacing.hpp"
+#include "SAT/MinisatInterfacingNewSimp.hpp"
+#include "SAT/SATClause.hpp"
+#include "SAT/TraceRecordingSolver.hpp"
 #include "SAT/TWLSolver.hpp"
 
-#include "Test/RecordingSatSolver.hpp"
+#include "Shell/Options.hpp"
 
 #include "SATReplayer.hpp"
 
@@ -37,25 +46,279 @@ namespace VUtils
 using namespace Lib;
 using namespace SAT;
 
+namespace {
+
+enum BackendKind {
+  BK_TWL,
+  BK_MINISAT,
+  BK_MINISAT_SIMP,
+  BK_CNT
+};
+
+const char* backendName(unsigned kind)
+{
+  switch(kind) {
+  case BK_TWL: return "vampire";
+  case BK_MINISAT: return "minisat";
+  case BK_MINISAT_SIMP: return "minisat_simp";
+  default:
+    ASSERTION_VIOLATION;
+    return 0;
+  }
+}
+
+SATSolverWithAssumptions* createBackend(unsigned kind)
+{
+  switch(kind) {
+  case BK_TWL: return new TWLSolver(*env.options, true);
+  case BK_MINISAT: return new MinisatInterfacing(*env.options, true);
+  case BK_MINISAT_SIMP: return new MinisatInterfacingNewSimp(*env.options, true, true);
+  default:
+    ASSERTION_VIOLATION;
+    return 0;
+  }
+}
+
+const char* statusName(SATSolver::Status st)
+{
+  switch(st) {
+  case SATSolver::SATISFIABLE: return "sat";
+  case SATSolver::UNSATISFIABLE: return "unsat";
+  default: return "unknown";
+  }
+}
+
+struct Backend {
+  DHMap<unsigned,SATSolverWithAssumptions*> solvers;
+  /** status of the last solve call of each solver */
+  DHMap<unsigned,SATSolver::Status> lastStatus;
+  /** latencies of the solve calls in microseconds */
+  Stack<unsigned> latencies;
+  unsigned mismatches;
+
+  Backend() : mismatches(0) {}
+};
+
+bool readLiterals(istream& in, SATLiteralStack& res)
+{
+  res.reset();
+  unsigned len;
+  if(!SATTrace::readNumber(in, len)) {
+    return false;
+  }
+  for(unsigned i=0; i<len; i++) {
+    unsigned code;
+    if(!SATTrace::readNumber(in, code)) {
+      return false;
+    }
+    res.push(SATTrace::decode(code));
+  }
+  return true;
+}
+
+bool readFlag(istream& in, unsigned& res)
+{
+  int c = in.get();
+  if(c==EOF) {
+    return false;
+  }
+  res = c;
+  return true;
+}
+
+bool readStatus(istream& in, SATSolver::Status& res)
+{
+  int c = in.get();
+  if(c==EOF) {
+    return false;
+  }
+  res = static_cast<SATSolver::Status>(c);
+  return true;
+}
+
+unsigned percentile(const Stack<unsigned>& sorted, unsigned pct)
+{
+  if(sorted.isEmpty()) {
+    return 0;
+  }
+  return sorted[(sorted.size()-1)*pct/100];
+}
+
+}
+
+/**
+ * Replay a trace written with the record_sat_trace option against all
+ * the SAT backends, print the latency percentiles of the solve calls
+ * of each backend and report the calls whose answer differs from the
+ * recorded one.
+ */
 int SATReplayer::perform(int argc, char** argv)
 {
   CALL("SATReplayer::perform");
 
-  if(argc!=4) {
+  if(argc!=3) {
     cerr << "invalid command line"<<endl<<
 	    "Usage:"<<endl<<
-	    argv[0]<<" "<<argv[1]<<" <prefix> <file name>"<<endl;
+	    argv[0]<<" "<<argv[1]<<" <trace file>"<<endl;
     exit(1);
   }
 
-  vstring prefix = vstring(argv[2])+" ";
-  ifstream inp(argv[3]);
+  ifstream inp(argv[2], ios::binary);
+  vstring magic = SATTrace::magic();
+  char hdr[8];
+  if(!inp.read(hdr, magic.size()) || vstring(hdr, magic.size())!=magic) {
+    USER_ERROR("Not a SAT trace: "+vstring(argv[2]));
+  }
+
+  Backend backends[BK_CNT];
+  unsigned solveCalls = 0;
+  bool truncated = false;
+  SATLiteralStack lits;
+
+  int opByte;
+  while((opByte = inp.get())!=EOF) {
+    SATTrace::Operation op = static_cast<SATTrace::Operation>(opByte);
+    unsigned id;
+    if(!SATTrace::readNumber(inp, id)) {
+      truncated = true;
+      break;
+    }
+
+    // read the operands first, a record cut short by the end of the trace is skipped
+    unsigned num1 = 0, num2 = 0, num3 = 0;
+    SATSolver::Status recorded = SATSolver::UNKNOWN;
+    bool ok = true;
+    switch(op) {
+    case SATTrace::OP_NEW_SOLVER:
+    case SATTrace::OP_SIMPLIFY:
+    case SATTrace::OP_RETRACT_ASSUMPTIONS:
+      break;
+    case SATTrace::OP_ENSURE_VAR_COUNT:
+    case SATTrace::OP_NEW_VAR:
+    case SATTrace::OP_ADD_ASSUMPTION:
+    case SATTrace::OP_RANDOMIZE:
+      ok = SATTrace::readNumber(inp, num1);
+      break;
+    case SATTrace::OP_SUGGEST_POLARITY:
+      ok = SATTrace::readNumber(inp, num1) && SATTrace::readNumber(inp, num2);
+      break;
+    case SATTrace::OP_ADD_CLAUSE:
+    case SATTrace::OP_ADD_CLAUSE_IGNORED:
+      ok = readLiterals(inp, lits);
+      break;
+    case SATTrace::OP_SOLVE:
+      ok = SATTrace::readNumber(inp, num1) && readStatus(inp, recorded);
+      break;
+    case SATTrace::OP_SOLVE_UNDER_ASSUMPTIONS:
+      ok = SATTrace::readNumber(inp, num1) && readFlag(inp, num2) && readLiterals(inp, lits) && readStatus(inp, recorded);
+      break;
+    case SATTrace::OP_MINIMIZE_FAILED_ASSUMPTIONS:
+      // the number of failed assumptions left by the recorded solver is not compared
+      ok = SATTrace::readNumber(inp, num1) && readFlag(inp, num2) && SATTrace::readNumber(inp, num3);
+      break;
+    default:
+      USER_ERROR("Corrupted SAT trace, unknown operation "+Int::toString(opByte));
+    }
+    if(!ok) {
+      truncated = true;
+      break;
+    }
+    if(op==SATTrace::OP_SOLVE || op==SATTrace::OP_SOLVE_UNDER_ASSUMPTIONS) {
+      solveCalls++;
+    }
+
+    for(unsigned k=0; k<BK_CNT; k++) {
+      Backend& b = backends[k];
+      if(op==SATTrace::OP_NEW_SOLVER) {
+        b.solvers.insert(id, createBackend(k));
+        continue;
+      }
+      SATSolverWithAssumptions* solver = b.solvers.get(id);
 
-  TWLSolver solver(*env.options, true);
-  Test::SolverReplayer replayer(solver);
-  replayer.runFromStream(inp, prefix);
+      switch(op) {
+      case SATTrace::OP_ENSURE_VAR_COUNT:
+        solver->ensureVarCount(num1);
+        break;
+      case SATTrace::OP_NEW_VAR:
+        if(solver->newVar()!=num1) {
+          b.mismatches++;
+        }
+        break;
+      case SATTrace::OP_ADD_CLAUSE:
+        solver->addClause(SATClause::fromStack(lits));
+        break;
+      case SATTrace::OP_ADD_CLAUSE_IGNORED:
+        solver->addClauseIgnoredInPartialModel(SATClause::fromStack(lits));
+        break;
+      case SATTrace::OP_SIMPLIFY:
+        solver->simplify();
+        break;
+      case SATTrace::OP_ADD_ASSUMPTION:
+        solver->addAssumption(SATTrace::decode(num1));
+        break;
+      case SATTrace::OP_RETRACT_ASSUMPTIONS:
+        solver->retractAllAssumptions();
+        break;
+      case SATTrace::OP_SUGGEST_POLARITY:
+        solver->suggestPolarity(num1, num2);
+        break;
+      case SATTrace::OP_RANDOMIZE:
+        solver->randomizeForNextAssignment(num1);
+        break;
+      case SATTrace::OP_MINIMIZE_FAILED_ASSUMPTIONS:
+        // only meaningful right after this backend refuted the assumptions as well
+        if(b.lastStatus.get(id, SATSolver::UNKNOWN)==SATSolver::UNSATISFIABLE) {
+          solver->explicitlyMinimizedFailedAssumptions(num1, num2);
+        }
+        break;
+      case SATTrace::OP_SOLVE:
+      case SATTrace::OP_SOLVE_UNDER_ASSUMPTIONS: {
+        auto start = std::chrono::steady_clock::now();
+        SATSolver::Status res = (op==SATTrace::OP_SOLVE) ? solver->solve(num1) :
+            solver->solveUnderAssumptions(lits, num1, num2);
+        auto end = std::chrono::steady_clock::now();
+        b.latencies.push(std::chrono::duration_cast<std::chrono::microseconds>(end-start).count());
+        b.lastStatus.set(id, res);
+
+        // a solver may give up earlier or later than the recorded one when the conflicts are limited
+        if(res!=recorded && res!=SATSolver::UNKNOWN && recorded!=SATSolver::UNKNOWN) {
+          b.mismatches++;
+          env.beginOutput();
+          env.out() << backendName(k) << ": solver " << id << " answered " << statusName(res)
+                    << " on solve call " << solveCalls << ", the trace says " << statusName(recorded) << endl;
+          env.endOutput();
+        }
+        break;
+      }
+      default:
+        ASSERTION_VIOLATION;
+      }
+    }
+  }
+
+  env.beginOutput();
+  if(truncated) {
+    env.out() << "% trace ends with an incomplete record, which was skipped" << endl;
+  }
+  env.out() << "% " << solveCalls << " solve calls replayed" << endl;
+  env.out() << "% backend\tp50(us)\tp90(us)\tp99(us)\tmax(us)\ttotal(ms)\tmismatches" << endl;
+  bool allAgree = true;
+  for(unsigned k=0; k<BK_CNT; k++) {
+    Backend& b = backends[k];
+    sort<DefaultComparator>(b.latencies.begin(), b.latencies.end());
+    unsigned long long total = 0;
+    for(unsigned i=0; i<b.latencies.size(); i++) {
+      total += b.latencies[i];
+    }
+    env.out() << "% " << backendName(k)
+              << '\t' << percentile(b.latencies, 50) << '\t' << percentile(b.latencies, 90)
+              << '\t' << percentile(b.latencies, 99) << '\t' << percentile(b.latencies, 100)
+              << '\t' << total/1000 << '\t' << b.mismatches << endl;
+    allAgree &= !b.mismatches;
+  }
+  env.endOutput();
 
-  return 0;
+  return allAgree ? 0 : 1;
 }
 
 }
@@ -0,0 +1,8 @@
+%the goal names the Skolem constant of the axiom, which must not be
+%mixed up with the one introduced when the axioms are cached
+
+% params: --problem_cache /tmp/vampire_regression_pp_cache_1.cache -t 10
+% grep: SZS status CounterSatisfiable
+
+fof(a1,axiom,?[X]: q(X)).
+fof(g,conjecture,q(sK0)).
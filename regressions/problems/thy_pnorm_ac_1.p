@@ -0,0 +1,11 @@
+% params: -pnorm on -t 10
+% res: unsat
+
+tff(c_type,type, c: $int).
+tff(d_type,type, d: $int).
+tff(e_type,type, e: $int).
+tff(p_type,type, p: $int > $o).
+tff(q_type,type, q: $int > $o).
+tff(a1,axiom, p($sum($sum(c,d),$product(2,c)))).
+tff(a2,axiom, q($sum($sum($product(c,d),$sum(e,d)),$product($product(2,c),d)))).
+tff(g,conjecture, p($sum($product(3,c),d)) & q($sum($product(3,$product(d,c)),$sum(d,e)))).
@@ -36,6 +36,7 @@
 #include "Lib/Int.hpp"
 #include "Lib/MapToLIFO.hpp"
 #include "Lib/Random.hpp"
+#include "Lib/SamplingProfiler.hpp"
 #include "Lib/Set.hpp"
 #include "Lib/Stack.hpp"
 #include "Lib/TimeCounter.hpp"
@@ -92,6 +93,7 @@
 #include "SAT/MinisatInterfacingNewSimp.hpp"
 #include "SAT/TWLSolver.hpp"
 #include "SAT/Preprocess.hpp"
+#include "SAT/TraceRecordingSolver.hpp"
 
 #include "FMB/ModelCheck.hpp"
 
@@ -160,7 +162,13 @@ Problem* getPreprocessedProblem()
 {
   CALL("getPreprocessedProblem");
 
-  Problem* prb = UIHelper::getInputProblem(*env.options);
+  Problem* prb = 0;
+  if (env.options->problemCache() != "") {
+    prb = UIHelper::getCachedInputProblem(*env.options);
+  }
+  if (!prb) {
+    prb = UIHelper::getInputProblem(*env.options);
+  }
 
   TimeCounter tc2(TC_PREPROCESSING);
 
@@ -558,6 +566,7 @@ void satSolverMode()
       solver = new TWLSolver(*env.options);
       break;
     case Options::SatSolver::MINISAT:
+    case Options::SatSolver::MINISAT_SIMP:
       solver = new MinisatInterfacingNewSimp(*env.options);
       break;      
     default:
@@ -871,6 +880,12 @@ int main(int argc, char* argv[])
 
     Allocator::setMemoryLimit(env.options->memoryLimit() * 1048576ul);
     Lib::Random::setSeed(env.options->randomSeed());
+    if (env.options->samplingProfile()!="off") {
+      SamplingProfiler::start(env.options->samplingProfile());
+    }
+    if (env.options->recordSatTrace()!="off") {
+      TraceRecordingSolver::start(env.options->recordSatTrace());
+    }
 
     switch (env.options->mode())
     {
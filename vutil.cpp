@@ -38,23 +38,17 @@
 #include "Shell/CommandLine.hpp"
 #include "Shell/Options.hpp"
 #include "Shell/Statistics.hpp"
-#include "CASC/CASCMode.hpp"
+#include "Shell/UIHelper.hpp"
 
 #include "VUtils/AnnotationColoring.hpp"
-#include "VUtils/CPAInterpolator.hpp"
 #include "VUtils/DPTester.hpp"
-#include "VUtils/EPRRestoringScanner.hpp"
 #include "VUtils/FOEquivalenceDiscovery.hpp"
-#include "VUtils/PreprocessingEvaluator.hpp"
 #include "VUtils/ProblemColoring.hpp"
 #include "VUtils/SATReplayer.hpp"
-#include "VUtils/SimpleSMT.hpp"
 #include "VUtils/SMTLIBConcat.hpp"
-#include "VUtils/Z3InterpolantExtractor.hpp"
 
 using namespace Lib;
 using namespace Shell;
-using namespace CASC;
 using namespace VUtils;
 
 
@@ -81,7 +75,7 @@ void readAndFilterGlobalOpts(Stack<char*>& args) {
       }
       vstring traceStr(it.next());
       it.del();
-      PROCESS_TRACE_SPEC_STRING(traceStr);
+      //PROCESS_TRACE_SPEC_STRING(traceStr);
     }
     else if(arg=="-m") {
       it.del();
@@ -121,7 +115,6 @@ int main(int argc, char* argv [])
   args.loadFromIterator(getArrayishObjectIterator(argv, argc));
 
   try {
-    env.options->setMode(Options::MODE_VAMPIRE);
     env.options->setTimeLimitInDeciseconds(0);
 
     Allocator::setMemoryLimit(1024u*1048576ul);
@@ -138,44 +131,18 @@ int main(int argc, char* argv [])
     else if(module=="conjecture_coloring" || module=="axiom_coloring") {
       resultValue=AnnotationColoring().perform(args.size(), args.begin());
     }
-    else if(module=="zie") {
-      resultValue=ZIE().perform(args.size(), args.begin());
-    }
-    else if(module=="epr_restoring_scanner") {
-      resultValue=EPRRestoringScanner().perform(args.size(), args.begin());
-    }
     else if(module=="fed") {
       resultValue=FOEquivalenceDiscovery().perform(args.size(), args.begin());
     }
     else if(module=="sc") {
       resultValue=SMTLIBConcat().perform(args.size(), args.begin());
     }
-    else if(module=="cpa") {
-      resultValue=CPAInterpolator().perform(args.size(), args.begin());
-    }
-    else if(module=="pe") {
-      resultValue=PreprocessingEvaluator().perform(args.size(), args.begin());
-    }
-    else if(module=="smt") {
-      resultValue=SimpleSMT().perform(args.size(), args.begin());
-      
-    }
     else if(module=="dpt") {
       resultValue=DPTester().perform(args.size(), args.begin());
     }
     else if(module=="sr") {
       resultValue=SATReplayer().perform(args.size(), args.begin());
     }
-    else if(module=="vamp_casc") {
-      Shell::CommandLine cl(args.size()-1, args.begin()+1);
-      cl.interpret(*env.options);
-      Allocator::setMemoryLimit(env.options->memoryLimit()*1048576ul);
-      Lib::Random::setSeed(env.options->randomSeed());
-      if(CASC::CASCMode::perform(args.size()-1, args.begin()+1)) {
-	//casc mode succeeded in solving the problem, so we return zero
-	resultValue = VAMP_RESULT_STATUS_SUCCESS;
-      }
-    }
     else {
       USER_ERROR("unknown vutil module name: "+module);
     }